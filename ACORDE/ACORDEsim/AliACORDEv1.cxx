@@ -68,13 +68,15 @@
 #include "AliACORDEhit.h"
 #include "AliACORDEConstants.h"
 #include "AliMC.h"
+#include "AliStepState.h"
 #include "AliLog.h"
 
 ClassImp(AliACORDEv1)
  
 //_____________________________________________________________________________
 AliACORDEv1::AliACORDEv1()
-  : AliACORDE()
+  : AliACORDE(),
+    fUseStepState(kTRUE)
 {
   //
   // Default constructor
@@ -84,7 +86,8 @@ AliACORDEv1::AliACORDEv1()
 } 
 //_____________________________________________________________________________
 AliACORDEv1::AliACORDEv1(const char *name, const char *title)
-  : AliACORDE(name, title)
+  : AliACORDE(name, title),
+    fUseStepState(kTRUE)
 {
   //
   // Standard constructor
@@ -796,6 +799,57 @@ void AliACORDEv1::StepManager()
 
 }
 
+//____________________________________________________________________________
+void AliACORDEv1::StepManagerWithState(const AliStepState &state)
+{
+  //
+  // Same hits as StepManager, with the step quantities taken from the
+  // state filled by AliMC::Stepping instead of querying the VMC
+  //
+
+  // volume and hit layout as in StepManager
+  static Int_t   vol[2];
+  static Float_t hits[11];
+  static Float_t eloss;
+  static Float_t step;
+  static Int_t idScint = fMC->VolId("ACORDESCINTILLATORMODULE");
+
+  // only charged tracks
+  if ( !state.GetCharge() || !state.IsTrackAlive() ) return;
+
+  // only in sensitive material
+  if (state.GetVolId() != idScint) return;
+
+  step  += state.GetStep();
+  eloss += state.GetEdep();
+  if (state.IsTrackEntering()) {
+    eloss = 0.0;
+    step = 0.0;
+    hits[0] = (Float_t) state.GetPdg();
+    hits[1] = state.X();
+    hits[2] = state.Y();
+    hits[3] = state.Z();
+    hits[4] = state.T();
+    hits[5] = state.Px();
+    hits[6] = state.Py();
+    hits[7] = state.Pz();
+    hits[8] = state.Etot();
+    // module from the mother volume, plastic: 0 = down, 1 = up
+    Int_t copyModule;
+    fMC->CurrentVolOffID(1, copyModule);
+    vol[0] = copyModule;
+    vol[1] = state.GetCopy() - 4;
+  }
+
+  if (state.IsTrackExiting() || state.IsTrackStop() || state.IsTrackDisappeared()) {
+    hits[9] = eloss;
+    hits[10] = step;
+    eloss = 0.0;
+    step = 0.0;
+    AddHit(state.GetTrack(), vol, hits);
+  }
+}
+
 //_____________________________________________________________________________
 void AliACORDEv1::AddHit(Int_t track, Int_t *vol, Float_t *hits)
 {
@@ -30,6 +30,9 @@ public:
 
   virtual void Init();
   virtual void StepManager();
+  virtual void StepManagerWithState(const AliStepState &state);
+  virtual Bool_t UsesStepState() const { return fUseStepState; }
+  void SetUseStepState(Bool_t use = kTRUE) { fUseStepState = use; }
 
 
 protected:
@@ -40,6 +43,8 @@ private:
   AliACORDEv1(const AliACORDEv1& crt);
   AliACORDEv1& operator=(const AliACORDEv1& crt);
 
+  Bool_t fUseStepState; //! hits from the AliStepState filled by AliMC
+
   ClassDef(AliACORDEv1,2) // Cosmic Ray Trigger (ACORDE).
 };
 
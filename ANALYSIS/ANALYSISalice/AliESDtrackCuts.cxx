@@ -30,6 +30,8 @@
 #include <TF1.h>
 #include <TBits.h>
 
+#include <vector>
+
 //____________________________________________________________________
 ClassImp(AliESDtrackCuts)
 
@@ -1237,8 +1239,8 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
   // figure out if the tracks survives all the track cuts defined
   //
   // the different quality parameter and kinematic values are first
-  // retrieved from the track. then it is found out what cuts the
-  // track did not survive and finally the cuts are imposed.
+  // retrieved from the track (FillTrackVars). then it is found out what
+  // cuts the track did not survive and finally the cuts are imposed.
 
   // this function needs the following branches:
   // fTracks.fFlags
@@ -1259,63 +1261,143 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
   //
   // esdEvent is only required for the MaxChi2TPCConstrainedVsGlobal
 
-  UInt_t status = esdTrack->GetStatus();
+  TrackVars vars;
+  FillTrackVars(esdTrack, vars);
+  return AcceptTrackVars(esdTrack, vars);
+}
 
-  // getting quality parameters from the ESD track
-  Int_t nClustersITS = esdTrack->GetITSclusters(0);
-  Int_t nClustersTPC = -1;
-  if(fCutRequireTPCStandAlone) {
-    nClustersTPC = esdTrack->GetTPCNclsIter1();
-  }
-  else {
-    nClustersTPC = esdTrack->GetTPCclusters(0);
-  }
+//____________________________________________________________________
+void AliESDtrackCuts::FillTrackVars(const AliESDtrack* esdTrack, TrackVars& vars)
+{
+  //
+  // retrieves all quantities needed by the track cuts which do not depend
+  // on the cut configuration. Both the TPC standalone (iteration 1) and the
+  // global TPC values are stored, the choice is made in AcceptTrackVars
+  //
 
-  //Pt dependent NClusters Cut
-  if(f1CutMinNClustersTPCPtDep) {
-    if(esdTrack->Pt()<fCutMaxPtDepNClustersTPC)
-      fCutMinNClusterTPC = (Int_t)(f1CutMinNClustersTPCPtDep->Eval(esdTrack->Pt()));
-    else
-      fCutMinNClusterTPC = (Int_t)(f1CutMinNClustersTPCPtDep->Eval(fCutMaxPtDepNClustersTPC));
-  }
+  vars.fStatus = esdTrack->GetStatus();
 
-  Float_t nCrossedRowsTPC = esdTrack->GetTPCCrossedRows();
-  Float_t  ratioCrossedRowsOverFindableClustersTPC = 1.0;
+  // getting quality parameters from the ESD track
+  vars.fNClustersITS = esdTrack->GetITSclusters(0);
+  vars.fNClustersTPC[0] = esdTrack->GetTPCclusters(0);
+  vars.fNClustersTPC[1] = esdTrack->GetTPCNclsIter1();
+  vars.fNClustersTPCShared = esdTrack->GetTPCnclsS();
+
+  vars.fNCrossedRowsTPC = esdTrack->GetTPCCrossedRows();
+  vars.fRatioCrossedRowsOverFindableClustersTPC = 1.0;
   if (esdTrack->GetTPCNclsF()>0) {
-    ratioCrossedRowsOverFindableClustersTPC = nCrossedRowsTPC / esdTrack->GetTPCNclsF();
+    vars.fRatioCrossedRowsOverFindableClustersTPC = vars.fNCrossedRowsTPC / esdTrack->GetTPCNclsF();
   }
 
-  Int_t nClustersTPCShared = esdTrack->GetTPCnclsS();
-  Float_t fracClustersTPCShared = -1.;
+  vars.fChi2PerClusterITS = -1;
+  if (vars.fNClustersITS!=0)
+    vars.fChi2PerClusterITS = esdTrack->GetITSchi2()/Float_t(vars.fNClustersITS);
 
-  Float_t chi2PerClusterITS = -1;
-  Float_t chi2PerClusterTPC = -1;
-  if (nClustersITS!=0)
-    chi2PerClusterITS = esdTrack->GetITSchi2()/Float_t(nClustersITS);
-  if (nClustersTPC!=0) {
-    if(fCutRequireTPCStandAlone) {
-      chi2PerClusterTPC = esdTrack->GetTPCchi2Iter1()/Float_t(nClustersTPC);
-    } else {
-      chi2PerClusterTPC = esdTrack->GetTPCchi2()/Float_t(nClustersTPC);
+  Double_t chi2TPC[2] = { esdTrack->GetTPCchi2(), esdTrack->GetTPCchi2Iter1() };
+  for (Int_t i=0; i<2; i++) {
+    vars.fChi2PerClusterTPC[i] = -1;
+    vars.fFracClustersTPCShared[i] = -1.;
+    if (vars.fNClustersTPC[i]!=0) {
+      vars.fChi2PerClusterTPC[i] = chi2TPC[i]/Float_t(vars.fNClustersTPC[i]);
+      vars.fFracClustersTPCShared[i] = Float_t(vars.fNClustersTPCShared)/Float_t(vars.fNClustersTPC[i]);
     }
-    fracClustersTPCShared = Float_t(nClustersTPCShared)/Float_t(nClustersTPC);
   }
 
   Double_t extCov[15];
   esdTrack->GetExternalCovariance(extCov);
+  vars.fCovDiag[0] = extCov[0];
+  vars.fCovDiag[1] = extCov[2];
+  vars.fCovDiag[2] = extCov[5];
+  vars.fCovDiag[3] = extCov[9];
+  vars.fCovDiag[4] = extCov[14];
+
+  esdTrack->GetImpactParameters(vars.fB,vars.fBCov);
+  if (vars.fBCov[0]<=0 || vars.fBCov[2]<=0) {
+    AliDebugClass(1, "Estimated b resolution lower or equal zero!");
+    vars.fBCov[0]=0; vars.fBCov[2]=0;
+  }
 
-  Float_t b[2];
-  Float_t bCov[3];
-  esdTrack->GetImpactParameters(b,bCov);
-  if (bCov[0]<=0 || bCov[2]<=0) {
-    AliDebug(1, "Estimated b resolution lower or equal zero!");
-    bCov[0]=0; bCov[2]=0;
+  // getting the kinematic variables of the track
+  // (assuming the mass is known)
+  esdTrack->GetPxPyPz(vars.fP);
+  const Double_t* p = vars.fP;
+
+  // Changed from float to double to prevent rounding errors leading to negative
+  // log arguments (M.G.)
+  vars.fMomentum    = TMath::Sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
+  vars.fPt          = TMath::Sqrt(p[0]*p[0] + p[1]*p[1]);
+  Double_t mass     = esdTrack->GetMass();
+  Double_t energy   = TMath::Sqrt(mass*mass + vars.fMomentum*vars.fMomentum);
+
+  //y-eta related calculations
+  vars.fEta = -100.;
+  vars.fY   = -100.;
+  if((vars.fMomentum != TMath::Abs(p[2]))&&(vars.fMomentum != 0))
+    vars.fEta = 0.5*TMath::Log((vars.fMomentum + p[2])/(vars.fMomentum - p[2]));
+  if((energy != TMath::Abs(p[2]))&&(energy != 0))
+    vars.fY = 0.5*TMath::Log((energy + p[2])/(energy - p[2]));
+
+  vars.fRelUncertainty1Pt = extCov[14] < 0 ? -1 : TMath::Sqrt(extCov[14])*vars.fPt;
+
+  vars.fKinkIndex = esdTrack->GetKinkIndex(0);
+
+  vars.fITSClusterMap = esdTrack->GetITSClusterMap();
+  vars.fNITSPointsForPid = 0;
+  for(Int_t i=2; i<6; i++){
+    if(vars.fITSClusterMap&(1<<i)) ++vars.fNITSPointsForPid;
+  }
+
+  vars.fNMissingITSPoints = 0;
+  Int_t idet,statusLay;
+  Float_t xloc,zloc;
+  for(Int_t iLay=0; iLay<6; iLay++){
+    Bool_t retc=esdTrack->GetITSModuleIndexInfo(iLay,idet,statusLay,xloc,zloc);
+    if(retc && statusLay==5) ++vars.fNMissingITSPoints;
   }
 
+  vars.fTOFsignalDx = 999.;
+  vars.fTOFsignalDz = 999.;
+  if ((vars.fStatus & AliESDtrack::kTOFout) == AliESDtrack::kTOFout) {
+    vars.fTOFsignalDx = esdTrack->GetTOFsignalDx();
+    vars.fTOFsignalDz = esdTrack->GetTOFsignalDz();
+  }
+}
 
-  // set pt-dependent DCA cuts, if requested
-  SetPtDepDCACuts(esdTrack->Pt());
+//____________________________________________________________________
+Bool_t AliESDtrackCuts::AcceptTrackVars(const AliESDtrack* esdTrack, const TrackVars& vars)
+{
+  //
+  // applies the cuts to the quantities retrieved by FillTrackVars.
+  // The CPU intensive cuts which need the track itself are evaluated
+  // only when all other cuts have passed
+  //
+
+  UInt_t status = vars.fStatus;
 
+  const Int_t iTPC = fCutRequireTPCStandAlone ? 1 : 0;
+  Int_t nClustersITS = vars.fNClustersITS;
+  Int_t nClustersTPC = vars.fNClustersTPC[iTPC];
+
+  //Pt dependent NClusters Cut
+  if(f1CutMinNClustersTPCPtDep) {
+    if(vars.fPt<fCutMaxPtDepNClustersTPC)
+      fCutMinNClusterTPC = (Int_t)(f1CutMinNClustersTPCPtDep->Eval(vars.fPt));
+    else
+      fCutMinNClusterTPC = (Int_t)(f1CutMinNClustersTPCPtDep->Eval(fCutMaxPtDepNClustersTPC));
+  }
+
+  Float_t nCrossedRowsTPC = vars.fNCrossedRowsTPC;
+  Float_t ratioCrossedRowsOverFindableClustersTPC = vars.fRatioCrossedRowsOverFindableClustersTPC;
+  Int_t nClustersTPCShared = vars.fNClustersTPCShared;
+  Float_t fracClustersTPCShared = vars.fFracClustersTPCShared[iTPC];
+  Float_t chi2PerClusterITS = vars.fChi2PerClusterITS;
+  Float_t chi2PerClusterTPC = vars.fChi2PerClusterTPC[iTPC];
+  const Double_t* cov = vars.fCovDiag;
+  const Float_t* b = vars.fB;
+  const Float_t* bCov = vars.fBCov;
+
+  // set pt-dependent DCA cuts, if requested
+  SetPtDepDCACuts(vars.fPt);
 
   Float_t dcaToVertexXY = b[0];
   Float_t dcaToVertexZ = b[1];
@@ -1329,32 +1411,18 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
   else
     dcaToVertex = TMath::Sqrt(dcaToVertexXY*dcaToVertexXY + dcaToVertexZ*dcaToVertexZ);
 
-  // getting the kinematic variables of the track
-  // (assuming the mass is known)
-  Double_t p[3];
-  esdTrack->GetPxPyPz(p);
+  const Double_t* p = vars.fP;
+  Double_t momentum = vars.fMomentum;
+  Double_t pt       = vars.fPt;
+  Float_t eta = vars.fEta;
+  Float_t y   = vars.fY;
 
-  // Changed from float to double to prevent rounding errors leading to negative
-  // log arguments (M.G.)
-  Double_t momentum = TMath::Sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
-  Double_t pt       = TMath::Sqrt(p[0]*p[0] + p[1]*p[1]);
-  Double_t mass     = esdTrack->GetMass();
-  Double_t energy   = TMath::Sqrt(mass*mass + momentum*momentum);
-
-  //y-eta related calculations
-  Float_t eta = -100.;
-  Float_t y   = -100.;
-  if((momentum != TMath::Abs(p[2]))&&(momentum != 0))
-    eta = 0.5*TMath::Log((momentum + p[2])/(momentum - p[2]));
-  if((energy != TMath::Abs(p[2]))&&(energy != 0))
-    y = 0.5*TMath::Log((energy + p[2])/(energy - p[2]));
-
-  if (extCov[14] < 0)
+  if (cov[4] < 0)
   {
-    AliWarning(Form("GetSigma1Pt2() returns negative value for external covariance matrix element fC[14]: %f. Corrupted track information, track will not be accepted!", extCov[14]));
+    AliWarning(Form("GetSigma1Pt2() returns negative value for external covariance matrix element fC[14]: %f. Corrupted track information, track will not be accepted!", cov[4]));
     return kFALSE;
   }
-  Float_t relUncertainty1Pt = TMath::Sqrt(extCov[14])*pt;
+  Float_t relUncertainty1Pt = vars.fRelUncertainty1Pt;
 
   //########################################################################
   // cut the track?
@@ -1377,20 +1445,20 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
     cuts[5]=kTRUE;
   if (chi2PerClusterITS>fCutMaxChi2PerClusterITS)
     cuts[6]=kTRUE;
-  if (extCov[0]  > fCutMaxC11)
+  if (cov[0]  > fCutMaxC11)
     cuts[7]=kTRUE;
-  if (extCov[2]  > fCutMaxC22)
+  if (cov[1]  > fCutMaxC22)
     cuts[8]=kTRUE;
-  if (extCov[5]  > fCutMaxC33)
+  if (cov[2]  > fCutMaxC33)
     cuts[9]=kTRUE;
-  if (extCov[9]  > fCutMaxC44)
+  if (cov[3]  > fCutMaxC44)
     cuts[10]=kTRUE;
-  if (extCov[14]  > fCutMaxC55)
+  if (cov[4]  > fCutMaxC55)
     cuts[11]=kTRUE;
 
   // cut 12 and 13 see below
 
-  if (!fCutAcceptKinkDaughters && esdTrack->GetKinkIndex(0)>0)
+  if (!fCutAcceptKinkDaughters && vars.fKinkIndex>0)
     cuts[14]=kTRUE;
   // track kinematics cut
   if((momentum < fPMin) || (momentum > fPMax))
@@ -1420,15 +1488,16 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
   if (!fCutDCAToVertex2D && TMath::Abs(dcaToVertexZ) < fCutMinDCAToVertexZ)
     cuts[27] = kTRUE;
 
+  UChar_t clumap = vars.fITSClusterMap;
   for (Int_t i = 0; i < 3; i++) {
-    if(!(esdTrack->GetStatus()&AliESDtrack::kITSupg)) { // current ITS
-      cuts[28+i] = !CheckITSClusterRequirement(fCutClusterRequirementITS[i], esdTrack->HasPointOnITSLayer(i*2), esdTrack->HasPointOnITSLayer(i*2+1));
+    if(!(status&AliESDtrack::kITSupg)) { // current ITS
+      cuts[28+i] = !CheckITSClusterRequirement(fCutClusterRequirementITS[i], TESTBIT(clumap,i*2), TESTBIT(clumap,i*2+1));
     } else { // upgraded ITS (7 layers)
       // at the moment, for L012 the layers 12 are considered together
       if(i==0) { // L012
-	cuts[28+i] = !CheckITSClusterRequirement(fCutClusterRequirementITS[i], esdTrack->HasPointOnITSLayer(0), (esdTrack->HasPointOnITSLayer(1))&(esdTrack->HasPointOnITSLayer(2)));
+	cuts[28+i] = !CheckITSClusterRequirement(fCutClusterRequirementITS[i], TESTBIT(clumap,0), (TESTBIT(clumap,1))&(TESTBIT(clumap,2)));
       } else { // L34 or L56
-	cuts[28+i] = !CheckITSClusterRequirement(fCutClusterRequirementITS[i], esdTrack->HasPointOnITSLayer(i*2+1), esdTrack->HasPointOnITSLayer(i*2+2));
+	cuts[28+i] = !CheckITSClusterRequirement(fCutClusterRequirementITS[i], TESTBIT(clumap,i*2+1), TESTBIT(clumap,i*2+2));
       }
     }
   }
@@ -1456,11 +1525,7 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
   if (fracClustersTPCShared > fCutMaxFractionSharedTPCClusters)
     cuts[34] = kTRUE;
 
-  Int_t nITSPointsForPid=0;
-  UChar_t clumap=esdTrack->GetITSClusterMap();
-  for(Int_t i=2; i<6; i++){
-    if(clumap&(1<<i)) ++nITSPointsForPid;
-  }
+  Int_t nITSPointsForPid = vars.fNITSPointsForPid;
   if(fCutRequireITSPid && nITSPointsForPid<3) cuts[35] = kTRUE;
 
 
@@ -1469,13 +1534,7 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
   if (ratioCrossedRowsOverFindableClustersTPC<fCutMinRatioCrossedRowsOverFindableClustersTPC)
     cuts[37]=kTRUE;
 
-  Int_t nMissITSpts=0;
-  Int_t idet,statusLay;
-  Float_t xloc,zloc;
-  for(Int_t iLay=0; iLay<6; iLay++){
-    Bool_t retc=esdTrack->GetITSModuleIndexInfo(iLay,idet,statusLay,xloc,zloc);
-    if(retc && statusLay==5) ++nMissITSpts;
-  }
+  Int_t nMissITSpts = vars.fNMissingITSPoints;
   if(nMissITSpts>fCutMaxMissingITSPoints) cuts[38] = kTRUE;
 
   //kTOFout
@@ -1485,9 +1544,9 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
   // TOF signal Dz cut
   Float_t dxTOF = 999.; //esdTrack->GetTOFsignalDx();
   Float_t dzTOF = 999.; //esdTrack->GetTOFsignalDz();
-  if (fFlagCutTOFdistance && (esdTrack->GetStatus() & AliESDtrack::kTOFout) == AliESDtrack::kTOFout){ // applying the TOF distance cut only if requested, and only on tracks that reached the TOF and where associated with a TOF hit
-    dxTOF = esdTrack->GetTOFsignalDx();
-    dzTOF = esdTrack->GetTOFsignalDz();
+  if (fFlagCutTOFdistance && (status & AliESDtrack::kTOFout) == AliESDtrack::kTOFout){ // applying the TOF distance cut only if requested, and only on tracks that reached the TOF and where associated with a TOF hit
+    dxTOF = vars.fTOFsignalDx;
+    dzTOF = vars.fTOFsignalDz;
 	  if (fgBeamTypeFlag < 0) {  // the check on the beam type was not done yet
 		  const AliESDEvent* event = esdTrack->GetESDEvent();
 		  if (event){
@@ -1651,11 +1710,11 @@ Bool_t AliESDtrackCuts::AcceptTrack(const AliESDtrack* esdTrack)
       fhNClustersForITSPID[id]->Fill(nITSPointsForPid);
       fhNMissingITSPoints[id]->Fill(nMissITSpts);
 
-      fhC11[id]->Fill(extCov[0]);
-      fhC22[id]->Fill(extCov[2]);
-      fhC33[id]->Fill(extCov[5]);
-      fhC44[id]->Fill(extCov[9]);
-      fhC55[id]->Fill(extCov[14]);
+      fhC11[id]->Fill(cov[0]);
+      fhC22[id]->Fill(cov[1]);
+      fhC33[id]->Fill(cov[2]);
+      fhC44[id]->Fill(cov[3]);
+      fhC55[id]->Fill(cov[4]);
 
       fhRel1PtUncertainty[id]->Fill(relUncertainty1Pt);
 
@@ -2306,6 +2365,50 @@ Int_t AliESDtrackCuts::CountAcceptedTracks(const AliESDEvent* const esd)
   return count;
 }
 
+//____________________________________________________________________
+Int_t AliESDtrackCuts::AcceptTracks(const AliESDEvent* const esd, const TObjArray* cutsList, std::vector<UInt_t>& masks)
+{
+  //
+  // evaluates several track cut configurations on all tracks of the event
+  // in one pass. The quantities needed by the cuts are retrieved from the
+  // tracks only once (FillTrackVars) and then each configuration in cutsList
+  // is applied to them. Bit i of masks[iTrack] is set if track iTrack passes
+  // the i-th AliESDtrackCuts of the list (at most 32 configurations).
+  //
+  // returns the number of tracks, or -1 if cutsList has more than 32 entries
+  //
+
+  const Int_t kMaxCuts = 32;
+  Int_t nCuts = cutsList ? cutsList->GetEntriesFast() : 0;
+  if (nCuts > kMaxCuts) {
+    AliErrorClass(Form("%d cut configurations given, at most %d can be evaluated at once", nCuts, kMaxCuts));
+    masks.clear();
+    return -1;
+  }
+
+  Int_t nTracks = esd->GetNumberOfTracks();
+  masks.assign(nTracks, 0u);
+  if (nTracks == 0 || nCuts == 0)
+    return nTracks;
+
+  std::vector<TrackVars> vars(nTracks);
+  for (Int_t iTrack = 0; iTrack < nTracks; iTrack++)
+    FillTrackVars(esd->GetTrack(iTrack), vars[iTrack]);
+
+  for (Int_t iCut = 0; iCut < nCuts; iCut++) {
+    AliESDtrackCuts* cuts = dynamic_cast<AliESDtrackCuts*>(cutsList->At(iCut));
+    if (!cuts)
+      continue;
+    const UInt_t bit = 1u << iCut;
+    for (Int_t iTrack = 0; iTrack < nTracks; iTrack++) {
+      if (cuts->AcceptTrackVars(esd->GetTrack(iTrack), vars[iTrack]))
+        masks[iTrack] |= bit;
+    }
+  }
+
+  return nTracks;
+}
+
 //____________________________________________________________________
  void AliESDtrackCuts::DefineHistograms(Int_t color) {
    //
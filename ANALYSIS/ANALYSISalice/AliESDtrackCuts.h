@@ -8,6 +8,8 @@
 //  returns kTRUE/kFALSE or GetAcceptedTracks which takes an AliESDEvent
 //  object and returns an TObjArray (of AliESDtracks) with the tracks
 //  in the ESD that survived the cuts.
+//  Several cut configurations can be applied to all tracks of an event
+//  in one pass with AcceptTracks, which returns per-track bit masks.
 //
 //
 //  TODO:
@@ -23,6 +25,8 @@
 
 #include <TString.h>
 
+#include <vector>
+
 #include "AliAnalysisCuts.h"
 
 class AliESDEvent;
@@ -59,6 +63,7 @@ public:
   Bool_t AcceptVTrack(const AliVTrack* vTrack);
   TObjArray* GetAcceptedTracks(const AliESDEvent* esd, Bool_t bTPC = kFALSE);
   Int_t CountAcceptedTracks(const AliESDEvent* const esd);
+  static Int_t AcceptTracks(const AliESDEvent* const esd, const TObjArray* cutsList, std::vector<UInt_t>& masks);
   
   static Int_t GetReferenceMultiplicity(const AliESDEvent* esd, Bool_t tpcOnly);
   static Int_t GetReferenceMultiplicity(const AliESDEvent* esd, MultEstTrackType trackType = kTrackletsITSTPC, Float_t etaRange = 0.5, Float_t etaCent=0.);
@@ -218,6 +223,37 @@ public:
   void SetRequireStandardTOFmatchCuts();
 
 protected:
+  // track quantities used by the cuts, independent of the cut configuration
+  struct TrackVars {
+    UInt_t   fStatus;                  // track status flags
+    Int_t    fNClustersITS;            // number of ITS clusters
+    Int_t    fNClustersTPC[2];         // number of TPC clusters (global, TPC standalone)
+    Int_t    fNClustersTPCShared;      // number of shared TPC clusters
+    Float_t  fNCrossedRowsTPC;         // number of TPC crossed rows
+    Float_t  fRatioCrossedRowsOverFindableClustersTPC; // crossed rows / findable clusters
+    Float_t  fChi2PerClusterITS;       // ITS chi2 per cluster
+    Float_t  fChi2PerClusterTPC[2];    // TPC chi2 per cluster (global, TPC standalone)
+    Float_t  fFracClustersTPCShared[2];// fraction of shared TPC clusters (global, TPC standalone)
+    Double_t fCovDiag[5];              // diagonal elements of the external covariance matrix
+    Float_t  fB[2];                    // impact parameters (xy, z)
+    Float_t  fBCov[3];                 // covariance of the impact parameters
+    Double_t fP[3];                    // momentum components
+    Double_t fMomentum;                // total momentum
+    Double_t fPt;                      // transverse momentum
+    Float_t  fEta;                     // pseudorapidity
+    Float_t  fY;                       // rapidity
+    Float_t  fRelUncertainty1Pt;       // rel. uncertainty of 1/pt
+    Int_t    fKinkIndex;               // kink index of the first kink
+    UChar_t  fITSClusterMap;           // ITS cluster map
+    Int_t    fNITSPointsForPid;        // number of points in SDD+SSD
+    Int_t    fNMissingITSPoints;       // number of missing ITS points
+    Float_t  fTOFsignalDx;             // TOF signal dx (999 if not kTOFout)
+    Float_t  fTOFsignalDz;             // TOF signal dz (999 if not kTOFout)
+  };
+
+  static void FillTrackVars(const AliESDtrack* esdTrack, TrackVars& vars);
+  Bool_t AcceptTrackVars(const AliESDtrack* esdTrack, const TrackVars& vars);
+
   void Init(); // sets everything to 0
   Bool_t CheckITSClusterRequirement(ITSClusterRequirement req, Bool_t clusterL1, Bool_t clusterL2);
   Bool_t CheckPtDepDCA(TString dist,Bool_t print=kFALSE) const;
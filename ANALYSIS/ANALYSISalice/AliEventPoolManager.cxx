@@ -1,12 +1,15 @@
 #include "AliEventPoolManager.h"
 #include "TList.h"
 #include "TRandom.h"
+#include <algorithm>
 #include <iostream>
 
 using std::cout;
 using std::endl;
 ClassImp(AliEventPool)
 
+Int_t AliEventPool::fgEventCounter = -1;
+
 void AliEventPool::PrintInfo() const
 {
   cout << Form("%20s: %d events", "Pool capacity", fMixDepth) << endl;
@@ -43,7 +46,7 @@ Int_t AliEventPool::NTracksInPool() const
   // events.
 
   Int_t ntrk=0;
-  for (Int_t i=0; i<(Int_t)fEvents.size(); ++i) {
+  for (Int_t i=0; i<(Int_t)fNTracksInEvent.size(); ++i) {
     ntrk += fNTracksInEvent.at(i);
   }
   return ntrk;
@@ -101,53 +104,129 @@ Int_t AliEventPool::UpdatePool(TObjArray *trk)
   // A rolling buffer (a double-ended queue) is updated by removing
   // the oldest event, and appending the newest.
   //
-  // the ownership of <trk> is delegated to this class
+  // the ownership of <trk> is delegated to this class. With packed
+  // storage the kinematics of the tracks (which have to inherit from
+  // AliVParticle) are copied into the arena and <trk> is deleted
+
+  Int_t mult = trk->GetEntries();
+  if (!PrepareUpdate(mult))
+    return GetCurrentNEvents();
+
+  if (!IsPacked()) {
+    Bool_t becomesReady = (!IsReady() && IsReady(NTracksInPool() + mult, GetCurrentNEvents() + 1));
+    // remove 0th element before appending this event
+    Int_t nTrk = NTracksInPool();
+    if (nTrk>fTargetTrackDepth) {
+      Int_t nTrksFirstEvent= fNTracksInEvent.front();
+      Int_t diff = nTrk - nTrksFirstEvent + mult;
+      if (diff>fTargetTrackDepth)
+        RemoveFirstEvent();
+    }
+    fEvents.push_back(trk);
+    FinishUpdate(mult, becomesReady);
+    return GetCurrentNEvents();
+  }
+
+  // only the tracks which can be packed are counted for the event
+  Int_t nPacked = 0;
+  for (Int_t i=0; i<mult; i++) {
+    if (dynamic_cast<AliVParticle*>(trk->At(i)))
+      nPacked++;
+  }
+  if (nPacked < mult)
+    AliError("Packed event pools can only store tracks inheriting from AliVParticle");
+  if (nPacked == 0) {
+    delete trk;
+    return GetCurrentNEvents();
+  }
+
+  Bool_t becomesReady = (!IsReady() && IsReady(NTracksInPool() + nPacked, GetCurrentNEvents() + 1));
+
+  Int_t offset = ReserveArena(nPacked);
+  if (offset < 0) {
+    delete trk;
+    return GetCurrentNEvents();
+  }
+
+  Int_t nStored = 0;
+  for (Int_t i=0; i<mult; i++) {
+    AliVParticle* part = dynamic_cast<AliVParticle*>(trk->At(i));
+    if (!part)
+      continue;
+    AliEventPoolTrack& rec = fArena[offset + nStored++];
+    rec.fPt     = part->Pt();
+    rec.fEta    = part->Eta();
+    rec.fPhi    = part->Phi();
+    rec.fCharge = part->Charge();
+    rec.fFlags  = 0;
+  }
+  delete trk;
+
+  fEventOffset.push_back(offset);
+  fArenaHead = offset + nStored;
+  FinishUpdate(nStored, becomesReady);
+
+  return GetCurrentNEvents();
+}
+
+Int_t AliEventPool::UpdatePool(const AliEventPoolTrack *trk, Int_t nTracks)
+{
+  // Appends an event given as packed track records to the ring buffer,
+  // the records are copied. Packed storage has to be enabled.
+
+  if (!IsPacked()) {
+    AliError("Packed storage not enabled, call SetPackedCapacity first.");
+    return GetCurrentNEvents();
+  }
+  if (!PrepareUpdate(nTracks))
+    return GetCurrentNEvents();
+
+  Bool_t becomesReady = (!IsReady() && IsReady(NTracksInPool() + nTracks, GetCurrentNEvents() + 1));
+
+  Int_t offset = ReserveArena(nTracks);
+  if (offset < 0)
+    return GetCurrentNEvents();
+
+  std::copy(trk, trk + nTracks, fArena.begin() + offset);
+  fEventOffset.push_back(offset);
+  fArenaHead = offset + nTracks;
+  FinishUpdate(nTracks, becomesReady);
+
+  return GetCurrentNEvents();
+}
+
+Bool_t AliEventPool::PrepareUpdate(Int_t mult)
+{
+  // Common checks before an event is appended. Returns kFALSE if the
+  // event must not be added.
 
   if(fLockFlag)
   {
     AliFatal("Tried to fill a locked AliEventPool.");
-    return fEvents.size();
+    return kFALSE;
   }
 
-  static Int_t iEvent = -1; 
-  iEvent++;
+  fgEventCounter++;
 
-  Int_t mult = trk->GetEntries();
-  
   // Do not fill empty events
-  if (mult == 0)
-    return fEvents.size();
-  
-  Int_t nTrk = NTracksInPool();
+  return (mult > 0);
+}
 
-  if (!IsReady() && IsReady(nTrk + mult, GetCurrentNEvents() + 1))
-    fNTimes++;
+void AliEventPool::FinishUpdate(Int_t mult, Bool_t becomesReady)
+{
+  // Bookkeeping after an event with <mult> tracks was appended.
 
-  // remove 0th element before appending this event
-  Bool_t removeFirstEvent = 0;
-  if (nTrk>fTargetTrackDepth) {
-    Int_t nTrksFirstEvent= fNTracksInEvent.front();
-    Int_t diff = nTrk - nTrksFirstEvent + mult;
-    if (diff>fTargetTrackDepth)
-      removeFirstEvent = 1;
-  }
-  if (removeFirstEvent) {
-    TObjArray *fa = fEvents.front();
-    delete fa;
-    fEvents.pop_front();         // remove first track array 
-    fNTracksInEvent.pop_front(); // remove first int
-    fEventIndex.pop_front();
-  }
+  if (becomesReady)
+    fNTimes++;
 
   fNTracksInEvent.push_back(mult);
-  fEvents.push_back(trk);
-  fEventIndex.push_back(iEvent);
+  fEventIndex.push_back(fgEventCounter);
 
   if (fNTimes==1) {
     fFirstFilled = kTRUE;
     if (AliEventPool::fDebug) {
       cout << "\nPool " << MultBinIndex() << ", " << ZvtxBinIndex() 
-           << " ready at event "<< iEvent;
+           << " ready at event "<< fgEventCounter;
       PrintInfo();
       cout << endl;
     }
@@ -163,8 +242,131 @@ Int_t AliEventPool::UpdatePool(TObjArray *trk)
     cout << " PoolDepth = " << GetCurrentNEvents() << endl;
     cout << " NTracksInCurrentEvent = " << NTracksInCurrentEvent() << endl;
   }
+}
 
-  return fEvents.size();
+void AliEventPool::RemoveFirstEvent()
+{
+  // Removes the oldest event from the pool.
+
+  if (fNTracksInEvent.empty())
+    return;
+
+  if (!fEvents.empty()) {
+    TObjArray *fa = fEvents.front();
+    delete fa;
+    fEvents.pop_front();         // remove first track array 
+  }
+  if (!fEventOffset.empty())
+    fEventOffset.pop_front();    // the records are overwritten later
+  fNTracksInEvent.pop_front(); // remove first int
+  fEventIndex.pop_front();
+}
+
+void AliEventPool::SetPackedCapacity(Int_t nTracks, EEvictionPolicy policy)
+{
+  // Switches to packed storage: the pool keeps at most <nTracks> track
+  // records in a ring buffer which is allocated here once. Events are
+  // stored contiguously. If an event does not fit into the free space,
+  // the oldest events are evicted (kEvictOldest) or the new event is
+  // dropped (kRejectNewest). The pool is cleared.
+  // nTracks <= 0 switches back to storing the TObjArrays.
+
+  Clear();
+  std::vector<AliEventPoolTrack>().swap(fArena);
+  if (nTracks > 0)
+    fArena.resize(nTracks);
+  fArenaHead = 0;
+  fEvictionPolicy = policy;
+}
+
+Int_t AliEventPool::FindArenaSlot(Int_t nTracks) const
+{
+  // Offset at which <nTracks> records fit contiguously without
+  // overwriting stored events, -1 if there is no such space.
+
+  const Int_t capacity = fArena.size();
+  if (fEventOffset.empty())
+    return (nTracks <= capacity) ? 0 : -1;
+
+  const Int_t first = fEventOffset.front();
+  if (fArenaHead > first) {
+    // used region is [first, head)
+    if (fArenaHead + nTracks <= capacity)
+      return fArenaHead;
+    if (nTracks <= first)
+      return 0;
+    return -1;
+  }
+
+  // wrapped: used regions are [first, capacity) and [0, head)
+  if (fArenaHead + nTracks <= first)
+    return fArenaHead;
+  return -1;
+}
+
+Int_t AliEventPool::ReserveArena(Int_t nTracks)
+{
+  // Removes events according to the track depth and the eviction policy
+  // until <nTracks> records fit. Returns the offset or -1 if the event
+  // is dropped.
+
+  if (nTracks > (Int_t)fArena.size()) {
+    AliWarning(Form("Event with %d tracks exceeds the pool capacity of %d tracks, dropped", nTracks, (Int_t)fArena.size()));
+    return -1;
+  }
+
+  // remove 0th element before appending this event
+  Int_t nTrk = NTracksInPool();
+  if (nTrk>fTargetTrackDepth) {
+    Int_t diff = nTrk - fNTracksInEvent.front() + nTracks;
+    if (diff>fTargetTrackDepth)
+      RemoveFirstEvent();
+  }
+
+  Int_t offset = FindArenaSlot(nTracks);
+  while (offset < 0 && fEvictionPolicy == kEvictOldest && GetCurrentNEvents() > 0) {
+    RemoveFirstEvent();
+    offset = FindArenaSlot(nTracks);
+  }
+
+  return offset;
+}
+
+const AliEventPoolTrack* AliEventPool::GetPackedEvent(Int_t i, Int_t &nTracks) const
+{
+  // Returns the records of event <i> (local pool index), no copy is made.
+  // The pointer is valid until the pool is updated.
+
+  nTracks = 0;
+  if (i<0 || i>=(Int_t)fEventOffset.size()) {
+    cout << "AliEventPool::GetPackedEvent(" 
+	 << i << "): Invalid index" << endl;
+    return 0x0;
+  }
+
+  nTracks = fNTracksInEvent.at(i);
+  return &fArena[fEventOffset.at(i)];
+}
+
+const AliEventPoolTrack* AliEventPool::GetRandomPackedEvent(Int_t &nTracks) const
+{
+  nTracks = 0;
+  if (fEventOffset.empty())
+    return 0x0;
+  UInt_t ranEvt = gRandom->Integer(fEventOffset.size());
+  return GetPackedEvent(ranEvt, nTracks);
+}
+
+const AliEventPoolTrack* AliEventPool::GetRandomPackedTrack() const
+{
+  // Get any random track record from the pool, sampled with uniform
+  // probability over events as GetRandomTrack.
+
+  Int_t nTracks = 0;
+  const AliEventPoolTrack* evt = GetRandomPackedEvent(nTracks);
+  if (!evt || nTracks == 0)
+    return 0x0;
+  return &evt[gRandom->Integer(nTracks)];
 }
 
 Long64_t AliEventPool::Merge(TCollection* hlist)
@@ -172,6 +374,19 @@ Long64_t AliEventPool::Merge(TCollection* hlist)
   if (!hlist)
   	return 0;
 
+  // packed records cannot be turned back into track objects, refuse the
+  // merge instead of dropping their events
+  if (!IsPacked()) {
+    TIter checkIter(hlist);
+    AliEventPool* obj = 0;
+    while ( (obj = static_cast<AliEventPool*>(checkIter())) ) {
+      if (obj->IsPacked() && !obj->fEventOffset.empty()) {
+        AliError("Cannot merge a packed pool into a pool without packed storage, call SetPackedCapacity first.");
+        return -1;
+      }
+    }
+  }
+
   Bool_t origLock = fLockFlag;
   fLockFlag = kFALSE; // temporary deactivate lockflag to allow filling
   AliEventPool* tmpObj = 0;
@@ -179,9 +394,17 @@ Long64_t AliEventPool::Merge(TCollection* hlist)
   // Iterate through all objects to be merged
   while ( (tmpObj = static_cast<AliEventPool*>(objIter())) )
   {
-    // Update this pool (it won't get fuller than demanded)
-    for(Int_t i=0; i<tmpObj->fEvents.size(); i++)
-      UpdatePool(tmpObj->fEvents.at(i));
+    // Update this pool (it won't get fuller than demanded). The pool
+    // takes ownership of the arrays it is given, hence copies are added
+    for(Int_t i=0; i<(Int_t)tmpObj->fEvents.size(); i++)
+      UpdatePool(static_cast<TObjArray*>(tmpObj->fEvents.at(i)->Clone()));
+    if (IsPacked()) {
+      for(Int_t i=0; i<(Int_t)tmpObj->fEventOffset.size(); i++) {
+        Int_t nTracks = 0;
+        const AliEventPoolTrack* evt = tmpObj->GetPackedEvent(i, nTracks);
+        UpdatePool(evt, nTracks);
+      }
+    }
   }
   fLockFlag = origLock;
   return hlist->GetEntries() + 1;
@@ -194,6 +417,8 @@ void AliEventPool::Clear()
   fEvents.clear();
   fNTracksInEvent.clear();
   fEventIndex.clear();
+  fEventOffset.clear();
+  fArenaHead = 0;
   fWasUpdated = 0;
   fFirstFilled = 0;
   fWasUpdated = 0;
@@ -205,6 +430,8 @@ TObject* AliEventPool::GetRandomTrack() const
 {
   // Get any random track from the pool, sampled with uniform probability.
 
+  if (fEvents.empty())
+    return 0x0;
   UInt_t ranEvt = gRandom->Integer(fEvents.size());
   TObjArray *tca = fEvents.at(ranEvt);
   UInt_t ranTrk = gRandom->Integer(tca->GetEntries());
@@ -226,6 +453,8 @@ TObjArray* AliEventPool::GetEvent(Int_t i) const
 
 TObjArray* AliEventPool::GetRandomEvent() const
 {
+  if (fEvents.empty())
+    return 0x0;
   UInt_t ranEvt = gRandom->Integer(fEvents.size());
   TObjArray *tca = fEvents.at(ranEvt);
   return tca;
@@ -442,6 +671,28 @@ void AliEventPoolManager::SetTargetValues(Int_t trackDepth, Float_t fraction, In
   }
 }
 
+void AliEventPoolManager::SetPackedMemoryBudget(Long64_t bytes, AliEventPool::EEvictionPolicy policy)
+{
+  // Switches all pools to packed storage. The memory budget is shared
+  // equally between the pools and allocated once here.
+  // bytes <= 0 switches back to storing the TObjArrays.
+
+  Int_t nPools = fEvPool.size();
+  if (nPools == 0)
+    return;
+
+  Long64_t nTracks = (bytes > 0) ? bytes / ((Long64_t)sizeof(AliEventPoolTrack) * nPools) : 0;
+  if (bytes > 0 && nTracks == 0)
+    AliWarning(Form("Memory budget of %lld bytes too small for %d pools", bytes, nPools));
+  if (nTracks > kMaxInt) {
+    AliWarning(Form("Memory budget of %lld bytes exceeds %d tracks per pool, limited", bytes, kMaxInt));
+    nTracks = kMaxInt;
+  }
+
+  for (Int_t i=0; i<nPools; i++)
+    fEvPool.at(i)->SetPackedCapacity((Int_t)nTracks, policy);
+}
+
 void AliEventPoolManager::ClearPools()
 {
   // Clear the pools that are not marked to be saved
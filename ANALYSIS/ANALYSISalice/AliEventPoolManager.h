@@ -17,13 +17,30 @@
 // passed in at initialization. For example of implementation, see
 // $ALICE_ROOT/PWGCF/Correlations/DPhi/AliAnalysisTaskPhiCorrelations.cxx
 //
+// Optionally (AliEventPool::SetPackedCapacity or
+// AliEventPoolManager::SetPackedMemoryBudget) the pools keep only the
+// kinematics of the tracks as AliEventPoolTrack records in a ring buffer
+// which is allocated once per pool. Mixed events are then accessed
+// without copies through GetPackedEvent.
+//
 // Authors: A. Adare and C. Loizides
 
 using std::deque;
 
+struct AliEventPoolTrack
+{
+  Float_t  fPt;      // transverse momentum
+  Float_t  fEta;     // pseudorapidity
+  Float_t  fPhi;     // azimuthal angle
+  Short_t  fCharge;  // charge
+  UShort_t fFlags;   // user defined bits
+};
+
 class AliEventPool : public TObject
 {
  public:
+  enum EEvictionPolicy { kEvictOldest = 0, kRejectNewest };
+
  AliEventPool() 
    : fEvents(0),
     fNTracksInEvent(0),
@@ -49,7 +66,11 @@ class AliEventPool : public TObject
     fSaveFlag(0),
     fNTimes(0),
     fTargetFraction(1),
-    fTargetEvents(0)  {;} // default constructor needed for correct saving
+    fTargetEvents(0),
+    fArena(),
+    fEventOffset(),
+    fArenaHead(0),
+    fEvictionPolicy(kEvictOldest)  {;} // default constructor needed for correct saving
 
  AliEventPool(Int_t d) 
    : fEvents(0),
@@ -76,7 +97,11 @@ class AliEventPool : public TObject
     fSaveFlag(0),
     fNTimes(0),
     fTargetFraction(1),
-    fTargetEvents(0)  {;}
+    fTargetEvents(0),
+    fArena(),
+    fEventOffset(),
+    fArenaHead(0),
+    fEvictionPolicy(kEvictOldest)  {;}
   
 
  AliEventPool(Int_t d, Double_t multMin, Double_t multMax, 
@@ -107,7 +132,11 @@ class AliEventPool : public TObject
     fSaveFlag(0),
     fNTimes(0),
     fTargetFraction(1),
-    fTargetEvents(0) {;}
+    fTargetEvents(0),
+    fArena(),
+    fEventOffset(),
+    fArenaHead(0),
+    fEvictionPolicy(kEvictOldest) {;}
   
   ~AliEventPool() {;}
   
@@ -116,7 +145,7 @@ class AliEventPool : public TObject
   Bool_t      IsReady()                    const { return IsReady(NTracksInPool(), GetCurrentNEvents()); }
   Bool_t      IsFirstReady()               const { return fFirstFilled;   }
   Int_t       GetNTimes()                  const { return fNTimes;        }
-  Int_t       GetCurrentNEvents()          const { return fEvents.size(); }
+  Int_t       GetCurrentNEvents()          const { return fNTracksInEvent.size(); }
   Int_t       GlobalEventIndex(Int_t j)    const;
   TObject    *GetRandomTrack()             const;
   TObjArray  *GetRandomEvent()             const;
@@ -156,12 +185,28 @@ class AliEventPool : public TObject
   Double_t    GetZvtxMax() { return fZvtxMax; }
 
   Int_t       UpdatePool(TObjArray *trk);
+  Int_t       UpdatePool(const AliEventPoolTrack *trk, Int_t nTracks);
+
+  // packed storage
+  void        SetPackedCapacity(Int_t nTracks, EEvictionPolicy policy = kEvictOldest);
+  Bool_t      IsPacked()                   const { return !fArena.empty(); }
+  Int_t       GetPackedCapacity()          const { return fArena.size(); }
+  const AliEventPoolTrack *GetPackedEvent(Int_t i, Int_t &nTracks) const;
+  const AliEventPoolTrack *GetRandomPackedEvent(Int_t &nTracks) const;
+  const AliEventPoolTrack *GetRandomPackedTrack() const;
   Long64_t    Merge(TCollection* hlist);
 //  deque<TObjArray*> GetEvents() { return fEvents; }
   void        Clear();
 
 protected:
   Bool_t      IsReady(Int_t tracks, Int_t events) const { return (tracks >= fTargetFraction * fTargetTrackDepth) || ((fTargetEvents > 0) && (events >= fTargetEvents)); }
+  Bool_t      PrepareUpdate(Int_t mult);
+  void        FinishUpdate(Int_t mult, Bool_t becomesReady);
+  void        RemoveFirstEvent();
+  Int_t       FindArenaSlot(Int_t nTracks) const;
+  Int_t       ReserveArena(Int_t nTracks);
+
+  static Int_t          fgEventCounter;       //Global event index of the last update
   
   deque<TObjArray*>     fEvents;              //Holds TObjArrays of MyTracklets
   deque<int>            fNTracksInEvent;      //Tracks in event
@@ -184,8 +229,12 @@ protected:
   Int_t                 fNTimes;              //Number of times init. condition reached
   Float_t               fTargetFraction;      //fraction of fTargetTrackDepth at which pool is ready (default: 1.0)
   Int_t                 fTargetEvents;        //if non-zero: number of filled events after which pool is ready regardless of fTargetTrackDepth (default: 0)
+  std::vector<AliEventPoolTrack> fArena;      //Packed track records (ring buffer), empty if packed storage is not used
+  deque<int>            fEventOffset;         //Offset of the events in fArena
+  Int_t                 fArenaHead;           //Position in fArena behind the newest event
+  Int_t                 fEvictionPolicy;      //What to do if fArena is full (EEvictionPolicy)
 
-  ClassDef(AliEventPool,4) // Event pool class
+  ClassDef(AliEventPool,5) // Event pool class
 };
 
 class AliEventPoolManager : public TObject
@@ -239,6 +288,7 @@ public:
   Int_t       UpdatePools(TObjArray *trk);
   void        SetDebug(Bool_t b) { fDebug = b; }
   void        SetTargetValues(Int_t trackDepth, Float_t fraction, Int_t events);
+  void        SetPackedMemoryBudget(Long64_t bytes, AliEventPool::EEvictionPolicy policy = AliEventPool::kEvictOldest);
   Int_t       GetNumberOfAllBins() {return fNPtBins*fNMultBins*fNZvtxBins*fNPsiBins;}
   Int_t       GetNumberOfPtBins() {return fNPtBins;}
   Int_t       GetNumberOfMultBins() {return fNMultBins;}
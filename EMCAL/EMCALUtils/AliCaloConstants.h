@@ -96,7 +96,7 @@ namespace CaloConstants
   
   namespace FitAlgorithm
   {
-    enum fitAlgorithm { kStandard = 0, kCrude = 1, kPeakFinder = 2, kNeuralNet = 3, kFastFit= 4, kFakeAltro = 9, kNONE = 8 } ; // possible return values
+    enum fitAlgorithm { kStandard = 0, kCrude = 1, kPeakFinder = 2, kNeuralNet = 3, kFastFit= 4, kStandardFast = 5, kFakeAltro = 9, kNONE = 8 } ; // possible return values
   }
   
   namespace ReturnCodes
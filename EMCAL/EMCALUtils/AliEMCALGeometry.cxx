@@ -50,7 +50,8 @@ AliEMCALGeometry::AliEMCALGeometry():
   fDCALInnerExtandedEta(0),fShishKebabTrd1Modules(0),fPhiModuleSize(0.),
   fEtaModuleSize(0.),fPhiTileSize(0.),fEtaTileSize(0.),fNZ(0),
   fIPDistance(0.),fLongModuleSize(0.),fShellThickness(0.),
-  fZLength(0.),fSampling(0.),fUseExternalMatrices(kFALSE)
+  fZLength(0.),fSampling(0.),fUseExternalMatrices(kFALSE),
+  fCellNeighbourFirst(),fCellNeighbours(),fCellNeighbourOtherSM()
 {
   // default ctor 
   // must be kept public for root persistency purposes, but should never be called by the outside world
@@ -78,7 +79,8 @@ AliEMCALGeometry::AliEMCALGeometry(const AliEMCALGeometry & geo)
     fDCALInnerExtandedEta(geo.fDCALInnerExtandedEta),fShishKebabTrd1Modules(geo.fShishKebabTrd1Modules),fPhiModuleSize(geo.fPhiModuleSize),
     fEtaModuleSize(geo.fEtaModuleSize),fPhiTileSize(geo.fPhiTileSize),fEtaTileSize(geo.fEtaTileSize),fNZ(geo.fNZ),
     fIPDistance(geo.fIPDistance),fLongModuleSize(geo.fLongModuleSize),fShellThickness(geo.fShellThickness),
-    fZLength(geo.fZLength),fSampling(geo.fSampling),fUseExternalMatrices(geo.fUseExternalMatrices)
+    fZLength(geo.fZLength),fSampling(geo.fSampling),fUseExternalMatrices(geo.fUseExternalMatrices),
+    fCellNeighbourFirst(geo.fCellNeighbourFirst),fCellNeighbours(geo.fCellNeighbours),fCellNeighbourOtherSM(geo.fCellNeighbourOtherSM)
 {
   // Copy constarctor
   fEnvelop[0] = geo.fEnvelop[0];
@@ -106,7 +108,8 @@ AliEMCALGeometry::AliEMCALGeometry(const Text_t* name,   const Text_t* title,
     fDCALInnerExtandedEta(0),fShishKebabTrd1Modules(0),fPhiModuleSize(0.),
     fEtaModuleSize(0.),fPhiTileSize(0.),fEtaTileSize(0.),fNZ(0),
     fIPDistance(0.),fLongModuleSize(0.),fShellThickness(0.),
-    fZLength(0.),fSampling(0.), fUseExternalMatrices(kFALSE)
+    fZLength(0.),fSampling(0.), fUseExternalMatrices(kFALSE),
+    fCellNeighbourFirst(),fCellNeighbours(),fCellNeighbourOtherSM()
 { 
   // ctor only for normal usage 
   
@@ -817,6 +820,116 @@ int &iphi, int &ieta) const
   nSupMod, nModule, nIphi, nIeta, ieta, iphi));
 }
 
+//________________________________________________________________________________________________
+Int_t AliEMCALGeometry::GetCellNeighbours(Int_t absId, const Int_t *&neighbours, const Char_t *&otherSM) const
+{
+  // Return the number of cells having a common side with cell absId, and in
+  // neighbours their abs id. The definition is the one of
+  // AliEMCALClusterizerv1::AreNeighbours(absId, neighbour): cells of the same SM,
+  // and at eta=0 cells of the SM with the same phi on the other side, flagged
+  // in otherSM (cluster shared by 2 SM).
+  
+  neighbours = 0;
+  otherSM    = 0;
+  
+  if(!CheckAbsCellId(absId)) return 0;
+  
+  if(fCellNeighbourFirst.GetSize() != fNCells+1) BuildCellNeighbourTable();
+  
+  Int_t first = fCellNeighbourFirst[absId];
+  neighbours  = fCellNeighbours.GetArray()       + first;
+  otherSM     = fCellNeighbourOtherSM.GetArray() + first;
+  
+  return fCellNeighbourFirst[absId+1] - first;
+}
+
+//________________________________________________________________________________________________
+void AliEMCALGeometry::BuildCellNeighbourTable() const
+{
+  // Fill the table of neighbours returned by GetCellNeighbours, 
+  // applying once for all cells the rules of AliEMCALClusterizerv1::AreNeighbours.
+  
+  Int_t nSupMod = GetNumberOfSuperModules();
+  
+  // position of the cells in the grid of their SM
+  TArrayI cellSM(fNCells), cellPhi(fNCells), cellEta(fNCells);
+  Int_t nPhi = 0, nEta = 0;
+  Int_t iSupMod=0, nModule=0, nIphi=0, nIeta=0, iphi=0, ieta=0;
+  
+  for(Int_t absId = 0; absId < fNCells; absId++)
+  {
+    GetCellIndex(absId, iSupMod, nModule, nIphi, nIeta);
+    GetCellPhiEtaIndexInSModule(iSupMod, nModule, nIphi, nIeta, iphi, ieta);
+    cellSM [absId] = iSupMod;
+    cellPhi[absId] = iphi;
+    cellEta[absId] = ieta;
+    if(iphi >= nPhi) nPhi = iphi+1;
+    if(ieta >= nEta) nEta = ieta+1;
+  }
+  
+  TArrayI grid(nSupMod*nPhi*nEta);
+  grid.Reset(-1);
+  for(Int_t absId = 0; absId < fNCells; absId++)
+    grid[(cellSM[absId]*nPhi + cellPhi[absId])*nEta + cellEta[absId]] = absId;
+  
+  const Int_t kDPhi[4] = {-1, 1, 0, 0};
+  const Int_t kDEta[4] = { 0, 0,-1, 1};
+  
+  fCellNeighbourFirst  .Set(fNCells+1);
+  fCellNeighbours      .Set(4*fNCells);
+  fCellNeighbourOtherSM.Set(4*fNCells);
+  Int_t n = 0;
+  
+  for(Int_t absId = 0; absId < fNCells; absId++)
+  {
+    fCellNeighbourFirst[absId] = n;
+    Int_t sm1 = cellSM[absId];
+    
+    for(Int_t sm2 = 0; sm2 < nSupMod; sm2++)
+    {
+      // eta index of the 2 cells in a common frame
+      Int_t eta1 = cellEta[absId], shift2 = 0;
+      
+      if(sm2 != sm1)
+      {
+        //Different SM, only if in the same phi position (0,1), (2,3), ...
+        Float_t smPhi1 = fEMCGeometry->GetPhiCenterOfSM(sm1);
+        Float_t smPhi2 = fEMCGeometry->GetPhiCenterOfSM(sm2);
+        if(!TMath::AreEqualAbs(smPhi1, smPhi2, 1e-3)) continue;
+        
+        // C side impair SM columns start at 48 
+        if(sm1%2) eta1   += AliEMCALGeoParams::fgkEMCALCols;
+        else      shift2  = AliEMCALGeoParams::fgkEMCALCols;
+      }
+      
+      for(Int_t k = 0; k < 4; k++)
+      {
+        Int_t phi2 = cellPhi[absId] + kDPhi[k];
+        Int_t eta2 = eta1 + kDEta[k] - shift2;
+        if(phi2 < 0 || phi2 >= nPhi || eta2 < 0 || eta2 >= nEta) continue;
+        
+        Int_t absId2 = grid[(sm2*nPhi + phi2)*nEta + eta2];
+        if(absId2 < 0) continue;
+        
+        if(n >= fCellNeighbours.GetSize())
+        {
+          fCellNeighbours      .Set(2*n);
+          fCellNeighbourOtherSM.Set(2*n);
+        }
+        fCellNeighbours      [n] = absId2;
+        fCellNeighbourOtherSM[n] = (sm2 != sm1);
+        n++;
+      }
+    }
+  }
+  
+  fCellNeighbourFirst[fNCells] = n;
+  fCellNeighbours      .Set(n);
+  fCellNeighbourOtherSM.Set(n);
+  
+  AliDebug(1,Form("Neighbour table of %d cells with %d entries",fNCells,n));
+}
+
 // Methods for AliEMCALRecPoint - Feb 19, 2006
 //________________________________________________________________________________________________
 Bool_t AliEMCALGeometry::RelPosCellInSModule(Int_t absId, Double_t &xr, Double_t &yr, Double_t &zr) const
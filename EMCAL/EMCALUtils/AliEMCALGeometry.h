@@ -92,7 +92,9 @@
 // --- ROOT system ---
 #include <TNamed.h>
 #include <TMath.h>
+#include <TArrayC.h>
 #include <TArrayD.h>
+#include <TArrayI.h>
 #include <TVector3.h>
 #include <TGeoMatrix.h> 
 class TBrowser ;
@@ -308,6 +310,10 @@ public:
 					      Int_t &iphim, Int_t &ietam, Int_t &nModule) const;
   Int_t   GetAbsCellIdFromCellIndexes(Int_t nSupMod, Int_t iphi, Int_t ieta) const;
 
+  // Cells with a common side, as in AliEMCALClusterizerv1::AreNeighbours,
+  // from a table built at first call; otherSM[i] is 1 for a neighbour in the other SM at eta=0
+  Int_t   GetCellNeighbours(Int_t absId, const Int_t *&neighbours, const Char_t *&otherSM) const;
+
   void    ShiftOnlineToOfflineCellIndexes(Int_t sm, Int_t & iphi, Int_t & ieta) const ;
   void    ShiftOfflineToOnlineCellIndexes(Int_t sm, Int_t & iphi, Int_t & ieta) const ;
   
@@ -487,6 +493,12 @@ protected:
 	
   TGeoHMatrix* fkSModuleMatrix[AliEMCALGeoParams::fgkEMCALModules] ; //Orientations of EMCAL super modules
   Bool_t   fUseExternalMatrices;      // Use the matrices set in fkSModuleMatrix and not those in the geoManager
+
+  void     BuildCellNeighbourTable() const;
+
+  mutable TArrayI fCellNeighbourFirst;   //! index in fCellNeighbours of the first neighbour of each cell; size fNCells+1
+  mutable TArrayI fCellNeighbours;       //! abs id of the neighbours of the cells, see GetCellNeighbours
+  mutable TArrayC fCellNeighbourOtherSM; //! 1 if the neighbour is in another SM, 0 otherwise
 	
 private:
   
@@ -37,7 +37,8 @@ class AliEMCALRecParam : public AliDetectorRecoParam
     kClusterizerv1  = 0,
     kClusterizerNxN = 1,
     kClusterizerv2  = 2,
-    kClusterizerFW  = 3
+    kClusterizerFW  = 3,
+    kClusterizerv1Fast = 4  // same clusters as v1, neighbour table of the geometry
   };
   
   AliEMCALRecParam() ;
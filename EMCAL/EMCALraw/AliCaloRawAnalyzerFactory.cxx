@@ -24,6 +24,7 @@
 #include "AliCaloRawAnalyzerPeakFinder.h"
 #include "AliCaloRawAnalyzerCrude.h"
 #include "AliCaloRawAnalyzerKStandard.h"
+#include "AliCaloRawAnalyzerKStandardFast.h"
 #include "AliCaloRawAnalyzerFakeALTRO.h"
 
 AliCaloRawAnalyzerFactory::AliCaloRawAnalyzerFactory()
@@ -53,6 +54,9 @@ AliCaloRawAnalyzerFactory::CreateAnalyzer( const int algo )
     case kStandard:
       return new AliCaloRawAnalyzerKStandard();
       break;
+    case kStandardFast:
+      return new AliCaloRawAnalyzerKStandardFast();
+      break;
     case kFakeAltro:
       return  new AliCaloRawAnalyzerFakeALTRO();
       break;
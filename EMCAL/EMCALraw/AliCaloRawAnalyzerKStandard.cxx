@@ -50,6 +50,13 @@ AliCaloRawAnalyzerKStandard::AliCaloRawAnalyzerKStandard() : AliCaloRawAnalyzerF
 }
 
 
+AliCaloRawAnalyzerKStandard::AliCaloRawAnalyzerKStandard( const char *name, const char *nameshort ) : AliCaloRawAnalyzerFitter(name, nameshort)
+{
+  // Constructor for the analyzers using the same selection with another fit
+  fAlgo = Algo::kStandard;
+}
+
+
 AliCaloRawAnalyzerKStandard::~AliCaloRawAnalyzerKStandard()
 {
   //  delete fTf1;
@@ -37,10 +37,14 @@ class  AliCaloRawAnalyzerKStandard : public AliCaloRawAnalyzerFitter
                                        UInt_t altrocfg1,
                                        UInt_t altrocfg2 );
   
-  void FitRaw( Int_t firstTimeBin, Int_t lastTimeBin,
-               Float_t & amp,  Float_t & time,
-               Float_t & chi2, Bool_t & fitDone) const ;
+  virtual void FitRaw( Int_t firstTimeBin, Int_t lastTimeBin,
+                       Float_t & amp,  Float_t & time,
+                       Float_t & chi2, Bool_t & fitDone) const ;
  
+ protected:
+  
+  AliCaloRawAnalyzerKStandard( const char *name, const char *nameshort );
+  
  private:
   
   AliCaloRawAnalyzerKStandard();
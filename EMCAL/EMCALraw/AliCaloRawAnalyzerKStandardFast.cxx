@@ -0,0 +1,162 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//
+// Extraction of amplitude and peak position
+// from CALO raw data, same as AliCaloRawAnalyzerKStandard
+// but with a faster minimization of the chi square:
+// the response function AliEMCALRawResponse::RawResponseFunction
+// (fixed tau and order) and its time derivative are tabulated once,
+// and the amplitude and peak time are obtained by Gauss-Newton
+// iterations on the linearized response, with the same limits
+// as the Minuit fit. No object is created per channel.
+//
+
+#include "AliCaloRawAnalyzerKStandardFast.h"
+#include "TMath.h"
+
+ClassImp( AliCaloRawAnalyzerKStandardFast )
+
+
+AliCaloRawAnalyzerKStandardFast::AliCaloRawAnalyzerKStandardFast() :
+  AliCaloRawAnalyzerKStandard("Chi Square ( kStandard, Gauss-Newton )", "KStandardFast"),
+  fTableMin(0),
+  fTableStep(0)
+{
+  // Constructor
+  fAlgo = Algo::kStandardFast;
+  SetShape(TAU, ORDER);
+}
+
+
+AliCaloRawAnalyzerKStandardFast::~AliCaloRawAnalyzerKStandardFast()
+{
+  // Destructor
+}
+
+
+void
+AliCaloRawAnalyzerKStandardFast::SetShape( Double_t tau, Double_t order )
+{
+  // Tabulate the response function of unit amplitude,
+  // x^n exp(n(1-x)) with x = (t - tpeak + tau)/tau,
+  // and its derivative with respect to t, from x = 0 to x = 16
+  // where it is below 1e-9 for n = 2; beyond, Shape returns 0
+
+  const Double_t kXMax = 16;
+
+  fTableMin  = -tau;
+  fTableStep = tau*kXMax/kNTable;
+
+  for (Int_t i = 0; i <= kNTable; i++)
+  {
+    Double_t x = i*fTableStep/tau;
+    Double_t e = TMath::Exp(order*(1 - x));
+    fShapeTable[i] = TMath::Power(x, order) * e;
+    fDerivTable[i] = order/tau * TMath::Power(x, order - 1) * (1 - x) * e;
+  }
+}
+
+
+void
+AliCaloRawAnalyzerKStandardFast::Shape( Double_t dt, Double_t & shape, Double_t & derivative ) const
+{
+  // Response function of unit amplitude and its derivative
+  // at dt time bins from the peak, by linear interpolation in the table
+
+  Double_t s = (dt - fTableMin)/fTableStep;
+
+  if (s <= 0 || s >= kNTable)
+  {
+    shape      = 0;
+    derivative = 0;
+    return;
+  }
+
+  Int_t    i = (Int_t) s;
+  Double_t f = s - i;
+  shape      = fShapeTable[i] + f*(fShapeTable[i+1] - fShapeTable[i]);
+  derivative = fDerivTable[i] + f*(fDerivTable[i+1] - fDerivTable[i]);
+}
+
+
+void
+AliCaloRawAnalyzerKStandardFast::FitRaw( Int_t firstTimeBin, Int_t lastTimeBin,
+                                         Float_t & amp, Float_t & time, Float_t & chi2, Bool_t & fitDone) const
+{
+  // Fits the raw signal time distribution, with the parameters and limits
+  // of AliCaloRawAnalyzerKStandard::FitRaw
+
+  int nsamples = lastTimeBin - firstTimeBin + 1;
+  fitDone = kFALSE;
+  if (nsamples < 3) { return; }
+
+  const Double_t ampMin  = 0.5*amp, ampMax  = 2*amp;
+  const Double_t timeMin = time - 4, timeMax = time + 4;
+
+  Double_t a  = amp;
+  Double_t t0 = time;
+  Double_t g = 0, d = 0;
+
+  for (Int_t iter = 0; iter < kNIterations; iter++)
+  {
+    // normal equations of the response linearized in a and t0,
+    // derivatives of the residual y - a g(t - t0): -g and a g'(t - t0)
+    Double_t sgg = 0, sgd = 0, sdd = 0, sgr = 0, sdr = 0;
+
+    for (Int_t timebin = firstTimeBin; timebin <= lastTimeBin; timebin++)
+    {
+      Shape(timebin - t0, g, d);
+      Double_t r = GetReversed(timebin) - a*g;
+      sgg += g*g;
+      sgd += g*d;
+      sdd += d*d;
+      sgr += g*r;
+      sdr += d*r;
+    }
+
+    // J^T J (da, dt0) = J^T r with J = (g, -a g')
+    Double_t m11 = sgg, m12 = -a*sgd, m22 = a*a*sdd;
+    Double_t v1  = sgr, v2  = -a*sdr;
+    Double_t det = m11*m22 - m12*m12;
+
+    if (det <= 0)
+    {
+      if (iter == 0) return; // no information on the time, stay with the estimates
+      break;
+    }
+
+    Double_t da  = ( m22*v1 - m12*v2)/det;
+    Double_t dt0 = (-m12*v1 + m11*v2)/det;
+
+    a  = TMath::Min(TMath::Max(a  + da,  ampMin),  ampMax);
+    t0 = TMath::Min(TMath::Max(t0 + dt0, timeMin), timeMax);
+
+    if (TMath::Abs(dt0) < 1e-4 && TMath::Abs(da) < 1e-5*TMath::Abs(a)) break;
+  }
+
+  Double_t sum = 0;
+  for (Int_t timebin = firstTimeBin; timebin <= lastTimeBin; timebin++)
+  {
+    Shape(timebin - t0, g, d);
+    Double_t r = GetReversed(timebin) - a*g;
+    sum += r*r; // equal errors on all points, as option 'W' of the Minuit fit
+  }
+
+  amp     = a;
+  time    = t0;
+  chi2    = sum;
+  fitDone = kTRUE;
+}
@@ -0,0 +1,61 @@
+#ifndef ALICALORAWANALYZERKSTANDARDFAST_H
+#define ALICALORAWANALYZERKSTANDARDFAST_H
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// Extraction of amplitude and peak position
+// from CALO raw data with the same selection
+// and chi square as AliCaloRawAnalyzerKStandard,
+// minimized by a few Gauss-Newton iterations
+// on a tabulated response function instead of
+// a TGraph fit with Minuit
+
+#include "AliCaloRawAnalyzerKStandard.h"
+
+class  AliCaloRawAnalyzerKStandardFast : public AliCaloRawAnalyzerKStandard
+{
+  friend class AliCaloRawAnalyzerFactory; // Factory for creation of raw analyzer (rule checker request)
+
+ public:
+
+  virtual ~AliCaloRawAnalyzerKStandardFast();
+
+  virtual void FitRaw( Int_t firstTimeBin, Int_t lastTimeBin,
+                       Float_t & amp,  Float_t & time,
+                       Float_t & chi2, Bool_t & fitDone) const ;
+
+  void SetShape( Double_t tau, Double_t order );
+
+  enum { kNTable = 4096,    // number of intervals of the response table
+         kNIterations = 8   // maximum number of Gauss-Newton iterations
+  };
+
+ private:
+
+  AliCaloRawAnalyzerKStandardFast();
+  AliCaloRawAnalyzerKStandardFast(               const AliCaloRawAnalyzerKStandardFast & );
+  AliCaloRawAnalyzerKStandardFast  & operator = (const AliCaloRawAnalyzerKStandardFast & );
+
+  void Shape( Double_t dt, Double_t & shape, Double_t & derivative ) const;
+
+  Double_t fTableMin;                  // time (in time bins) from the peak of the first table entry, i.e. -tau
+  Double_t fTableStep;                 // time bins between two table entries
+  Double_t fShapeTable[kNTable+1];     //! response function of unit amplitude versus time from the peak
+  Double_t fDerivTable[kNTable+1];     //! derivative of the response function with respect to time
+
+  ClassDef(AliCaloRawAnalyzerKStandardFast, 1)
+};
+
+#endif
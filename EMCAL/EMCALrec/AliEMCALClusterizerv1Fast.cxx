@@ -0,0 +1,201 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+//  Clusterization class. Same clusters as AliEMCALClusterizerv1 (collects
+//  neighbouring active cells, starting from the seeds in the order of the
+//  digits), but a cluster is grown by looking only at the digits in the cells
+//  neighbouring its digits, given by AliEMCALGeometry::GetCellNeighbours,
+//  instead of comparing each cluster digit to all remaining digits.
+//  The neighbours of a cluster digit are added in the order of the digits
+//  list, so that the rec points, including the order of their digits, are
+//  identical to the ones of v1.
+//
+
+// --- ROOT system ---
+#include <TMath.h>
+#include <TObjArray.h>
+#include <TClonesArray.h>
+
+// --- AliRoot header files ---
+#include "AliLog.h"
+#include "AliEMCALClusterizerv1Fast.h"
+#include "AliEMCALRecPoint.h"
+#include "AliEMCALDigit.h"
+#include "AliEMCALGeometry.h"
+
+ClassImp(AliEMCALClusterizerv1Fast)
+
+//____________________________________________________________________________
+AliEMCALClusterizerv1Fast::AliEMCALClusterizerv1Fast()
+  : AliEMCALClusterizerv1(),
+    fCellFirstDigit(), fNextDigit(), fDigitUsed(), fClusterDigits(), fCandidates()
+{
+  // ctor with the indication of the file where header Tree and digits Tree are stored
+}
+
+//____________________________________________________________________________
+AliEMCALClusterizerv1Fast::AliEMCALClusterizerv1Fast(AliEMCALGeometry* geometry)
+  : AliEMCALClusterizerv1(geometry),
+    fCellFirstDigit(), fNextDigit(), fDigitUsed(), fClusterDigits(), fCandidates()
+{
+  // ctor with the indication of the file where header Tree and digits Tree are stored
+  // use this contructor to avoid usage of Init() which uses runloader
+}
+
+//____________________________________________________________________________
+AliEMCALClusterizerv1Fast::AliEMCALClusterizerv1Fast(AliEMCALGeometry* geometry,
+                                                     AliEMCALCalibData * calib,
+                                                     AliEMCALCalibTime * calibt,
+                                                     AliCaloCalibPedestal * caloped)
+  : AliEMCALClusterizerv1(geometry, calib, calibt, caloped),
+    fCellFirstDigit(), fNextDigit(), fDigitUsed(), fClusterDigits(), fCandidates()
+{
+  // ctor, geometry and calibration are initialized elsewhere.
+}
+
+//____________________________________________________________________________
+AliEMCALClusterizerv1Fast::~AliEMCALClusterizerv1Fast()
+{
+  // dtor
+}
+
+//____________________________________________________________________________
+void AliEMCALClusterizerv1Fast::MakeClusters()
+{
+  // Steering method to construct the clusters stored in a list of Reconstructed Points
+  // A cluster is defined as a list of neighbour digits, see AliEMCALClusterizerv1::MakeClusters
+
+  if (fGeom==0) AliFatal("Did not get geometry from EMCALLoader");
+
+  fRecPoints->Delete();
+
+  // Set up TObjArray with pointers to digits to work on calibrated digits
+  TObjArray digitsC(fDigitsArr->GetEntriesFast());
+  AliEMCALDigit *digit = 0;
+  Float_t dEnergyCalibrated = 0.0, ehs = 0.0, time = 0.0;
+  TIter nextdigit(fDigitsArr);
+  while ( (digit = dynamic_cast<AliEMCALDigit *>(nextdigit())) ) { // calibrate and clean up digits
+    dEnergyCalibrated =  digit->GetAmplitude();
+    time              =  digit->GetTime();
+    Calibrate(dEnergyCalibrated,time,digit->GetId());
+    digit->SetCalibAmp(dEnergyCalibrated);
+    digit->SetTime(time);
+
+    if ( dEnergyCalibrated < fMinECut || time > fTimeMax || time < fTimeMin ){
+      continue;
+    }
+    else if (!fGeom->CheckAbsCellId(digit->GetId()))
+      continue;
+    else{
+      ehs += dEnergyCalibrated;
+      digitsC.AddLast(digit);
+    }
+  }
+
+  AliDebug(1,Form("MakeClusters: Number of digits %d  -> (e %f), ehs %f\n",
+                  fDigitsArr->GetEntries(),fMinECut,ehs));
+
+  // Map of the cells to the digits, several digits in a cell are chained in list order
+  Int_t nDigits = digitsC.GetEntriesFast();
+  Int_t nCells  = fGeom->GetNCells();
+
+  if (fCellFirstDigit.GetSize() != nCells) {
+    fCellFirstDigit.Set(nCells);
+    fCellFirstDigit.Reset(-1);
+  }
+  if (fNextDigit.GetSize() < nDigits) {
+    fNextDigit    .Set(nDigits);
+    fDigitUsed    .Set(nDigits);
+    fClusterDigits.Set(nDigits);
+    fCandidates   .Set(2*nDigits);
+  }
+
+  for (Int_t iDigit = nDigits-1; iDigit >= 0; iDigit--) {
+    Int_t absId = static_cast<AliEMCALDigit*>(digitsC.UncheckedAt(iDigit))->GetId();
+    fNextDigit[iDigit]     = fCellFirstDigit[absId];
+    fCellFirstDigit[absId] = iDigit;
+    fDigitUsed[iDigit]     = 0;
+  }
+
+  for (Int_t iSeed = 0; iSeed < nDigits; iSeed++) { // scan over the list of digitsC
+    if (fDigitUsed[iSeed]) continue;
+
+    digit = static_cast<AliEMCALDigit*>(digitsC.UncheckedAt(iSeed));
+    dEnergyCalibrated = digit->GetCalibAmp();
+    time              = digit->GetTime();
+    if ( !( dEnergyCalibrated > fECAClusteringThreshold ) ) continue;
+
+    // start a new Tower RecPoint
+    if(fNumberOfECAClusters >= fRecPoints->GetSize()) fRecPoints->Expand(2*fNumberOfECAClusters+1);
+
+    AliEMCALRecPoint *recPoint = new  AliEMCALRecPoint("");
+    fRecPoints->AddAt(recPoint, fNumberOfECAClusters);
+    fNumberOfECAClusters++;
+
+    recPoint->SetClusterType(AliVCluster::kEMCALClusterv1);
+    recPoint->AddDigit(*digit, digit->GetCalibAmp(), kFALSE);
+    fDigitUsed[iSeed] = 1;
+    Int_t nClusterDigits = 0;
+    fClusterDigits[nClusterDigits++] = iSeed;
+
+    AliDebug(1,Form("MakeClusters: OK id = %d, ene = %f , cell.th. = %f \n", digit->GetId(), dEnergyCalibrated, fECAClusteringThreshold));
+
+    // Grow cluster by finding neighbours
+    for (Int_t iClusterDigit = 0; iClusterDigit < nClusterDigits; iClusterDigit++) { // scan over digits in cluster
+      digit = static_cast<AliEMCALDigit*>(digitsC.UncheckedAt(fClusterDigits[iClusterDigit]));
+
+      const Int_t  *neighbours = 0;
+      const Char_t *otherSM    = 0;
+      Int_t nNeighbours = fGeom->GetCellNeighbours(digit->GetId(), neighbours, otherSM);
+
+      Int_t nCandidates = 0;
+      for (Int_t iNeighbour = 0; iNeighbour < nNeighbours; iNeighbour++) {
+        for (Int_t iDigitN = fCellFirstDigit[neighbours[iNeighbour]]; iDigitN >= 0; iDigitN = fNextDigit[iDigitN]) {
+          if (fDigitUsed[iDigitN]) continue;
+          //Do not add digits with too different time
+          AliEMCALDigit *digitN = static_cast<AliEMCALDigit*>(digitsC.UncheckedAt(iDigitN));
+          if (TMath::Abs(time - digitN->GetTime()) > fTimeCut ) continue;
+          fCandidates[nCandidates++] = 2*iDigitN + otherSM[iNeighbour];
+        }
+      }
+
+      // v1 adds the neighbours in the order of the list of digits
+      for (Int_t i = 1; i < nCandidates; i++) {
+        Int_t candidate = fCandidates[i];
+        Int_t j = i;
+        for ( ; j > 0 && fCandidates[j-1] > candidate; j--) fCandidates[j] = fCandidates[j-1];
+        fCandidates[j] = candidate;
+      }
+
+      for (Int_t i = 0; i < nCandidates; i++) {
+        Int_t  iDigitN = fCandidates[i]/2;
+        Bool_t shared  = fCandidates[i]%2; //cluster shared by 2 SuperModules?
+        AliEMCALDigit *digitN = static_cast<AliEMCALDigit*>(digitsC.UncheckedAt(iDigitN));
+        recPoint->AddDigit(*digitN, digitN->GetCalibAmp(), shared);
+        fDigitUsed[iDigitN] = 1;
+        fClusterDigits[nClusterDigits++] = iDigitN;
+      }
+    } // scan over digits already in cluster
+
+    AliDebug(2,Form("MakeClusters: %d digitd, energy %f \n", nClusterDigits, recPoint->GetEnergy()));
+  } // seeds
+
+  // Clear the map of the cells for the next event
+  for (Int_t iDigit = 0; iDigit < nDigits; iDigit++)
+    fCellFirstDigit[static_cast<AliEMCALDigit*>(digitsC.UncheckedAt(iDigit))->GetId()] = -1;
+
+  AliDebug(1,Form("total no of clusters %d from %d digits",fNumberOfECAClusters,fDigitsArr->GetEntriesFast()));
+}
@@ -0,0 +1,52 @@
+#ifndef ALIEMCALCLUSTERIZERV1FAST_H
+#define ALIEMCALCLUSTERIZERV1FAST_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//_________________________________________________________________________
+//  Same clusterization as AliEMCALClusterizerv1, with the clusters grown
+//  through the cell neighbour table of AliEMCALGeometry instead of testing
+//  all pairs of digits; the time is linear in the number of digits.
+//  The rec points are identical to the ones of v1.
+//
+
+// --- ROOT system ---
+#include <TArrayI.h>
+#include <TArrayC.h>
+
+// --- AliRoot header files ---
+#include "AliEMCALClusterizerv1.h"
+
+class AliEMCALClusterizerv1Fast : public AliEMCALClusterizerv1 {
+
+public:
+
+  AliEMCALClusterizerv1Fast() ;
+  AliEMCALClusterizerv1Fast(AliEMCALGeometry* geometry);
+  AliEMCALClusterizerv1Fast(AliEMCALGeometry* geometry, AliEMCALCalibData * calib,
+                            AliEMCALCalibTime * calibt, AliCaloCalibPedestal *pedestal);
+
+  virtual ~AliEMCALClusterizerv1Fast()  ;
+
+  virtual const char * Version() const { return "clu-v1fast" ; }
+
+protected:
+
+  virtual void   MakeClusters();
+
+  TArrayI  fCellFirstDigit;  //! first digit (index in list of calibrated digits) of each cell, -1 if none
+  TArrayI  fNextDigit;       //! next digit of the same cell, -1 if none
+  TArrayC  fDigitUsed;       //! 1 if the digit is already in a cluster
+  TArrayI  fClusterDigits;   //! digits of the current cluster, in the order they were added
+  TArrayI  fCandidates;      //! 2*digit+shared for the neighbours of a cluster digit
+
+private:
+  AliEMCALClusterizerv1Fast(const AliEMCALClusterizerv1Fast &); //copy ctor
+  AliEMCALClusterizerv1Fast & operator = (const AliEMCALClusterizerv1Fast &);
+
+  ClassDef(AliEMCALClusterizerv1Fast,1)   // Clusterizer v1 with cell neighbour table
+
+};
+
+#endif // ALIEMCALCLUSTERIZERV1FAST_H
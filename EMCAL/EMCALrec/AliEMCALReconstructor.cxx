@@ -35,6 +35,7 @@
 #include "AliEMCALRawUtils.h"
 #include "AliEMCALDigit.h"
 #include "AliEMCALClusterizerv1.h"
+#include "AliEMCALClusterizerv1Fast.h"
 #include "AliEMCALClusterizerv2.h"
 #include "AliEMCALClusterizerNxN.h"
 #include "AliEMCALRecPoint.h"
@@ -256,6 +257,8 @@ void AliEMCALReconstructor::InitClusterizer() const
       
       else if(clusterizerType == AliEMCALRecParam::kClusterizerv2  && !strcmp(fgClusterizer->Version(),"clu-v2"))  return;
       
+      else if(clusterizerType == AliEMCALRecParam::kClusterizerv1Fast && !strcmp(fgClusterizer->Version(),"clu-v1fast")) return;
+      
       //Need to create new clusterizer, the one set previously is not the correct one     
       delete fgClusterizer;
     }
@@ -274,6 +277,10 @@ void AliEMCALReconstructor::InitClusterizer() const
   {
     fgClusterizer = new AliEMCALClusterizerv2   (fGeom, fCalibData,fCalibTime,fPedestalData);
   }
+  else if (clusterizerType  == AliEMCALRecParam::kClusterizerv1Fast)
+  {
+    fgClusterizer = new AliEMCALClusterizerv1Fast(fGeom, fCalibData,fCalibTime,fPedestalData);
+  }
   else 
   {
     AliFatal(Form("Unknown clusterizer %d ", clusterizerType));
@@ -5,6 +5,7 @@
 #pragma link C++ class AliEMCALReconstructor+;
 #pragma link C++ class AliEMCALClusterizer+;
 #pragma link C++ class AliEMCALClusterizerv1+;
+#pragma link C++ class AliEMCALClusterizerv1Fast+;
 #pragma link C++ class AliEMCALClusterizerv2+;
 #pragma link C++ class AliEMCALClusterizerFixedWindow+;
 #pragma link C++ class AliEMCALClusterizerNxN+;
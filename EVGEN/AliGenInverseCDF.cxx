@@ -0,0 +1,244 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+// Tabulated inverse cumulative distribution of a function.
+// The function is evaluated once at the edges of nbins equidistant bins
+// and taken as linear inside each bin. A random number u is mapped to
+// the bin containing the quantile u through a guide table (Chen & Asau),
+// which needs on average less than two comparisons, and then inside the
+// bin by inverting the cumulative distribution of the linear function.
+// Sampling does not depend on the number of bins and does not evaluate
+// the function any more.
+// For 2D tables y is drawn from the marginal distribution and x from the
+// conditional distribution of the y bin, i.e. two look-ups per pair.
+
+#include <TF1.h>
+#include <TF2.h>
+#include <TMath.h>
+
+#include "AliLog.h"
+#include "AliGenInverseCDF.h"
+
+ClassImp(AliGenInverseCDF)
+
+//____________________________________________________________
+AliGenInverseCDF::AliGenInverseCDF():
+  TObject(),
+  fNx(0),
+  fNy(0),
+  fXmin(0.),
+  fXmax(0.),
+  fYmin(0.),
+  fYmax(0.),
+  fF(),
+  fCDF(),
+  fGuide(),
+  fFY(),
+  fCDFY(),
+  fGuideY()
+{
+  // Default constructor
+}
+
+//____________________________________________________________
+Bool_t AliGenInverseCDF::Build(TF1* f, Int_t nbins)
+{
+  // 1D table of f in its range
+  if (!f || nbins <= 0) return kFALSE;
+  fNx   = nbins;
+  fNy   = 0;
+  fXmin = f->GetXmin();
+  fXmax = f->GetXmax();
+  TArrayD values(nbins + 1);
+  const Double_t dx = (fXmax - fXmin) / nbins;
+  for (Int_t i = 0; i <= nbins; i++) values[i] = f->Eval(fXmin + i * dx);
+  return BuildGrid(values);
+}
+
+//____________________________________________________________
+Bool_t AliGenInverseCDF::Build(TF2* f, Int_t nbinsx, Int_t nbinsy)
+{
+  // 2D table of f in its range
+  if (!f || nbinsx <= 0 || nbinsy <= 0) return kFALSE;
+  fNx   = nbinsx;
+  fNy   = nbinsy;
+  fXmin = f->GetXmin();
+  fXmax = f->GetXmax();
+  fYmin = f->GetYmin();
+  fYmax = f->GetYmax();
+  TArrayD values((nbinsx + 1) * (nbinsy + 1));
+  const Double_t dx = (fXmax - fXmin) / nbinsx;
+  const Double_t dy = (fYmax - fYmin) / nbinsy;
+  for (Int_t j = 0; j <= nbinsy; j++)
+    for (Int_t i = 0; i <= nbinsx; i++)
+      values[j * (nbinsx + 1) + i] = f->Eval(fXmin + i * dx, fYmin + j * dy);
+  return BuildGrid(values);
+}
+
+//____________________________________________________________
+Bool_t AliGenInverseCDF::Build(TF1* fx, Int_t nbinsx, TF1* fy, Int_t nbinsy)
+{
+  // 2D table of the product fx(x)*fy(y)
+  if (!fx || !fy || nbinsx <= 0 || nbinsy <= 0) return kFALSE;
+  fNx   = nbinsx;
+  fNy   = nbinsy;
+  fXmin = fx->GetXmin();
+  fXmax = fx->GetXmax();
+  fYmin = fy->GetXmin();
+  fYmax = fy->GetXmax();
+  TArrayD vx(nbinsx + 1);
+  const Double_t dx = (fXmax - fXmin) / nbinsx;
+  const Double_t dy = (fYmax - fYmin) / nbinsy;
+  for (Int_t i = 0; i <= nbinsx; i++) vx[i] = fx->Eval(fXmin + i * dx);
+  TArrayD values((nbinsx + 1) * (nbinsy + 1));
+  for (Int_t j = 0; j <= nbinsy; j++) {
+    Double_t vy = fy->Eval(fYmin + j * dy);
+    for (Int_t i = 0; i <= nbinsx; i++) values[j * (nbinsx + 1) + i] = vx[i] * vy;
+  }
+  return BuildGrid(values);
+}
+
+//____________________________________________________________
+Bool_t AliGenInverseCDF::BuildGrid(const TArrayD& values)
+{
+  // Cumulative distributions and guide tables from the function values
+  // at the grid points, negative values are set to 0
+  Int_t nNegative = 0;
+  const Int_t nxe = fNx + 1;
+
+  if (fNy == 0) {
+    fF.Set(nxe);
+    for (Int_t i = 0; i < nxe; i++) {
+      fF[i] = values[i];
+      if (fF[i] < 0.) { fF[i] = 0.; nNegative++; }
+    }
+  } else {
+    // conditional distributions in x: average of the two edges of the y bin
+    fF.Set(nxe * fNy);
+    fFY.Set(fNy + 1);
+    for (Int_t j = 0; j <= fNy; j++) {
+      Double_t sum = 0.;
+      for (Int_t i = 0; i < nxe; i++) {
+        Double_t v = TMath::Max(values[j * nxe + i], 0.);
+        if (values[j * nxe + i] < 0.) nNegative++;
+        sum += (i == 0 || i == fNx) ? 0.5 * v : v;
+        if (j < fNy) fF[j * nxe + i] = 0.5 * v;
+        if (j > 0)   fF[(j - 1) * nxe + i] += 0.5 * v;
+      }
+      fFY[j] = sum;
+    }
+  }
+  if (nNegative) AliWarning(Form("%d negative function values set to 0", nNegative));
+
+  const Int_t nRows = (fNy == 0) ? 1 : fNy;
+  fCDF.Set(nxe * nRows);
+  fGuide.Set(fNx * nRows);
+  Bool_t ok = kTRUE;
+  for (Int_t j = 0; j < nRows; j++) {
+    if (!MakeCDF(fF.GetArray() + j * nxe, fNx, fCDF.GetArray() + j * nxe, fGuide.GetArray() + j * fNx)) {
+      // empty rows are never selected through the marginal distribution
+      if (fNy == 0) ok = kFALSE;
+    }
+  }
+  if (fNy > 0) {
+    fCDFY.Set(fNy + 1);
+    fGuideY.Set(fNy);
+    ok = MakeCDF(fFY.GetArray(), fNy, fCDFY.GetArray(), fGuideY.GetArray());
+  }
+  if (!ok) {
+    AliError("Function is 0 in the whole range, no table built");
+    fNx = fNy = 0;
+  }
+  return ok;
+}
+
+//____________________________________________________________
+Bool_t AliGenInverseCDF::MakeCDF(const Double_t* f, Int_t n, Double_t* cdf, Int_t* guide)
+{
+  // Normalised cumulative distribution of the piecewise linear function f
+  // given at the n+1 bin edges, and its guide table: guide[k] is the first
+  // bin whose upper edge lies above the quantile k/n
+  cdf[0] = 0.;
+  for (Int_t i = 0; i < n; i++) cdf[i + 1] = cdf[i] + 0.5 * (f[i] + f[i + 1]);
+  const Double_t total = cdf[n];
+  if (total <= 0.) {
+    for (Int_t i = 0; i <= n; i++) cdf[i] = Double_t(i) / n;
+    for (Int_t k = 0; k < n; k++) guide[k] = k;
+    return kFALSE;
+  }
+  for (Int_t i = 1; i < n; i++) cdf[i] /= total;
+  cdf[n] = 1.;
+
+  Int_t i = 0;
+  for (Int_t k = 0; k < n; k++) {
+    Double_t q = Double_t(k) / n;
+    while (i < n - 1 && cdf[i + 1] <= q) i++;
+    guide[k] = i;
+  }
+  return kTRUE;
+}
+
+//____________________________________________________________
+Int_t AliGenInverseCDF::FindBin(const Double_t* cdf, const Int_t* guide, Int_t n, Double_t u)
+{
+  // Bin containing the quantile u
+  Int_t k = Int_t(u * n);
+  if (k >= n) k = n - 1;
+  if (k < 0)  k = 0;
+  Int_t i = guide[k];
+  while (i < n - 1 && cdf[i + 1] <= u) i++;
+  return i;
+}
+
+//____________________________________________________________
+Double_t AliGenInverseCDF::InBin(Double_t f0, Double_t f1, Double_t r)
+{
+  // Position in [0,1] of the quantile r of the linear function going
+  // from f0 to f1 over the bin, written without dividing by f1-f0
+  Double_t denom = f0 + TMath::Sqrt(f0 * f0 + (f1 * f1 - f0 * f0) * r);
+  if (denom <= 0.) return r;
+  return r * (f0 + f1) / denom;
+}
+
+//____________________________________________________________
+Double_t AliGenInverseCDF::Sample(Double_t u) const
+{
+  // x for the quantile u of a 1D table
+  const Int_t i = FindBin(fCDF.GetArray(), fGuide.GetArray(), fNx, u);
+  const Double_t w = fCDF[i + 1] - fCDF[i];
+  const Double_t r = (w > 0.) ? (u - fCDF[i]) / w : 0.5;
+  return fXmin + (i + InBin(fF[i], fF[i + 1], TMath::Min(TMath::Max(r, 0.), 1.))) * (fXmax - fXmin) / fNx;
+}
+
+//____________________________________________________________
+void AliGenInverseCDF::Sample(Double_t u1, Double_t u2, Double_t& x, Double_t& y) const
+{
+  // (x,y) of a 2D table: y for the quantile u1 of the marginal distribution,
+  // x for the quantile u2 of the distribution in the selected y bin
+  const Int_t j = FindBin(fCDFY.GetArray(), fGuideY.GetArray(), fNy, u1);
+  Double_t w = fCDFY[j + 1] - fCDFY[j];
+  Double_t r = (w > 0.) ? (u1 - fCDFY[j]) / w : 0.5;
+  y = fYmin + (j + InBin(fFY[j], fFY[j + 1], TMath::Min(TMath::Max(r, 0.), 1.))) * (fYmax - fYmin) / fNy;
+
+  const Int_t nxe = fNx + 1;
+  const Double_t* cdf = fCDF.GetArray() + j * nxe;
+  const Double_t* f = fF.GetArray() + j * nxe;
+  const Int_t i = FindBin(cdf, fGuide.GetArray() + j * fNx, fNx, u2);
+  w = cdf[i + 1] - cdf[i];
+  r = (w > 0.) ? (u2 - cdf[i]) / w : 0.5;
+  x = fXmin + (i + InBin(f[i], f[i + 1], TMath::Min(TMath::Max(r, 0.), 1.))) * (fXmax - fXmin) / fNx;
+}
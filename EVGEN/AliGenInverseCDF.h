@@ -0,0 +1,61 @@
+#ifndef ALIGENINVERSECDF_H
+#define ALIGENINVERSECDF_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//
+// Tabulated inverse cumulative distribution of a 1D or 2D function
+// for O(1) sampling, used by AliGenParam instead of TF1::GetRandom
+//
+
+#include <TObject.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
+
+class TF1;
+class TF2;
+
+class AliGenInverseCDF : public TObject
+{
+ public:
+  AliGenInverseCDF();
+  virtual ~AliGenInverseCDF() {}
+
+  Bool_t   Build(TF1* f, Int_t nbins);
+  Bool_t   Build(TF2* f, Int_t nbinsx, Int_t nbinsy);
+  Bool_t   Build(TF1* fx, Int_t nbinsx, TF1* fy, Int_t nbinsy);
+
+  Double_t Sample(Double_t u) const;
+  void     Sample(Double_t u1, Double_t u2, Double_t& x, Double_t& y) const;
+
+  Bool_t   IsBuilt()     const {return fNx > 0;}
+  Bool_t   Is2D()        const {return fNy > 0;}
+  Int_t    GetNbinsX()   const {return fNx;}
+  Int_t    GetNbinsY()   const {return fNy;}
+  Double_t GetXmin()     const {return fXmin;}
+  Double_t GetXmax()     const {return fXmax;}
+  Double_t GetYmin()     const {return fYmin;}
+  Double_t GetYmax()     const {return fYmax;}
+
+ private:
+  Bool_t   BuildGrid(const TArrayD& values);
+  static Bool_t MakeCDF(const Double_t* f, Int_t n, Double_t* cdf, Int_t* guide);
+  static Int_t  FindBin(const Double_t* cdf, const Int_t* guide, Int_t n, Double_t u);
+  static Double_t InBin(Double_t f0, Double_t f1, Double_t r);
+
+  Int_t    fNx;       // number of bins in x
+  Int_t    fNy;       // number of bins in y, 0 for 1D tables
+  Double_t fXmin;     // lower edge in x
+  Double_t fXmax;     // upper edge in x
+  Double_t fYmin;     // lower edge in y
+  Double_t fYmax;     // upper edge in y
+  TArrayD  fF;        // function at the bin edges in x, per bin in y for 2D
+  TArrayD  fCDF;      // cumulative distribution at the bin edges in x, per bin in y for 2D
+  TArrayI  fGuide;    // first bin for each of the fNx equal steps of the cumulative distribution
+  TArrayD  fFY;       // marginal distribution at the bin edges in y
+  TArrayD  fCDFY;     // cumulative marginal distribution at the bin edges in y
+  TArrayI  fGuideY;   // guide table of the marginal distribution
+
+  ClassDef(AliGenInverseCDF, 1) // inverse cumulative distribution table
+};
+#endif
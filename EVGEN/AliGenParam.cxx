@@ -25,6 +25,7 @@
 #include <TClonesArray.h>
 #include <TDatabasePDG.h>
 #include <TF1.h>
+#include <TF2.h>
 #include <TH1F.h>
 #include <TLorentzVector.h>
 #include <TMath.h>
@@ -34,8 +35,10 @@
 #include <TVirtualMC.h>
 
 #include "AliDecayer.h"
+#include "AliGenInverseCDF.h"
 #include "AliGenMUONlib.h"
 #include "AliGenParam.h"
+#include "AliLog.h"
 #include "AliMC.h"
 #include "AliRun.h"
 #include "AliGenEventHeader.h"
@@ -56,6 +59,7 @@ AliGenParam::AliGenParam()
   fYParaFunc(0),
   fIpParaFunc(0),
   fV2ParaFunc(0),
+  fPtYParaFunc(0),
   fPtPara(0),
   fYPara(0),
   fV2Para(0),
@@ -72,7 +76,14 @@ AliGenParam::AliGenParam()
   fForceConv(kFALSE),
   fKeepParent(kFALSE),
   fKeepIfOneChildSelected(kFALSE),
-  fPreserveFullDecayChain(kFALSE)
+  fPreserveFullDecayChain(kFALSE),
+  fUseTables(kFALSE),
+  fJointPtY(kFALSE),
+  fNTableBinsY(1000),
+  fPtTable(0),
+  fYTable(0),
+  fPtYTable(0),
+  fMassTables()
 {
   // Default constructor
 }
@@ -83,6 +94,7 @@ AliGenParam::AliGenParam(Int_t npart, const AliGenLib * Library,  Int_t param, c
    fYParaFunc (Library->GetY (param, tname)),
    fIpParaFunc(Library->GetIp(param, tname)),
    fV2ParaFunc(Library->GetV2(param, tname)),
+   fPtYParaFunc(0),
    fPtPara(0),
    fYPara(0),
    fV2Para(0),
@@ -99,7 +111,14 @@ AliGenParam::AliGenParam(Int_t npart, const AliGenLib * Library,  Int_t param, c
    fForceConv(kFALSE),
    fKeepParent(kFALSE),
    fKeepIfOneChildSelected(kFALSE),
-   fPreserveFullDecayChain(kFALSE)
+   fPreserveFullDecayChain(kFALSE),
+   fUseTables(kFALSE),
+   fJointPtY(kFALSE),
+   fNTableBinsY(1000),
+   fPtTable(0),
+   fYTable(0),
+   fPtYTable(0),
+   fMassTables()
 {
   // Constructor using number of particles parameterisation id and library
   fName     = "Param";
@@ -114,6 +133,7 @@ AliGenParam::AliGenParam(Int_t npart, Int_t param, const char* tname, const char
   fYParaFunc (0),
   fIpParaFunc(0),
   fV2ParaFunc(0),
+  fPtYParaFunc(0),
   fPtPara(0),
   fYPara(0),
   fV2Para(0),
@@ -130,7 +150,14 @@ AliGenParam::AliGenParam(Int_t npart, Int_t param, const char* tname, const char
   fForceConv(kFALSE),
   fKeepParent(kFALSE),
   fKeepIfOneChildSelected(kFALSE),
-  fPreserveFullDecayChain(kFALSE)
+  fPreserveFullDecayChain(kFALSE),
+  fUseTables(kFALSE),
+  fJointPtY(kFALSE),
+  fNTableBinsY(1000),
+  fPtTable(0),
+  fYTable(0),
+  fPtYTable(0),
+  fMassTables()
 {
   // Constructor using parameterisation id and number of particles
   //
@@ -166,6 +193,7 @@ AliGenParam::AliGenParam(Int_t npart, Int_t param,
    fYParaFunc(YPara),
    fIpParaFunc(IpPara),
    fV2ParaFunc(V2Para),
+   fPtYParaFunc(0),
    fPtPara(0),
    fYPara(0),
    fV2Para(0),
@@ -181,7 +209,15 @@ AliGenParam::AliGenParam(Int_t npart, Int_t param,
    fDecayer(0),
    fForceConv(kFALSE),
    fKeepParent(kFALSE),
-   fKeepIfOneChildSelected(kFALSE)
+   fKeepIfOneChildSelected(kFALSE),
+   fPreserveFullDecayChain(kFALSE),
+   fUseTables(kFALSE),
+   fJointPtY(kFALSE),
+   fNTableBinsY(1000),
+   fPtTable(0),
+   fYTable(0),
+   fPtYTable(0),
+   fMassTables()
 {
   // Constructor
   // Gines Martinez 1/10/99
@@ -207,6 +243,7 @@ AliGenParam::~AliGenParam()
   delete  fYPara;
   delete  fV2Para;
   delete  fdNdPhi;
+  DeleteTables();
 }
 
 //-------------------------------------------------------------------
@@ -507,6 +544,10 @@ void AliGenParam::Init()
     fParentWeight = fYWgt*fPtWgt*phiWgt/fNpart;
   }
   //
+  // sampling tables
+  DeleteTables();
+  if (fUseTables) BuildTables();
+  //
   // particle decay related initialization
   fDecayer->SetForceDecay(fForceDecay);
   fDecayer->Init();
@@ -515,6 +556,81 @@ void AliGenParam::Init()
   AliGenMC::Init();
 }
 
+//____________________________________________________________
+void AliGenParam::BuildTables()
+{
+  // Inverse-CDF tables of the pt and y parameterisations, with the same
+  // pt binning as the TF1 representation (fDeltaPt), or a joint (pt,y)
+  // table. With weighting kNonAnalog pt is sampled flat and only y is
+  // tabulated. The tables of the Breit-Wigner masses are built on demand.
+  Int_t npt = TMath::Max(Int_t((fPtMax - fPtMin) / fDeltaPt), 1);
+  if (fJointPtY && fAnalog != kAnalog) {
+    AliWarning("Joint (pt,y) table requires analog weighting, using separate tables");
+    fJointPtY = kFALSE;
+  }
+  if (fJointPtY) {
+    fPtYTable = new AliGenInverseCDF();
+    Bool_t ok;
+    if (fPtYParaFunc) {
+      TF2 ptyPara(Form("pt-y-for-%s", GetName()), fPtYParaFunc, fPtMin, fPtMax, fYMin, fYMax, 0);
+      ok = fPtYTable->Build(&ptyPara, npt, fNTableBinsY);
+    } else {
+      ok = fPtYTable->Build(fPtPara, npt, fYPara, fNTableBinsY);
+    }
+    if (!ok) AliFatal("Cannot build the (pt,y) table");
+  } else {
+    if (fPtYParaFunc) AliWarning("Joint (pt,y) parameterisation ignored without joint table");
+    fYTable = new AliGenInverseCDF();
+    if (!fYTable->Build(fYPara, fNTableBinsY)) AliFatal("Cannot build the y table");
+    if (fAnalog == kAnalog) {
+      fPtTable = new AliGenInverseCDF();
+      if (!fPtTable->Build(fPtPara, npt)) AliFatal("Cannot build the pt table");
+    }
+  }
+}
+
+//____________________________________________________________
+void AliGenParam::DeleteTables()
+{
+  // Delete all sampling tables
+  delete fPtTable;
+  delete fYTable;
+  delete fPtYTable;
+  fPtTable = fYTable = fPtYTable = 0;
+  for (std::map<Int_t, AliGenInverseCDF*>::iterator it = fMassTables.begin(); it != fMassTables.end(); ++it)
+    delete it->second;
+  fMassTables.clear();
+}
+
+//____________________________________________________________
+Double_t AliGenParam::SampleMass(Int_t pdg, Double_t mass, Double_t width)
+{
+  // Breit-Wigner mass from a table per particle type, same function and
+  // range as the TF1 used without tables
+  AliGenInverseCDF*& table = fMassTables[pdg];
+  if (!table) {
+    TF1 rbw("rbw","pow([1],2)*pow([0],2)/(pow(x*x-[0]*[0],2)+pow(x*x*[1]/[0],2))",mass-5*width,mass+5*width);
+    rbw.SetParameter(0,mass);
+    rbw.SetParameter(1,width);
+    table = new AliGenInverseCDF();
+    table->Build(&rbw, 1000);
+  }
+  return table->Sample(fRandom->Rndm());
+}
+
+//____________________________________________________________
+Double_t AliGenParam::SamplePhi(Double_t v2)
+{
+  // Phi from 1+2*v2*cos(2(phi-psi)) by rejection, this avoids the
+  // re-integration of fdNdPhi each time v2 changes
+  Double_t fmax = 1. + 2. * TMath::Abs(v2);
+  Double_t phi;
+  do {
+    phi = fPhiMin + (fPhiMax - fPhiMin) * fRandom->Rndm();
+  } while (fmax * fRandom->Rndm() > 1. + 2. * v2 * TMath::Cos(2. * (phi - fEvPlane)));
+  return phi;
+}
+
 //____________________________________________________________
 void AliGenParam::Generate()
 {
@@ -594,7 +710,9 @@ void AliGenParam::GenerateN(Int_t ntimes)
 
       // --- For Exodus -------------------------------
       Double_t awidth = particle->Width();
-      if(awidth>0){
+      if(awidth>0 && fUseTables){
+        am = SampleMass(iPart, am, awidth);
+      } else if(awidth>0){
         TF1 rbw("rbw","pow([1],2)*pow([0],2)/(pow(x*x-[0]*[0],2)+pow(x*x*[1]/[0],2))",am-5*awidth,am+5*awidth);
         rbw.SetParameter(0,am);
         rbw.SetParameter(1,awidth);
@@ -604,12 +722,17 @@ void AliGenParam::GenerateN(Int_t ntimes)
 
       //
       // y
-      ty = TMath::TanH(fYPara->GetRandom());
+      Double_t yGen = 0.;
+      if (fPtYTable) fPtYTable->Sample(fRandom->Rndm(), fRandom->Rndm(), pt, yGen);
+      else if (fYTable) yGen = fYTable->Sample(fRandom->Rndm());
+      else yGen = fYPara->GetRandom();
+      ty = TMath::TanH(yGen);
 
       //
       // pT
       if (fAnalog == kAnalog) {
-        pt=fPtPara->GetRandom();
+        if (fPtTable) pt = fPtTable->Sample(fRandom->Rndm());
+        else if (!fPtYTable) pt = fPtPara->GetRandom();
         wgtp=fParentWeight;
         wgtch=fChildWeight;
       } else {
@@ -630,9 +753,13 @@ void AliGenParam::GenerateN(Int_t ntimes)
       //phi=fEvPlane; //align first particle of each event with event plane
       //else{
       double v2 = fV2Para->Eval(pt);
-      fdNdPhi->SetParameter(0,v2);
-      fdNdPhi->SetParameter(1,fEvPlane);
-      phi=fdNdPhi->GetRandom();
+      if (fUseTables) {
+        phi=SamplePhi(v2);
+      } else {
+        fdNdPhi->SetParameter(0,v2);
+        fdNdPhi->SetParameter(1,fEvPlane);
+        phi=fdNdPhi->GetRandom();
+      }
       //     }
 
       pl=xmt*ty/sqrt((1.-ty)*(1.+ty));
@@ -13,11 +13,13 @@
 // andreas.morsch@cern.ch
 //
 
+#include <map>
 #include "AliGenMC.h"
 
 class AliPythia;
 class TParticle;
 class AliGenLib;
+class AliGenInverseCDF;
 class TF1;
 
 typedef enum { kAnalog, kNonAnalog} Weighting_t;
@@ -50,11 +52,20 @@ public:
   virtual void SetKeepParent(Bool_t keep=kTRUE){fKeepParent= keep;} //Store parent even if it does not have childs within cuts
   virtual void SetKeepIfOneChildSelected(Bool_t keep=kTRUE){fKeepIfOneChildSelected = keep;} //Accept parent and child even if other children are not within cut.
   virtual void SetPreserveFullDecayChain(Int_t preserve = kFALSE) {fPreserveFullDecayChain = preserve;} //Prevent flagging(/skipping) of decay daughter particles; preserves complete forced decay chain
+  // sample pt, y, phi and resonance masses from tables built in Init instead of TF1::GetRandom
+  virtual void SetSamplingTables(Bool_t tables = kTRUE, Bool_t jointPtY = kFALSE, Int_t nbinsY = 1000)
+    {fUseTables = tables; fJointPtY = jointPtY; fNTableBinsY = nbinsY;}
+  // joint (pt,y) parameterisation, x[0] = pt, x[1] = y, sampled from a 2D table
+  void SetPtYParametrisation(Double_t (*PtYPara)(const Double_t*, const Double_t*))
+    {fPtYParaFunc = PtYPara; fUseTables = kTRUE; fJointPtY = kTRUE;}
 
   virtual void Draw(const char * opt);
   TF1 *  GetPt() { return fPtPara;}
   TF1 *  GetY() {return fYPara;}
   Float_t GetRelativeArea(Float_t ptMin, Float_t ptMax, Float_t yMin, Float_t yMax, Float_t phiMin, Float_t phiMax);
+  const AliGenInverseCDF* GetPtTable()  const {return fPtTable;}
+  const AliGenInverseCDF* GetYTable()   const {return fYTable;}
+  const AliGenInverseCDF* GetPtYTable() const {return fPtYTable;}
 
   static TVector3 OrthogonalVector(TVector3 &inVec);
   static void RotateVector( Double_t *pin, Double_t *pout, Double_t costheta, Double_t sintheta,
@@ -84,6 +95,7 @@ protected:
   Double_t (*fYParaFunc )(const Double_t*, const Double_t*); //! Pointer to Y parametrisation function
   Int_t    (*fIpParaFunc )(TRandom*);    //! Pointer to particle type parametrisation function
   Double_t (*fV2ParaFunc )(const Double_t*, const Double_t*);//! Pointer to V2 parametrisation function
+  Double_t (*fPtYParaFunc)(const Double_t*, const Double_t*);//! Pointer to joint pt-y parametrisation function
   TF1* fPtPara;              // Transverse momentum parameterisation
   TF1* fYPara;               // Rapidity parameterisation
   TF1*        fV2Para;       // v2 parametrization
@@ -101,11 +113,23 @@ protected:
   Bool_t      fKeepParent;   //  Store parent even if it does not have childs within cuts
   Bool_t      fKeepIfOneChildSelected; //Accept parent and child even if other children are not within cut.
   Bool_t      fPreserveFullDecayChain; //Prevent flagging(/skipping) of decay daughter particles; preserves complete forced decay chain
+  Bool_t      fUseTables;    // Sample from inverse-CDF tables instead of TF1::GetRandom
+  Bool_t      fJointPtY;     // Sample pt and y from one 2D table
+  Int_t       fNTableBinsY;  // Number of y bins of the tables
+  AliGenInverseCDF* fPtTable;   //! pt table
+  AliGenInverseCDF* fYTable;    //! y table
+  AliGenInverseCDF* fPtYTable;  //! joint (pt,y) table
+  std::map<Int_t, AliGenInverseCDF*> fMassTables; //! Breit-Wigner mass tables per particle type
 
 private:
   AliGenParam(const AliGenParam &Param);
   AliGenParam & operator=(const AliGenParam & rhs);
 
-  ClassDef(AliGenParam, 4) // Generator using parameterised pt- and y-distribution
+  void     BuildTables();
+  void     DeleteTables();
+  Double_t SampleMass(Int_t pdg, Double_t mass, Double_t width);
+  Double_t SamplePhi(Double_t v2);
+
+  ClassDef(AliGenParam, 5) // Generator using parameterised pt- and y-distribution
 };
 #endif
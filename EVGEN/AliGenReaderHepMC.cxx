@@ -1,6 +1,33 @@
+// Reader for HepMC files, used with AliGenExtFile.
+//
+// Files compressed with gzip, bzip2 or xz are recognised by their magic
+// bytes and read through a pipe of the decompressor.
+//
+// With SetPrefetchDepth(n) the file is read and decoded on a background
+// thread which keeps up to n decoded events (particle arrays and headers)
+// in a bounded queue, so that the transport does not wait for the text
+// parsing. The particle arrays of the queue are allocated once and
+// swapped with the array of the current event, no copy is made.
+// The parse throughput is printed at the end of the file, or on request
+// with PrintStatistics().
+//
+//  AliGenReaderHepMC *reader = new AliGenReaderHepMC();
+//  reader->SetFileName("events.hepmc.gz");
+//  reader->SetPrefetchDepth(10);
+//  gener->SetReader(reader);
+
+
+#include <streambuf>
+#include <istream>
+
 #include <TVirtualMC.h>
 #include <TDatabasePDG.h>
 #include <TParticle.h>
+#include <TSystem.h>
+#include <TStopwatch.h>
+#include <TThread.h>
+#include <TMutex.h>
+#include <TCondition.h>
 
 #include "AliLog.h"
 #include "AliGenReaderHepMC.h"
@@ -12,12 +39,37 @@
 #include "HepMC/GenEvent.h"
 #include "HepMC/IO_GenEvent.h"
 
+namespace {
+   // Input stream buffer on the output of a decompressor
+   class PipeBuffer : public std::streambuf
+   {
+   public:
+      explicit PipeBuffer(FILE * pipe) : fPipe(pipe) {}
+   protected:
+      virtual int_type underflow()
+      {
+         if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+         size_t n = fread(fBuffer, 1, sizeof(fBuffer), fPipe);
+         if (n == 0) return traits_type::eof();
+         setg(fBuffer, fBuffer, fBuffer + n);
+         return traits_type::to_int_type(*gptr());
+      }
+   private:
+      FILE * fPipe;
+      char fBuffer[65536];
+   };
+}
+
 ClassImp(AliGenReaderHepMC)
 
-AliGenReaderHepMC::AliGenReaderHepMC():fEventsHandle(0), fGenEvent(0), fParticleArray(0), fParticleIterator(0), fGenEventHeader(0) {;}
+AliGenReaderHepMC::AliGenReaderHepMC():fEventsHandle(0), fGenEvent(0), fParticleArray(0), fParticleIterator(0), fGenEventHeader(0), fPrefetchDepth(0),
+   fPipe(0), fPipeBuffer(0), fPipeStream(0), fThread(0), fQueueMutex(0), fQueueNotEmpty(0), fQueueNotFull(0), fQueueArrays(0), fQueueHeaders(0), fQueueNParticles(),
+   fQueueHead(0), fQueueSize(0), fEndOfInput(kFALSE), fStopPrefetch(kFALSE), fStatisticsPrinted(kFALSE), fNEventsParsed(0), fNParticlesParsed(0), fParseTime(0.), fWaitTime(0.) {;}
 
 AliGenReaderHepMC::AliGenReaderHepMC(const AliGenReaderHepMC &reader)
-   :AliGenReader(reader), fEventsHandle(0), fGenEvent(0), fParticleArray(0), fParticleIterator(0), fGenEventHeader(0) {reader.Copy(*this);}
+   :AliGenReader(reader), fEventsHandle(0), fGenEvent(0), fParticleArray(0), fParticleIterator(0), fGenEventHeader(0), fPrefetchDepth(0),
+   fPipe(0), fPipeBuffer(0), fPipeStream(0), fThread(0), fQueueMutex(0), fQueueNotEmpty(0), fQueueNotFull(0), fQueueArrays(0), fQueueHeaders(0), fQueueNParticles(),
+   fQueueHead(0), fQueueSize(0), fEndOfInput(kFALSE), fStopPrefetch(kFALSE), fStatisticsPrinted(kFALSE), fNEventsParsed(0), fNParticlesParsed(0), fParseTime(0.), fWaitTime(0.) {reader.Copy(*this);}
 
 
 AliGenReaderHepMC& AliGenReaderHepMC::operator=(const  AliGenReaderHepMC& rhs)
@@ -27,7 +79,19 @@ AliGenReaderHepMC& AliGenReaderHepMC::operator=(const  AliGenReaderHepMC& rhs)
    return *this;
 }
 
-AliGenReaderHepMC::~AliGenReaderHepMC(){ delete fEventsHandle; delete fGenEvent; delete fParticleArray; delete fParticleIterator;} // not deleting fGenEventHeader as it is returned out
+AliGenReaderHepMC::~AliGenReaderHepMC()
+{
+   // Destructor, not deleting fGenEventHeader as it is returned out
+   StopPrefetch();
+   delete fEventsHandle;
+   delete fGenEvent;
+   delete fParticleArray;
+   delete fParticleIterator;
+   delete fPipeStream;
+   delete fPipeBuffer;
+   if (fPipe && gSystem->ClosePipe(fPipe) != 0)
+      AliWarning(Form("Decompression of %s failed", fFileName));
+}
 
 void AliGenReaderHepMC::Copy(TObject&) const
 {
@@ -44,57 +108,246 @@ void AliGenReaderHepMC::Init()
       AliError(Form("Couldn't open input file: %s", fFileName));
 
    // Initialisation
-   fEventsHandle = new HepMC::IO_GenEvent(fFileName, std::ios::in);
+   fEventsHandle = OpenInput();
    fParticleArray = new TClonesArray("TParticle");
    fParticleIterator = new TIter(fParticleArray);
+   if (fPrefetchDepth > 0) StartPrefetch();
+}
+
+HepMC::IO_BaseClass * AliGenReaderHepMC::OpenInput()
+{
+   // HepMC reader on the file, or on the output of the decompressor
+   // if the file starts with the magic bytes of gzip, bzip2 or xz
+   unsigned char magic[6] = {0, 0, 0, 0, 0, 0};
+   FILE * file = fopen(fFileName, "rb");
+   if (file) {
+      if (fread(magic, 1, sizeof(magic), file) != sizeof(magic)) magic[0] = 0;
+      fclose(file);
+   }
+   const char * decompressor = 0;
+   if (magic[0] == 0x1f && magic[1] == 0x8b) decompressor = "gzip";
+   else if (magic[0] == 'B' && magic[1] == 'Z' && magic[2] == 'h') decompressor = "bzip2";
+   else if (magic[0] == 0xfd && magic[1] == '7' && magic[2] == 'z' && magic[3] == 'X' && magic[4] == 'Z' && magic[5] == 0) decompressor = "xz";
+   if (!decompressor) return new HepMC::IO_GenEvent(fFileName, std::ios::in);
+
+   AliInfo(Form("Reading %s through %s", fFileName, decompressor));
+   fPipe = gSystem->OpenPipe(Form("%s -dc '%s'", decompressor, fFileName), "r");
+   if (!fPipe) {
+      AliError(Form("Cannot start %s for %s", decompressor, fFileName));
+      return new HepMC::IO_GenEvent(fFileName, std::ios::in);
+   }
+   fPipeBuffer = new PipeBuffer(fPipe);
+   fPipeStream = new std::istream(fPipeBuffer);
+   return new HepMC::IO_GenEvent(*fPipeStream);
+}
+
+AliGenEventHeader * AliGenReaderHepMC::ParseEvent(HepMC::GenEvent * genEvent, TClonesArray * particles) const
+{
+   // Fill the particles of genEvent into the array and create the event header.
+   // Also runs on the prefetch thread, so no AliLog here.
+   THepMCParser::ParseGenEvent2TCloneArray(genEvent,particles,"GEV","CM",false);
+   THepMCParser::HeavyIonHeader_t heavyIonHeader;
+   THepMCParser::PdfHeader_t pdfHeader;
+   THepMCParser::ParseGenEvent2HeaderStructs(genEvent,heavyIonHeader,pdfHeader,true,true);
+   AliGenEventHeader * header = new AliGenHepMCEventHeader(
+         heavyIonHeader.Ncoll_hard,
+         heavyIonHeader.Npart_proj,
+         heavyIonHeader.Npart_targ,
+         heavyIonHeader.Ncoll,
+         heavyIonHeader.spectator_neutrons,
+         heavyIonHeader.spectator_protons,
+         heavyIonHeader.N_Nwounded_collisions,
+         heavyIonHeader.Nwounded_N_collisions,
+         heavyIonHeader.Nwounded_Nwounded_collisions,
+         heavyIonHeader.impact_parameter,
+         heavyIonHeader.event_plane_angle,
+         heavyIonHeader.eccentricity,
+         heavyIonHeader.sigma_inel_NN,
+         pdfHeader.id1,
+         pdfHeader.id2,
+         pdfHeader.pdf_id1,
+         pdfHeader.pdf_id2,
+         pdfHeader.x1,
+         pdfHeader.x2,
+         pdfHeader.scalePDF,
+         pdfHeader.pdf1,
+         pdfHeader.pdf2
+   );
+   // propagate the event weight from HepMC to the event header
+   HepMC::WeightContainer weights = genEvent->weights();
+   if (!weights.empty())
+     header->SetEventWeight(weights.front());
+   return header;
 }
 
 Int_t AliGenReaderHepMC::NextEvent()
 {
+   if (fThread) return NextPrefetchedEvent();
+
    // Clean memory
    if (fGenEvent) delete fGenEvent;
    // Read the next event
+   TStopwatch watch;
    if ((fGenEvent = fEventsHandle->read_next_event())) {
-      THepMCParser::ParseGenEvent2TCloneArray(fGenEvent,fParticleArray,"GEV","CM",false);
+      fGenEventHeader = ParseEvent(fGenEvent, fParticleArray);
       fParticleIterator->Reset();
-      THepMCParser::HeavyIonHeader_t heavyIonHeader;
-      THepMCParser::PdfHeader_t pdfHeader;
-      THepMCParser::ParseGenEvent2HeaderStructs(fGenEvent,heavyIonHeader,pdfHeader,true,true);
-      fGenEventHeader = new AliGenHepMCEventHeader(
-            heavyIonHeader.Ncoll_hard,
-            heavyIonHeader.Npart_proj,
-            heavyIonHeader.Npart_targ,
-            heavyIonHeader.Ncoll,
-            heavyIonHeader.spectator_neutrons,
-            heavyIonHeader.spectator_protons,
-            heavyIonHeader.N_Nwounded_collisions,
-            heavyIonHeader.Nwounded_N_collisions,
-            heavyIonHeader.Nwounded_Nwounded_collisions,
-            heavyIonHeader.impact_parameter,
-            heavyIonHeader.event_plane_angle,
-            heavyIonHeader.eccentricity,
-            heavyIonHeader.sigma_inel_NN,
-            pdfHeader.id1,
-            pdfHeader.id2,
-            pdfHeader.pdf_id1,
-            pdfHeader.pdf_id2,
-            pdfHeader.x1,
-            pdfHeader.x2,
-            pdfHeader.scalePDF,
-            pdfHeader.pdf1,
-            pdfHeader.pdf2
-      );
-      // propagate the event weight from HepMC to the event header
-      HepMC::WeightContainer weights = fGenEvent->weights();
-      if (!weights.empty())
-        fGenEventHeader->SetEventWeight(weights.front());
+      fParseTime += watch.RealTime();
+      fNEventsParsed++;
+      fNParticlesParsed += fGenEvent->particles_size();
       AliDebug(1, Form("Parsed event %d with %d particles, weight = %e", fGenEvent->event_number(), fGenEvent->particles_size(), fGenEventHeader->EventWeight()));
       return fGenEvent->particles_size();
    }
    AliError("No more events in the file.");
+   if (!fStatisticsPrinted) PrintStatistics();
+   fStatisticsPrinted = kTRUE;
+   return 0;
+}
+
+Int_t AliGenReaderHepMC::NextPrefetchedEvent()
+{
+   // Take the next decoded event from the queue, the array of the
+   // current event goes back into the ring for the prefetch thread
+   TStopwatch watch;
+   fQueueMutex->Lock();
+   while (fQueueSize == 0 && !fEndOfInput) fQueueNotEmpty->Wait();
+   fWaitTime += watch.RealTime();
+   if (fQueueSize == 0) {
+      fQueueMutex->UnLock();
+      AliError("No more events in the file.");
+      if (!fStatisticsPrinted) PrintStatistics();
+      fStatisticsPrinted = kTRUE;
+      return 0;
+   }
+   TClonesArray * particles = fQueueArrays[fQueueHead];
+   fQueueArrays[fQueueHead] = fParticleArray;
+   fParticleArray = particles;
+   fGenEventHeader = fQueueHeaders[fQueueHead];
+   fQueueHeaders[fQueueHead] = 0;
+   Int_t nParticles = fQueueNParticles[fQueueHead];
+   fQueueHead = (fQueueHead + 1) % fPrefetchDepth;
+   fQueueSize--;
+   fQueueNotFull->Signal();
+   fQueueMutex->UnLock();
+
+   delete fParticleIterator;
+   fParticleIterator = new TIter(fParticleArray);
+   AliDebug(1, Form("Event with %d particles, weight = %e", nParticles, fGenEventHeader->EventWeight()));
+   return nParticles;
+}
+
+void AliGenReaderHepMC::StartPrefetch()
+{
+   // Allocate the ring of particle arrays and start the prefetch thread.
+   // Everything touching the class table or the PDG database for the
+   // first time is done here, on the main thread.
+   TThread::Initialize();
+   TDatabasePDG::Instance()->GetParticle(211);
+   fQueueMutex = new TMutex();
+   fQueueNotEmpty = new TCondition(fQueueMutex);
+   fQueueNotFull = new TCondition(fQueueMutex);
+   fQueueArrays = new TClonesArray*[fPrefetchDepth];
+   fQueueHeaders = new AliGenEventHeader*[fPrefetchDepth];
+   fQueueNParticles.Set(fPrefetchDepth);
+   for (Int_t i = 0; i < fPrefetchDepth; i++) {
+      fQueueArrays[i] = new TClonesArray("TParticle");
+      fQueueHeaders[i] = 0;
+   }
+   fQueueHead = fQueueSize = 0;
+   fEndOfInput = fStopPrefetch = kFALSE;
+   AliInfo(Form("Decoding up to %d events ahead on a background thread", fPrefetchDepth));
+   fThread = new TThread("AliGenReaderHepMC", PrefetchLoop, (void*) this);
+   fThread->Run();
+}
+
+void AliGenReaderHepMC::StopPrefetch()
+{
+   // Stop the prefetch thread and delete the events still queued
+   if (!fThread) return;
+   fQueueMutex->Lock();
+   fStopPrefetch = kTRUE;
+   fQueueNotFull->Broadcast();
+   fQueueMutex->UnLock();
+   fThread->Join();
+   delete fThread;
+   fThread = 0;
+
+   for (Int_t i = 0; i < fPrefetchDepth; i++) {
+      delete fQueueArrays[i];
+      delete fQueueHeaders[i];
+   }
+   delete [] fQueueArrays;
+   delete [] fQueueHeaders;
+   fQueueArrays = 0;
+   fQueueHeaders = 0;
+   delete fQueueNotEmpty;
+   delete fQueueNotFull;
+   delete fQueueMutex;
+   fQueueNotEmpty = fQueueNotFull = 0;
+   fQueueMutex = 0;
+}
+
+void * AliGenReaderHepMC::PrefetchLoop(void * arg)
+{
+   // Body of the prefetch thread: read and decode events into the free
+   // slots of the ring until the end of the file or until stopped.
+   // The slot being filled is not seen by NextEvent before fQueueSize
+   // is increased, so the decoding runs without holding the lock.
+   AliGenReaderHepMC * reader = static_cast<AliGenReaderHepMC*>(arg);
+   const Int_t depth = reader->fPrefetchDepth;
+   TStopwatch watch;
+   while (1) {
+      reader->fQueueMutex->Lock();
+      while (reader->fQueueSize == depth && !reader->fStopPrefetch) reader->fQueueNotFull->Wait();
+      const Int_t slot = (reader->fQueueHead + reader->fQueueSize) % depth;
+      const Bool_t stop = reader->fStopPrefetch;
+      reader->fQueueMutex->UnLock();
+      if (stop) break;
+
+      watch.Start(kTRUE);
+      HepMC::GenEvent * genEvent = reader->fEventsHandle->read_next_event();
+      AliGenEventHeader * header = 0;
+      Int_t nParticles = 0;
+      if (genEvent) {
+         header = reader->ParseEvent(genEvent, reader->fQueueArrays[slot]);
+         nParticles = genEvent->particles_size();
+         delete genEvent;
+      }
+      const Double_t time = watch.RealTime();
+
+      reader->fQueueMutex->Lock();
+      reader->fParseTime += time;
+      if (genEvent) {
+         reader->fQueueHeaders[slot] = header;
+         reader->fQueueNParticles[slot] = nParticles;
+         reader->fQueueSize++;
+         reader->fNEventsParsed++;
+         reader->fNParticlesParsed += nParticles;
+      } else {
+         reader->fEndOfInput = kTRUE;
+      }
+      reader->fQueueNotEmpty->Signal();
+      reader->fQueueMutex->UnLock();
+      if (!genEvent) break;
+   }
    return 0;
 }
 
+void AliGenReaderHepMC::PrintStatistics() const
+{
+   // Parse throughput so far
+   if (fQueueMutex) fQueueMutex->Lock();
+   const Long64_t nEvents = fNEventsParsed;
+   const Long64_t nParticles = fNParticlesParsed;
+   const Double_t parseTime = fParseTime;
+   if (fQueueMutex) fQueueMutex->UnLock();
+   const Double_t rate = (parseTime > 0.) ? nEvents / parseTime : 0.;
+   const Double_t particleRate = (parseTime > 0.) ? nParticles / parseTime : 0.;
+   AliInfo(Form("%lld events with %lld particles decoded in %.2f s (%.1f events/s, %.0f particles/s)",
+                nEvents, nParticles, parseTime, rate, particleRate));
+   if (fPrefetchDepth > 0)
+      AliInfo(Form("Transport waited %.2f s for decoded events", fWaitTime));
+}
+
 TParticle* AliGenReaderHepMC::NextParticle()
 {
    // Read next particle
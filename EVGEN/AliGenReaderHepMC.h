@@ -7,7 +7,11 @@
 // Author: brian.peter.thorsbro@cern.ch, brian@thorsbro.dk
 // Based on AliGenReaderSL by andreas.morsch@cern.ch
 
+#include <cstdio>
+#include <iosfwd>
+
 #include <TClonesArray.h>
+#include <TArrayI.h>
 
 #include "AliGenReader.h"
 #include "AliGenEventHeader.h"
@@ -19,6 +23,9 @@ namespace HepMC {
 }
 
 class TParticle;
+class TThread;
+class TMutex;
+class TCondition;
 
 class AliGenReaderHepMC : public AliGenReader
 {
@@ -32,6 +39,10 @@ public:
    virtual TParticle* NextParticle();
    virtual void RewindEvent();
    AliGenReaderHepMC & operator=(const AliGenReaderHepMC & rhs);
+   // Number of events decoded ahead on a background thread, 0 to read synchronously
+   void SetPrefetchDepth(Int_t depth) {fPrefetchDepth = depth;}
+   Int_t GetPrefetchDepth() const {return fPrefetchDepth;}
+   void PrintStatistics() const;
 
 protected:
    HepMC::IO_BaseClass * fEventsHandle;   // pointer to the HepMC file handler
@@ -39,11 +50,38 @@ protected:
    TClonesArray * fParticleArray;         // pointer to array containing particles of current event
    TIter * fParticleIterator;             // iterator coupled to the array
    AliGenEventHeader * fGenEventHeader;   // AliGenEventHeader
+   Int_t fPrefetchDepth;                  // number of events decoded ahead, 0 for synchronous reading
 
 private:
    void Copy(TObject&) const;
+   HepMC::IO_BaseClass * OpenInput();
+   AliGenEventHeader * ParseEvent(HepMC::GenEvent * genEvent, TClonesArray * particles) const;
+   void StartPrefetch();
+   void StopPrefetch();
+   Int_t NextPrefetchedEvent();
+   static void * PrefetchLoop(void * arg);
+
+   FILE * fPipe;                          //! decompressor pipe for compressed input
+   std::streambuf * fPipeBuffer;          //! stream buffer reading from the pipe
+   std::istream * fPipeStream;            //! stream given to the HepMC reader
+   TThread * fThread;                     //! prefetch thread
+   TMutex * fQueueMutex;                  //! protects the queue and the statistics
+   TCondition * fQueueNotEmpty;           //! signalled when an event was decoded
+   TCondition * fQueueNotFull;            //! signalled when an event was taken
+   TClonesArray ** fQueueArrays;          //! ring of particle arrays, swapped with fParticleArray
+   AliGenEventHeader ** fQueueHeaders;    //! headers of the queued events
+   TArrayI fQueueNParticles;              //! number of particles of the queued events
+   Int_t fQueueHead;                      //! first decoded event in the ring
+   Int_t fQueueSize;                      //! number of decoded events in the ring
+   Bool_t fEndOfInput;                    //! no more events in the file
+   Bool_t fStopPrefetch;                  //! prefetch thread has to stop
+   Bool_t fStatisticsPrinted;             //! statistics printed at the end of the file
+   Long64_t fNEventsParsed;               //! events decoded
+   Long64_t fNParticlesParsed;            //! particles decoded
+   Double_t fParseTime;                   //! time spent reading and decoding
+   Double_t fWaitTime;                    //! time NextEvent waited for the prefetch thread
 
-   ClassDef(AliGenReaderHepMC, 1) //Generate particles from external file
+   ClassDef(AliGenReaderHepMC, 2) //Generate particles from external file
 };
 #endif
 
@@ -18,6 +18,7 @@
 #pragma link C++ class  AliGenBox+;
 #pragma link C++ class  AliGenThetaSlice+;
 #pragma link C++ class  AliGenParam+;
+#pragma link C++ class  AliGenInverseCDF+;
 #pragma link C++ class  AliGenCocktail+;
 #pragma link C++ class  AliGenPairFlat+;
 #pragma link C++ class  AliGenMUONCocktail+;
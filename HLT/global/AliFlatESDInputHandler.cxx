@@ -0,0 +1,196 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/**
+ * >> Input handler for trees of AliFlatESDEvent buffers <<
+ *
+ * Reads the tree written by AliFlatESDTreeWriter and hands the flat event
+ * to the analysis tasks as AliVEvent. The tree fills a byte buffer which
+ * is used in place: the virtual table is restored with Reinitialize(), no
+ * AliESDEvent is created and nothing is copied.
+ *
+ * The buffer only moves in memory when it has to grow; in that case the
+ * input data of the tasks is reconnected, as done for the HLT analysis
+ * manager in AliHLTVEventInputHandler.
+ *
+ * Usage:
+ *
+ *  AliAnalysisManager* mgr = new AliAnalysisManager("flat");
+ *  mgr->SetInputEventHandler(new AliFlatESDInputHandler);
+ *  ...
+ *  TChain* chain = new TChain("flatesdTree");
+ *  chain->Add("AliFlatESDs.root");
+ *  mgr->StartAnalysis("local", chain);
+ *
+ **************************************************************************/
+
+#include "TTree.h"
+#include "TObjArray.h"
+#include "AliLog.h"
+#include "AliVCuts.h"
+#include "AliAnalysisManager.h"
+#include "AliAnalysisTask.h"
+#include "AliFlatESDEvent.h"
+#include "AliFlatESDFriend.h"
+#include "AliFlatESDTreeWriter.h"
+#include "AliFlatESDInputHandler.h"
+
+ClassImp(AliFlatESDInputHandler)
+
+// _______________________________________________________________________________________________________
+AliFlatESDInputHandler::AliFlatESDInputHandler() :
+  AliInputEventHandler(),
+  fAnalysisType(0),
+  fReadFriends(kTRUE),
+  fEventBuffer(new std::vector<Char_t>),
+  fFriendBuffer(new std::vector<Char_t>),
+  fFlatEvent(NULL),
+  fFlatFriend(NULL),
+  fConnectedAddress(NULL)
+{
+  // Default constructor
+}
+
+// _______________________________________________________________________________________________________
+AliFlatESDInputHandler::AliFlatESDInputHandler(const char* name, const char* title) :
+  AliInputEventHandler(name, title),
+  fAnalysisType(0),
+  fReadFriends(kTRUE),
+  fEventBuffer(new std::vector<Char_t>),
+  fFriendBuffer(new std::vector<Char_t>),
+  fFlatEvent(NULL),
+  fFlatFriend(NULL),
+  fConnectedAddress(NULL)
+{
+  // Named constructor
+}
+
+// _______________________________________________________________________________________________________
+AliFlatESDInputHandler::~AliFlatESDInputHandler()
+{
+  // Destructor
+  delete fEventBuffer;
+  delete fFriendBuffer;
+}
+
+// _______________________________________________________________________________________________________
+Bool_t AliFlatESDInputHandler::Init(TTree* tree, Option_t* opt)
+{
+  // Initialisation necessary for each new tree
+  fAnalysisType = opt;
+  fTree = tree;
+  if (!fTree) return kFALSE;
+
+  if (!fTree->GetBranch(AliFlatESDTreeWriter::fgkEventBranchName)) {
+    AliError(Form("Tree %s has no branch %s", fTree->GetName(), AliFlatESDTreeWriter::fgkEventBranchName));
+    return kFALSE;
+  }
+  fTree->SetBranchAddress(AliFlatESDTreeWriter::fgkEventBranchName, &fEventBuffer);
+  if (fTree->GetBranch(AliFlatESDTreeWriter::fgkFriendBranchName)) {
+    if (fReadFriends) fTree->SetBranchAddress(AliFlatESDTreeWriter::fgkFriendBranchName, &fFriendBuffer);
+    else fTree->SetBranchStatus(AliFlatESDTreeWriter::fgkFriendBranchName, 0);
+  }
+  fConnectedAddress = NULL;
+
+  if (fMixingHandler) fMixingHandler->Init(tree, opt);
+  return kTRUE;
+}
+
+// _______________________________________________________________________________________________________
+Bool_t AliFlatESDInputHandler::Notify(const char* path)
+{
+  // Notify a directory change
+  AliInfo(Form("Directory change %s", path));
+  fConnectedAddress = NULL;
+  return AliInputEventHandler::Notify(path);
+}
+
+// _______________________________________________________________________________________________________
+Bool_t AliFlatESDInputHandler::BeginEvent(Long64_t entry)
+{
+  // Set up the flat event in the buffer just read by the tree
+  fFlatEvent = NULL;
+  fFlatFriend = NULL;
+
+  if (!fEventBuffer->empty()) {
+    fFlatEvent = reinterpret_cast<AliFlatESDEvent*>(&(*fEventBuffer)[0]);
+    fFlatEvent->Reinitialize();
+    if (fFlatEvent->GetSize() != fEventBuffer->size()) {
+      AliError(Form("Size mismatch of flat event %lld: %llu in buffer of %lu bytes, skipping",
+                    entry, fFlatEvent->GetSize(), (ULong_t)fEventBuffer->size()));
+      fFlatEvent = NULL;
+    }
+  }
+
+  if (fFlatEvent && fReadFriends && !fFriendBuffer->empty()) {
+    fFlatFriend = reinterpret_cast<AliFlatESDFriend*>(&(*fFriendBuffer)[0]);
+    fFlatFriend->Reinitialize();
+    if (fFlatFriend->GetSize() != fFriendBuffer->size()) {
+      AliError(Form("Size mismatch of flat friend %lld, ignoring it", entry));
+      fFlatFriend = NULL;
+    }
+  }
+  if (fFlatEvent) fFlatEvent->SetFriendEvent(fFlatFriend);
+
+  // tasks keep the event pointer, reconnect them if the buffer moved
+  const Char_t* address = reinterpret_cast<const Char_t*>(fFlatEvent);
+  if (address != fConnectedAddress) {
+    ConnectTasks();
+    fConnectedAddress = address;
+  }
+
+  fNewEvent = kTRUE;
+  fIsSelectedResult = 0;
+  if (fFlatEvent && fEventCuts && !IsUserCallSelectionMask())
+    fIsSelectedResult = fEventCuts->GetSelectionMask(fFlatEvent);
+
+  if (fMixingHandler) fMixingHandler->BeginEvent(entry);
+  return kTRUE;
+}
+
+// _______________________________________________________________________________________________________
+Bool_t AliFlatESDInputHandler::FinishEvent()
+{
+  // Called at the end of every event, the buffers are reused by the next entry
+  if (fMixingHandler) fMixingHandler->FinishEvent();
+  return kTRUE;
+}
+
+// _______________________________________________________________________________________________________
+AliVEvent* AliFlatESDInputHandler::GetEvent() const
+{
+  // The flat event as AliVEvent
+  return fFlatEvent;
+}
+
+// _______________________________________________________________________________________________________
+AliVfriendEvent* AliFlatESDInputHandler::GetVfriendEvent() const
+{
+  // The flat friend as AliVfriendEvent
+  return fFlatFriend;
+}
+
+// _______________________________________________________________________________________________________
+void AliFlatESDInputHandler::ConnectTasks()
+{
+  // Propagate the new event address to all tasks of the manager
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr || !mgr->GetTasks()) return;
+  TObjArray* tasks = mgr->GetTasks();
+  for (Int_t i = 0; i < tasks->GetEntriesFast(); i++) {
+    AliAnalysisTask* task = static_cast<AliAnalysisTask*>(tasks->At(i));
+    if (task) task->ConnectInputData("");
+  }
+}
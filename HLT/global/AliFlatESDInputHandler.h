@@ -0,0 +1,60 @@
+#ifndef ALIFLATESDINPUTHANDLER_H
+#define ALIFLATESDINPUTHANDLER_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/*
+ * See implementation file for documentation
+ */
+
+#include <vector>
+#include "AliInputEventHandler.h"
+
+class TTree;
+class AliVEvent;
+class AliVfriendEvent;
+class AliFlatESDEvent;
+class AliFlatESDFriend;
+
+class AliFlatESDInputHandler : public AliInputEventHandler {
+ public:
+  AliFlatESDInputHandler();
+  AliFlatESDInputHandler(const char* name, const char* title);
+  virtual ~AliFlatESDInputHandler();
+
+  virtual Bool_t       Init(Option_t* opt) {return AliInputEventHandler::Init(opt);}
+  virtual Bool_t       Init(TTree* tree, Option_t* opt);
+  virtual Bool_t       BeginEvent(Long64_t entry);
+  virtual Bool_t       Notify() {return AliInputEventHandler::Notify();}
+  virtual Bool_t       Notify(const char* path);
+  virtual Bool_t       FinishEvent();
+
+  virtual AliVEvent*       GetEvent() const;
+  virtual AliVfriendEvent* GetVfriendEvent() const;
+  virtual Option_t*        GetDataType() const {return "flatESD";}
+  virtual Option_t*        GetAnalysisType() const {return fAnalysisType;}
+
+  AliFlatESDEvent*  GetFlatESDEvent() const {return fFlatEvent;}
+  AliFlatESDFriend* GetFlatESDFriend() const {return fFlatFriend;}
+  void              SetReadFriends(Bool_t flag) {Changed(); fReadFriends = flag;}
+  Bool_t            GetReadFriends() const {return fReadFriends;}
+
+ private:
+  AliFlatESDInputHandler(const AliFlatESDInputHandler&);
+  AliFlatESDInputHandler& operator=(const AliFlatESDInputHandler&);
+
+  void ConnectTasks();
+
+  Option_t*            fAnalysisType;  //! analysis type
+  Bool_t               fReadFriends;   //  read the flat friends if present
+  std::vector<Char_t>* fEventBuffer;   //! flat event buffer, filled by the tree
+  std::vector<Char_t>* fFriendBuffer;  //! flat friend buffer, filled by the tree
+  AliFlatESDEvent*     fFlatEvent;     //! event in fEventBuffer
+  AliFlatESDFriend*    fFlatFriend;    //! friend in fFriendBuffer
+  const Char_t*        fConnectedAddress; //! event address the tasks are connected to
+
+  ClassDef(AliFlatESDInputHandler,1) // input handler for AliFlatESDEvent trees
+};
+
+#endif
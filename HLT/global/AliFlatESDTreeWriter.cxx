@@ -0,0 +1,200 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/**
+ * >> Writer of AliFlatESDEvent buffers into a ROOT tree <<
+ *
+ * Each entry of the tree "flatesdTree" holds the flat event and, optionally,
+ * the flat friend of one ESD event as raw byte buffers. The buffers are
+ * used in place by AliFlatESDInputHandler, i.e. reading an event costs one
+ * decompression of the basket, no object streaming and no conversion.
+ *
+ * Offline usage:
+ *
+ *  AliFlatESDTreeWriter::Convert("AliESDs.root", "AliFlatESDs.root", "AliESDfriends.root");
+ *
+ * or, inside an event loop,
+ *
+ *  AliFlatESDTreeWriter writer;
+ *  writer.Open("AliFlatESDs.root");
+ *  ... writer.WriteEvent(esd, esdFriend);
+ *  writer.Close();
+ *
+ **************************************************************************/
+
+#include "TFile.h"
+#include "TTree.h"
+#include "AliLog.h"
+#include "AliESDEvent.h"
+#include "AliESDfriend.h"
+#include "AliFlatESDEvent.h"
+#include "AliFlatESDFriend.h"
+#include "AliFlatESDTreeWriter.h"
+
+ClassImp(AliFlatESDTreeWriter)
+
+const char* AliFlatESDTreeWriter::fgkTreeName         = "flatesdTree";
+const char* AliFlatESDTreeWriter::fgkEventBranchName  = "FlatESD";
+const char* AliFlatESDTreeWriter::fgkFriendBranchName = "FlatESDFriend";
+
+// _______________________________________________________________________________________________________
+AliFlatESDTreeWriter::AliFlatESDTreeWriter() :
+  TObject(),
+  fFile(NULL),
+  fTree(NULL),
+  fEventBuffer(new std::vector<Char_t>),
+  fFriendBuffer(NULL)
+{
+  // Default constructor
+}
+
+// _______________________________________________________________________________________________________
+AliFlatESDTreeWriter::~AliFlatESDTreeWriter()
+{
+  // Destructor, closes the file if still open
+  Close();
+  delete fEventBuffer;
+  delete fFriendBuffer;
+}
+
+// _______________________________________________________________________________________________________
+Bool_t AliFlatESDTreeWriter::Open(const char* fileName, Bool_t writeFriends, Int_t compression)
+{
+  // Create the output file and tree
+  Close();
+  fFile = TFile::Open(fileName, "RECREATE", "", compression);
+  if (!fFile || fFile->IsZombie()) {
+    AliError(Form("Cannot create %s", fileName));
+    delete fFile;
+    fFile = NULL;
+    return kFALSE;
+  }
+  fTree = new TTree(fgkTreeName, "Flat ESD events");
+  fTree->Branch(fgkEventBranchName, &fEventBuffer);
+  if (writeFriends) {
+    if (!fFriendBuffer) fFriendBuffer = new std::vector<Char_t>;
+    fTree->Branch(fgkFriendBranchName, &fFriendBuffer);
+  }
+  return kTRUE;
+}
+
+// _______________________________________________________________________________________________________
+Int_t AliFlatESDTreeWriter::WriteEvent(AliESDEvent* esd, AliESDfriend* esdFriend, Bool_t fillV0s)
+{
+  // Convert one event and fill the tree. Returns the size of the flat event,
+  // a negative value in case of error. An event which cannot be converted is
+  // stored as an empty buffer to keep the entries aligned with the ESD tree.
+  if (!fTree) {
+    AliError("No output tree, call Open first");
+    return -1;
+  }
+
+  Int_t size = -1;
+  fEventBuffer->clear();
+  if (esd) {
+    size_t allocated = AliFlatESDEvent::EstimateSize(esd, fillV0s);
+    fEventBuffer->resize(allocated);
+    AliFlatESDEvent* flatEsd = reinterpret_cast<AliFlatESDEvent*>(&(*fEventBuffer)[0]);
+    new (flatEsd) AliFlatESDEvent;
+    if (flatEsd->SetFromESD(allocated, esd, fillV0s) == 0) {
+      size = flatEsd->GetSize();
+      fEventBuffer->resize(size);
+    } else {
+      AliError("Conversion of the ESD event failed");
+      fEventBuffer->clear();
+    }
+  }
+
+  if (fFriendBuffer) {
+    fFriendBuffer->clear();
+    if (esdFriend && size >= 0) {
+      size_t allocated = AliFlatESDFriend::EstimateSize(esdFriend);
+      fFriendBuffer->resize(allocated);
+      AliFlatESDFriend* flatFriend = reinterpret_cast<AliFlatESDFriend*>(&(*fFriendBuffer)[0]);
+      new (flatFriend) AliFlatESDFriend;
+      if (flatFriend->SetFromESDfriend(allocated, esdFriend) == 0) {
+        fFriendBuffer->resize(flatFriend->GetSize());
+      } else {
+        AliError("Conversion of the ESD friend failed");
+        fFriendBuffer->clear();
+      }
+    }
+  }
+
+  fTree->Fill();
+  return size;
+}
+
+// _______________________________________________________________________________________________________
+void AliFlatESDTreeWriter::Close()
+{
+  // Write the tree and close the file
+  if (!fFile) return;
+  fFile->cd();
+  fTree->Write();
+  delete fFile; // deletes the tree
+  fFile = NULL;
+  fTree = NULL;
+}
+
+// _______________________________________________________________________________________________________
+Int_t AliFlatESDTreeWriter::Convert(const char* esdFileName, const char* outFileName,
+                                    const char* friendFileName, Bool_t fillV0s)
+{
+  // Convert an ESD file, and optionally its friends, into a flat ESD tree.
+  // Returns the number of events converted, -1 in case of error.
+  TFile* file = TFile::Open(esdFileName);
+  if (!file || file->IsZombie()) {
+    AliErrorClass(Form("Cannot open %s", esdFileName));
+    delete file;
+    return -1;
+  }
+  TTree* esdTree = dynamic_cast<TTree*>(file->Get("esdTree"));
+  if (!esdTree) {
+    AliErrorClass(Form("No esdTree in %s", esdFileName));
+    delete file;
+    return -1;
+  }
+
+  AliESDEvent* esd = new AliESDEvent;
+  esd->ReadFromTree(esdTree);
+
+  AliESDfriend* esdFriend = NULL;
+  if (friendFileName && friendFileName[0]) {
+    if (!esdTree->FindBranch("ESDfriend.")) esdTree->AddFriend("esdFriendTree", friendFileName);
+    esdTree->SetBranchStatus("ESDfriend.", 1);
+    esdFriend = dynamic_cast<AliESDfriend*>(esd->FindListObject("AliESDfriend"));
+    if (esdFriend) esdTree->SetBranchAddress("ESDfriend.", &esdFriend);
+    else AliWarningClass("No ESD friends found, writing events only");
+  }
+
+  AliFlatESDTreeWriter writer;
+  if (!writer.Open(outFileName, esdFriend != NULL)) {
+    delete esd;
+    delete file;
+    return -1;
+  }
+
+  const Int_t nev = esdTree->GetEntries();
+  for (Int_t iev=0; iev<nev; iev++) {
+    esdTree->GetEntry(iev);
+    writer.WriteEvent(esd, esdFriend, fillV0s);
+  }
+  writer.Close();
+
+  delete esd;
+  delete file;
+  return nev;
+}
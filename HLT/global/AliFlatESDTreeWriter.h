@@ -0,0 +1,48 @@
+#ifndef ALIFLATESDTREEWRITER_H
+#define ALIFLATESDTREEWRITER_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/*
+ * See implementation file for documentation
+ */
+
+#include <vector>
+#include "TObject.h"
+
+class TFile;
+class TTree;
+class AliESDEvent;
+class AliESDfriend;
+
+class AliFlatESDTreeWriter : public TObject {
+ public:
+  AliFlatESDTreeWriter();
+  virtual ~AliFlatESDTreeWriter();
+
+  Bool_t Open(const char* fileName, Bool_t writeFriends=kTRUE, Int_t compression=1);
+  Int_t  WriteEvent(AliESDEvent* esd, AliESDfriend* esdFriend=NULL, Bool_t fillV0s=kTRUE);
+  void   Close();
+
+  static Int_t Convert(const char* esdFileName, const char* outFileName,
+                       const char* friendFileName=NULL, Bool_t fillV0s=kTRUE);
+
+  // names shared with AliFlatESDInputHandler
+  static const char* fgkTreeName;          // name of the flat ESD tree
+  static const char* fgkEventBranchName;   // branch with the flat event buffers
+  static const char* fgkFriendBranchName;  // branch with the flat friend buffers
+
+ private:
+  AliFlatESDTreeWriter(const AliFlatESDTreeWriter&);
+  AliFlatESDTreeWriter& operator=(const AliFlatESDTreeWriter&);
+
+  TFile*               fFile;          //! output file
+  TTree*               fTree;          //! output tree
+  std::vector<Char_t>* fEventBuffer;   //! buffer of the flat event
+  std::vector<Char_t>* fFriendBuffer;  //! buffer of the flat friend
+
+  ClassDef(AliFlatESDTreeWriter,0) // writes AliFlatESDEvent buffers to a tree
+};
+
+#endif
@@ -42,6 +42,8 @@
 #pragma link C++ class AliHLTGlobalEsdToFlatConverterComponent+;
 #pragma link C++ class AliFlatESDFriend+;
 #pragma link C++ class AliFlatESDTrack+;
+#pragma link C++ class AliFlatESDTreeWriter+;
+#pragma link C++ class AliFlatESDInputHandler+;
 #pragma link C++ class AliHLTGlobalFlatEsdTestComponent+;
 #pragma link C++ class AliHLTAnalysisManager+;
 #pragma link C++ class AliHLTAnalysisManagerComponent+;
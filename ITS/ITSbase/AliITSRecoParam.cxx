@@ -171,6 +171,7 @@ AliITSRecoParam::AliITSRecoParam() : AliDetectorRecoParam(),
  fSelectBestMIP03(kFALSE),
  fFlagFakes(kFALSE),
  fUseImproveKalman(kFALSE),
+ fUseClusterGridMI(kFALSE),
  fFindV0s(kTRUE),
  fStoreLikeSignV0s(kFALSE),
  fUseUnfoldingInClusterFinderSPD(kFALSE),
@@ -127,9 +127,11 @@ class AliITSRecoParam : public AliDetectorRecoParam
   Bool_t   GetSelectBestMIP03()                 const {return fSelectBestMIP03;}
   Bool_t   GetFlagFakes()                       const {return fFlagFakes;}
   Bool_t   GetUseImproveKalman()                const {return fUseImproveKalman;}
+  Bool_t   GetUseClusterGridMI()                const {return fUseClusterGridMI;}
   void     SetSelectBestMIP03(Bool_t v=kTRUE)         {fSelectBestMIP03 = v;}
   void     SetFlagFakes(Bool_t v=kTRUE)               {fFlagFakes = v;}
   void     SetUseImproveKalman(Bool_t v=kTRUE)        {fUseImproveKalman = v;}
+  void     SetUseClusterGridMI(Bool_t v=kTRUE)        {fUseClusterGridMI = v;}
   //
   Float_t  GetVertexer3DWideFiducialRegionZ() const {return fVtxr3DZCutWide;}
   Float_t  GetVertexer3DWideFiducialRegionR() const {return fVtxr3DRCutWide;}
@@ -714,6 +716,7 @@ class AliITSRecoParam : public AliDetectorRecoParam
   Bool_t fSelectBestMIP03;          // (MI) Multiply norm chi2 by interpolated one in hypthesis analysis
   Bool_t fFlagFakes;                // (MI) preform shared cluster analysis and flag candidates for fakes
   Bool_t fUseImproveKalman;         // (MI) Use ImproveKalman version of AliITSTrackV2 instead of Improve
+  Bool_t fUseClusterGridMI;         // (MI) search clusters in the road through a y-z grid instead of y slices
 
   Bool_t fFindV0s;  // flag to enable V0 finder (MI)
   Bool_t fStoreLikeSignV0s; // flag to store like-sign V0s (MI)
@@ -820,7 +823,7 @@ class AliITSRecoParam : public AliDetectorRecoParam
   AliITSRecoParam(const AliITSRecoParam & param);
   AliITSRecoParam & operator=(const AliITSRecoParam &param);
 
-  ClassDef(AliITSRecoParam,57) // ITS reco parameters
+  ClassDef(AliITSRecoParam,58) // ITS reco parameters
 };
 
 #endif
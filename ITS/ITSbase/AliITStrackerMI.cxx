@@ -34,6 +34,7 @@
 #include <TTreeStream.h>
 #include <TVector3.h>
 #include <TBits.h>
+#include <algorithm>
 
 #include "AliLog.h"
 #include "AliGeomManager.h"
@@ -479,6 +480,7 @@ Int_t AliITStrackerMI::LoadClusters(TTree *cTree) {
     }
     //
     fgLayers[i].ResetRoad(); //road defined by the cluster density
+    fgLayers[i].SetUseGrid(AliITSReconstructor::GetRecoParam()->GetUseClusterGridMI());
     fgLayers[i].SortClusters();
   }
 
@@ -1543,11 +1545,20 @@ fAccepted(0),
 fRoad(0),
 fMaxSigmaClY(0),
 fMaxSigmaClZ(0),
-fNMaxSigmaCl(3)
+fNMaxSigmaCl(3),
+fUseGrid(kFALSE),
+fNGridY(0),
+fNGridZ(0),
+fGridDy(0),
+fGridDz(0),
+fGridZ0(0),
+fGridFirst(),
+fNGridCand(0)
 {
   //--------------------------------------------------------------------
   //default AliITSlayer constructor
   //--------------------------------------------------------------------
+  for (Int_t i=4;i--;) fGridCellRange[i]=-1;
   //
   // RS speedup reseting
   //  memset(fClusterWeight,0,sizeof(Float_t)*AliITSRecoParam::kMaxClusterPerLayer);
@@ -1638,10 +1649,19 @@ fAccepted(0),
 fRoad(0),
 fMaxSigmaClY(0),
 fMaxSigmaClZ(0),
-fNMaxSigmaCl(3) {
+fNMaxSigmaCl(3),
+fUseGrid(kFALSE),
+fNGridY(0),
+fNGridZ(0),
+fGridDy(0),
+fGridDz(0),
+fGridZ0(0),
+fGridFirst(),
+fNGridCand(0) {
   //--------------------------------------------------------------------
   //main AliITSlayer constructor
   //--------------------------------------------------------------------
+  for (Int_t i=4;i--;) fGridCellRange[i]=-1;
   fDetectors=new AliITSdetector[fNladders*fNdetectors];
   fRoad=2*fR*TMath::Sqrt(TMath::Pi()/1.);//assuming that there's only one cluster
   //
@@ -1776,6 +1796,8 @@ void AliITStrackerMI::AliITSlayer::ResetClusters() {
   */  
   fN=0;
   fI=0;
+  fNGridY=0;
+  fNGridCand=0;
 }
 //------------------------------------------------------------------------
 void AliITStrackerMI::AliITSlayer::ResetWeights() {
@@ -1821,6 +1843,7 @@ Int_t AliITStrackerMI::AliITSlayer::InsertCluster(AliITSRecPoint *cl) {
     return 1;
   }
   fCurrentSlice=-1;
+  fNGridY=0; // grid is rebuilt by SortClusters
   fClusters[fN]=cl;
   fN++;
   AliITSdetector &det=GetDetector(cl->GetDetectorIndex());    
@@ -1948,8 +1971,106 @@ void  AliITStrackerMI::AliITSlayer::SortClusters()
       printf("Bug\n");
     }
   }
+  //
+  if (fUseGrid) BuildGrid();
+  else fNGridY=0;
 
-
+}
+//------------------------------------------------------------------------
+void AliITStrackerMI::AliITSlayer::BuildGrid()
+{
+  //
+  // Fill the y-z grid with the sorted clusters. The cells cover the full
+  // circle in y and the cluster range in z, their number follows the
+  // occupancy (~kClustersPerCell clusters per cell). The clusters are
+  // counted into the cells in z order, so each cell stays sorted in z.
+  //
+  const Int_t kClustersPerCell = 4;
+  fNGridY = 0;
+  fNGridCand = 0;
+  for (Int_t i=4;i--;) fGridCellRange[i]=-1;
+  if (fN<1) return;
+  //
+  Double_t circle = 2*TMath::Pi()*fR;
+  Double_t zspan  = TMath::Max(Double_t(fZ[fN-1]-fZ[0]),1.);
+  Int_t ncells    = TMath::Max(fN/kClustersPerCell,1);
+  Int_t ny = TMath::Nint(TMath::Sqrt(ncells*circle/zspan));
+  if (ny<1) ny = 1;
+  if (ny>ncells) ny = ncells;
+  fNGridZ = TMath::Max(ncells/ny,1);
+  fGridDy = circle/ny;
+  fGridDz = zspan/fNGridZ;
+  fGridZ0 = fZ[0];
+  fNGridY = ny;
+  //
+  // counting sort of the cluster indices by cell
+  ncells = fNGridY*fNGridZ;
+  fGridFirst.Set(ncells+1);
+  fGridFirst.Reset();
+  Int_t *first = fGridFirst.GetArray();
+  Int_t *cell  = fGridCand;  // scratch, the candidates are filled by SelectGridCells
+  for (Int_t i=0;i<fN;i++) {
+    cell[i] = GetGridCellY(fY[i])*fNGridZ + GetGridCellZ(fZ[i]);
+    first[cell[i]+1]++;
+  }
+  for (Int_t ic=0;ic<ncells;ic++) first[ic+1] += first[ic];
+  for (Int_t i=0;i<fN;i++) fGridIndex[first[cell[i]]++] = i;
+  for (Int_t ic=ncells;ic>0;ic--) first[ic] = first[ic-1];
+  first[0] = 0;
+}
+//------------------------------------------------------------------------
+Int_t AliITStrackerMI::AliITSlayer::GetGridCellY(Double_t y) const {
+  //
+  // grid cell in y, periodic in the layer circumference
+  //
+  Int_t iy = Int_t(TMath::Floor(y/fGridDy)) % fNGridY;
+  return iy<0 ? iy+fNGridY : iy;
+}
+//------------------------------------------------------------------------
+Int_t AliITStrackerMI::AliITSlayer::GetGridCellZ(Double_t z) const {
+  //
+  // grid cell in z, z outside of the cluster range goes to the first/last cell
+  //
+  Double_t t = (z-fGridZ0)/fGridDz;
+  if (t<0) return 0;
+  if (t>=fNGridZ) return fNGridZ-1;
+  return Int_t(t);
+}
+//------------------------------------------------------------------------
+void AliITStrackerMI::AliITSlayer::
+SelectGridCells(Double_t zmin,Double_t zmax,Double_t ymin,Double_t ymax) {
+  //
+  // Collect the clusters of the grid cells overlapping the window, ordered 
+  // in z as in the full cluster list. If the window falls into the same
+  // cells as the previous one (the other hypotheses of the same track on
+  // this layer, mostly) the candidates are kept.
+  //
+  Int_t iy0 = Int_t(TMath::Floor(ymin/fGridDy));
+  Int_t iy1 = Int_t(TMath::Floor(ymax/fGridDy));
+  if (iy1-iy0+1>=fNGridY) {
+    iy0 = 0;
+    iy1 = fNGridY-1;
+  } else {
+    Int_t shift = GetGridCellY(ymin)-iy0;
+    iy0 += shift;
+    iy1 += shift;
+  }
+  Int_t iz0 = GetGridCellZ(zmin);
+  Int_t iz1 = GetGridCellZ(zmax);
+  if (iy0==fGridCellRange[0] && iy1==fGridCellRange[1] && 
+      iz0==fGridCellRange[2] && iz1==fGridCellRange[3]) return;
+  fGridCellRange[0] = iy0;
+  fGridCellRange[1] = iy1;
+  fGridCellRange[2] = iz0;
+  fGridCellRange[3] = iz1;
+  //
+  fNGridCand = 0;
+  for (Int_t iy=iy0;iy<=iy1;iy++) {
+    Int_t row = (iy<fNGridY ? iy : iy-fNGridY)*fNGridZ;
+    for (Int_t j=fGridFirst[row+iz0];j<fGridFirst[row+iz1+1];j++) fGridCand[fNGridCand++] = fGridIndex[j];
+  }
+  // cluster indices follow z, merge the rows
+  if (iy1>iy0) std::sort(fGridCand,fGridCand+fNGridCand);
 }
 //------------------------------------------------------------------------
 Int_t AliITStrackerMI::AliITSlayer::FindClusterIndex(Float_t z) const {
@@ -2063,6 +2184,16 @@ SelectClusters(Double_t zmin,Double_t zmax,Double_t ymin, Double_t ymax) {
   fZcs  = fZ;
   fNcs  = fN;
   //
+  // grid: candidates from the cells of the window, cut on the exact window
+  if (fUseGrid && fNGridY>0) {
+    SelectGridCells(fZmin,fZmax,fYmin,fYmax);
+    fI        = 0;
+    fImax     = fNGridCand;
+    fSkip     = 0;
+    fAccepted = 0;
+    return;
+  }
+  //
   //is in 20 slice?
   if (fCurrentSlice<0&&TMath::Abs(fYmax-fYmin)<1.49*fDy20){
     Int_t slice = int(0.5+(ymiddle-fYB[0])/fDy20);
@@ -2173,22 +2304,17 @@ const AliITSRecPoint *AliITStrackerMI::AliITSlayer::GetNextCluster(Int_t &ci,Boo
   // This function returns clusters within the "window" 
   //--------------------------------------------------------------------
 
-  if (fCurrentSlice<0) {
-    Double_t rpi2 = 2.*fR*TMath::Pi();
+  if (fUseGrid && fNGridY>0) {
+    for (Int_t k=fI; k<fImax; k++) {
+      Int_t i = fGridCand[k];
+      if (!IsInWindow(i)) continue;
+      ci=i;
+      if (!test) fI=k+1;
+      return fClusters[i];
+    }
+  } else if (fCurrentSlice<0) {
     for (Int_t i=fI; i<fImax; i++) {
-      Double_t y = fY[i];
-      Double_t z = fZ[i];
-      if (fYmax<y) y -= rpi2;
-      if (fYmin>y) y += rpi2;
-      if (y<fYmin) continue;
-      if (y>fYmax) continue;
-      // AD
-      // skip clusters that are in "extended" road but they 
-      // 3sigma error does not touch the original road
-      if (z+fNMaxSigmaCl*TMath::Sqrt(fClusters[i]->GetSigmaZ2())<fZmin+fNMaxSigmaCl*fMaxSigmaClZ) continue;
-      if (z-fNMaxSigmaCl*TMath::Sqrt(fClusters[i]->GetSigmaZ2())>fZmax-fNMaxSigmaCl*fMaxSigmaClZ) continue;
-      //
-      if (TMath::Abs(fClusters[i]->GetQ())<1.e-13 && fSkip==2) continue;
+      if (!IsInWindow(i)) continue;
       ci=i;
       if (!test) fI=i+1;
       return fClusters[i];
@@ -2206,6 +2332,28 @@ const AliITSRecPoint *AliITStrackerMI::AliITSlayer::GetNextCluster(Int_t &ci,Boo
   return 0;
 }
 //------------------------------------------------------------------------
+Bool_t AliITStrackerMI::AliITSlayer::IsInWindow(Int_t i) const
+{
+  //--------------------------------------------------------------------
+  // Check if the cluster i of the full list is inside the "window"
+  //--------------------------------------------------------------------
+  Double_t rpi2 = 2.*fR*TMath::Pi();
+  Double_t y = fY[i];
+  Double_t z = fZ[i];
+  if (fYmax<y) y -= rpi2;
+  if (fYmin>y) y += rpi2;
+  if (y<fYmin) return kFALSE;
+  if (y>fYmax) return kFALSE;
+  // AD
+  // skip clusters that are in "extended" road but they 
+  // 3sigma error does not touch the original road
+  if (z+fNMaxSigmaCl*TMath::Sqrt(fClusters[i]->GetSigmaZ2())<fZmin+fNMaxSigmaCl*fMaxSigmaClZ) return kFALSE;
+  if (z-fNMaxSigmaCl*TMath::Sqrt(fClusters[i]->GetSigmaZ2())>fZmax-fNMaxSigmaCl*fMaxSigmaClZ) return kFALSE;
+  //
+  if (TMath::Abs(fClusters[i]->GetQ())<1.e-13 && fSkip==2) return kFALSE;
+  return kTRUE;
+}
+//------------------------------------------------------------------------
 Double_t AliITStrackerMI::AliITSlayer::GetThickness(Double_t y,Double_t z,Double_t &x0)
 const {
   //--------------------------------------------------------------------
@@ -23,6 +23,7 @@ class AliITSDetTypeRec;
 class AliPlaneEff;
 
 #include <TObjArray.h>
+#include <TArrayI.h>
 
 #include "AliITStrackMI.h"
 #include "AliITSRecPoint.h"
@@ -151,7 +152,14 @@ public:
     Int_t GetClusterTracks(Int_t i, Int_t j) const {return int(fClusterTracks[i][j])-1;}
     void SetClusterTracks(Int_t i, Int_t j, Int_t c) {fClusterTracks[i][j]=c+1;}
     Int_t FindClusterForLabel(Int_t label, Int_t *store) const; //RS
+    void  SetUseGrid(Bool_t v=kTRUE) {fUseGrid=v;}
+    Bool_t GetUseGrid() const {return fUseGrid;}
   protected:
+    void  BuildGrid();
+    void  SelectGridCells(Double_t zmin,Double_t zmax,Double_t ymin,Double_t ymax);
+    Int_t GetGridCellY(Double_t y) const;
+    Int_t GetGridCellZ(Double_t z) const;
+    Bool_t IsInWindow(Int_t i) const;
     AliITSlayer(const AliITSlayer& layer);
     AliITSlayer & operator=(const AliITSlayer& layer){
       this->~AliITSlayer();new(this) AliITSlayer(layer);
@@ -214,6 +222,18 @@ public:
     Double_t fMaxSigmaClY; // maximum cluster error Y (to enlarge road)
     Double_t fMaxSigmaClZ; // maximum cluster error Z (to enlarge road)
     Double_t fNMaxSigmaCl; // number of sigma for road enlargement
+    //
+    Bool_t  fUseGrid;                                     // search the window through the y-z grid instead of the slices
+    Int_t   fNGridY;                                      // number of grid cells in y over the full circle, 0 if no grid
+    Int_t   fNGridZ;                                      // number of grid cells in z
+    Float_t fGridDy;                                      // cell size in y
+    Float_t fGridDz;                                      // cell size in z
+    Float_t fGridZ0;                                      // lower z edge of the grid
+    TArrayI fGridFirst;                                   // first entry of each cell in fGridIndex, y-major
+    Int_t   fGridIndex[AliITSRecoParam::kMaxClusterPerLayer]; // cluster indices ordered by cell, by z inside a cell
+    Int_t   fGridCand[AliITSRecoParam::kMaxClusterPerLayer];  // clusters of the cells of the window, by z
+    Int_t   fNGridCand;                                   // number of clusters in fGridCand
+    Int_t   fGridCellRange[4];                            // y and z cells of fGridCand, reused by the next window
   };
   AliITStrackerMI::AliITSlayer    & GetLayer(Int_t layer) const;
   AliITStrackerMI::AliITSdetector & GetDetector(Int_t layer, Int_t n) const {return GetLayer(layer).GetDetector(n); }
@@ -7,13 +7,9 @@ class AliITSUCACell {
 public:
 	AliITSUCACell(int xx = 0u,int yy = 0u, int zz = 0u, int dd0 = 0,
                 int dd1 = 0, float curv = 0.f, float n[3] = 0x0)
-	  : f1OverR(curv), fd0(dd0), fd1(dd1), fN(), fVector()
+	  : f1OverR(curv), fd0(dd0), fd1(dd1), fN(), fX(xx), fY(yy), fZ(zz), fLevel(1),
+	    fFirstNeighbour(0), fNNeighbours(0)
 	{
-		fVector.reserve(4);
-		fVector.push_back(xx);
-		fVector.push_back(yy);
-    fVector.push_back(zz);
-		fVector.push_back(1u);
     if(n) {
       fN[0] = n[0];
       fN[1] = n[1];
@@ -21,41 +17,32 @@ public:
     }
 	}
 
-	int x() const { return fVector[0]; }
-	int y() const { return fVector[1]; }
-  int z() const { return fVector[2]; }
+	int x() const { return fX; }
+	int y() const { return fY; }
+  int z() const { return fZ; }
 	int d0() const { return fd0; }
   int d1() const { return fd1; }
-  int GetLevel() const { return fVector[3]; }
+  int GetLevel() const { return fLevel; }
   float GetCurvature() const { return f1OverR; }
   float* GetN() { return fN; }
+  const float* GetN() const { return fN; }
   
-	void SetLevel(int lev) { fVector[3] = lev; }
+	void SetLevel(int lev) { fLevel = lev; }
 
-	int operator()(const int i) { return fVector[4 + i]; }
-
-	size_t NumberOfNeighbours() { return (fVector.size() - 4u); }
-
-	bool Combine(AliITSUCACell &neigh, int idd)
-	{
-    // From outside inward
-		if (this->y() == neigh.z() && this->x() == neigh.y()) // Cells sharing two points
-		{
-      fVector.push_back(idd);
-      if (neigh.GetLevel() + 1 > GetLevel())
-      {
-        SetLevel(neigh.GetLevel() + 1u);
-      }
-      return true;
-    }
-    return false;
-  }
+  // The neighbours (inner cells sharing two points) are kept by the tracker
+  // in one flat array per layer, the cell only knows its slice of it
+  int GetFirstNeighbour() const { return fFirstNeighbour; }
+	size_t NumberOfNeighbours() const { return fNNeighbours; }
+  void SetNeighbours(int first, int n) { fFirstNeighbour = first; fNNeighbours = n; }
 
 private:
   float f1OverR;
   int fd0,fd1;
   float fN[3];
-	std::vector<int> fVector;
+  int fX,fY,fZ;
+  int fLevel;
+  int fFirstNeighbour;
+  int fNNeighbours;
 };
 
 class AliITSUCARoad {
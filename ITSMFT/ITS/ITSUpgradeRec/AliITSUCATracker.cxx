@@ -21,6 +21,9 @@
 // STD
 #include <algorithm>
 #include <cassert>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 // ROOT
 #include <TBranch.h>
 #include <TMath.h>
@@ -112,6 +115,13 @@ static inline bool CompareAngles(float alpha, float beta, float tolerance)
 	return (delta < tolerance || TMath::Abs(delta - TMath::TwoPi()) < tolerance);
 }
 
+//__________________________________________________________________________________________________
+static inline bool DoubletBefore(const Doublets &d, int cluster)
+{
+  // Order of the doublets of a layer, sorted by their inner cluster
+  return d.x < cluster;
+}
+
 //__________________________________________________________________________________________________
 AliITSUCATracker::AliITSUCATracker(AliITSUReconstructor* rec) : AliITSUTrackerGlo(rec)
 #ifdef _TUNING_
@@ -129,6 +139,14 @@ AliITSUCATracker::AliITSUCATracker(AliITSUReconstructor* rec) : AliITSUTrackerGl
 ,fZCut(0.5f)
 ,fCandidates()
 ,fSAonly(kTRUE)
+,fNThreads(1)
+,fNeighbours()
+,fDoubletLUT()
+,fCellLUT()
+,fCellLUTFirst()
+,fCellLUTNext()
+,fSectorDoublets()
+,fSectorCells()
 ,fCPhi()
 ,fCDTanL()
 ,fCDPhi()
@@ -292,7 +310,7 @@ void AliITSUCATracker::CellsTreeTraversal(vector<AliITSUCARoad> &roads,
   for (size_t iN = 0; iN < fCells[doubl][iD].NumberOfNeighbours(); ++iN)
   {
     const int currD = doubl - 1;
-    const int neigh = fCells[doubl][iD](iN);
+    const int neigh = fNeighbours[doubl][fCells[doubl][iD].GetFirstNeighbour() + iN];
 
     // [3] for each neighbour one road
     if (iN > 0)
@@ -439,7 +457,7 @@ void AliITSUCATracker::FindTracksCA(int iteration)
         // [2] Loop on current cell neighbours
         for(size_t iN = 0; iN < fCells[iCL][iCell].NumberOfNeighbours(); ++iN) {
           const int currD = iCL - 1;
-          const int neigh = fCells[iCL][iCell](iN);
+          const int neigh = fNeighbours[iCL][fCells[iCL][iCell].GetFirstNeighbour() + iN];
           // [3] if more than one neighbour => more than one road, one road for each neighbour
           if(iN > 0)
           {
@@ -554,6 +572,11 @@ Int_t AliITSUCATracker::LoadClusters(TTree *cluTree)
 //__________________________________________________________________________________________________
 void AliITSUCATracker::MakeCells(int iteration)
 {
+  // Doublets, cells and their neighbours.
+  // Doublets and cells are built per phi sector (the phi bins of the inner layer), each sector
+  // in its own buffer; the buffers are appended in phi order, so the result is the same as for
+  // a single loop over the clusters whatever the number of threads. All the containers keep their
+  // memory between the iterations and the events.
 #ifdef _TUNING_
   unsigned int numberOfGoodDoublets = 0, totalNumberOfDoublets = 0;
   unsigned int numberOfGoodCells = 0, totalNumberOfCells = 0;
@@ -561,134 +584,156 @@ void AliITSUCATracker::MakeCells(int iteration)
 #endif
 
   SetCuts(iteration);
-  if (iteration >= 1) {
 #ifdef _TUNING_
+  if (iteration >= 1)
     ResetHistos();
 #endif
-    for (int i = 0; i < 5; ++i)
-      vector<AliITSUCACell>().swap(fCells[i]);
-    for (int i = 0; i < 6; ++i)
-      vector<Doublets>().swap(fDoublets[i]);
+  for (int i = 0; i < 5; ++i) {
+    fCells[i].clear();
+    fNeighbours[i].clear();
+    fDoubletLUT[i].clear();
   }
+  for (int i = 0; i < 6; ++i)
+    fDoublets[i].clear();
+
+  int nThreads = fNThreads;
+#if defined(_TUNING_) || !defined(_OPENMP)
+  nThreads = 1; // serial without OpenMP, and for the tuning histograms which are not thread safe
+#endif
+  if (nThreads < 1) nThreads = 1;
 
   // Trick to speed up the navigation of the doublets array. The lookup table is build like:
-  // dLUT[l][i] = n;
+  // fDoubletLUT[l][i] = n;
   // where n is the index inside fDoublets[l+1] of the first doublets that uses the point
   // fLayer[l+1][i]
-  vector<int> dLUT[5];
   for (int iL = 0; iL < 6; ++iL) {
     if (fLayer[iL].GetNClusters() == 0) continue;
     if (iL < 5)
-      dLUT[iL].resize(fLayer[iL + 1].GetNClusters(),-1);
-    if (dLUT[iL - 1].size() == 0u)
+      fDoubletLUT[iL].assign(fLayer[iL + 1].GetNClusters(),-1);
+    if (iL > 0 && fDoubletLUT[iL - 1].size() == 0u)
       continue;
-    for (int iC = 0; iC < fLayer[iL].GetNClusters(); ++iC) {
-      ClsInfo_t* cls = fLayer[iL].GetClusterInfo(iC);
-      if (fUsedClusters[iL][cls->index]) {
-        continue;
-      }
-      const float tanL = (cls->z - GetZ()) / cls->r;
-      const float extz = tanL * (fgkR[iL + 1] - cls->r) + cls->z;
-      const int nClust = fLayer[iL + 1].SelectClusters(extz - 2 * fCZ, extz + 2 * fCZ,
-                                                       cls->phi - fCPhi, cls->phi + fCPhi);
-      bool first = true;
-
-      for (int iC2 = 0; iC2 < nClust; ++iC2) {
-        const int iD2 = fLayer[iL + 1].GetNextClusterInfoID();
-        ClsInfo_t* cls2 = fLayer[iL + 1].GetClusterInfo(iD2);
-        if (fUsedClusters[iL + 1][cls2->index]) {
+    const int nSectors = fLayer[iL].GetNPhiBins();
+    if ((int)fSectorDoublets.size() < nSectors) fSectorDoublets.resize(nSectors);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+    for (int iS = 0; iS < nSectors; ++iS) {
+      vector<Doublets> &doublets = fSectorDoublets[iS];
+      doublets.clear();
+      vector<int> bins;
+      const int lastC = fLayer[iL].GetFirstClusterInPhiBin(iS + 1);
+      for (int iC = fLayer[iL].GetFirstClusterInPhiBin(iS); iC < lastC; ++iC) {
+        ClsInfo_t* cls = fLayer[iL].GetClusterInfo(iC);
+        if (fUsedClusters[iL][cls->index]) {
           continue;
         }
-        const float dz = tanL * (cls2->r - cls->r) + cls->z - cls2->z;
-        if (TMath::Abs(dz) < fCDZ[iL] && CompareAngles(cls->phi, cls2->phi, fCPhi)) {
-          if (first && iL > 0) {
-            dLUT[iL - 1][iC] = fDoublets[iL].size();
-            first = false;
-          }
-          const float dTanL = (cls->z - cls2->z) / (cls->r - cls2->r);
-          const float phi = TMath::ATan2(cls->y - cls2->y, cls->x - cls2->x);
-          fDoublets[iL].push_back(Doublets(iC,iD2,dTanL,phi));
+        const float tanL = (cls->z - GetZ()) / cls->r;
+        const float extz = tanL * (fgkR[iL + 1] - cls->r) + cls->z;
+        fLayer[iL + 1].SelectBins(extz - 2 * fCZ, extz + 2 * fCZ,
+                                  cls->phi - fCPhi, cls->phi + fCPhi, bins);
+
+        for (size_t iB = 0; iB < bins.size(); ++iB) {
+          int firstC2 = 0;
+          const int nC2 = fLayer[iL + 1].GetBinClusters(bins[iB],firstC2);
+          for (int iD2 = firstC2; iD2 < firstC2 + nC2; ++iD2) {
+            ClsInfo_t* cls2 = fLayer[iL + 1].GetClusterInfo(iD2);
+            if (fUsedClusters[iL + 1][cls2->index]) {
+              continue;
+            }
+            const float dz = tanL * (cls2->r - cls->r) + cls->z - cls2->z;
+            if (TMath::Abs(dz) < fCDZ[iL] && CompareAngles(cls->phi, cls2->phi, fCPhi)) {
+              const float dTanL = (cls->z - cls2->z) / (cls->r - cls2->r);
+              const float phi = TMath::ATan2(cls->y - cls2->y, cls->x - cls2->x);
+              doublets.push_back(Doublets(iC,iD2,dTanL,phi));
 #ifdef _TUNING_
-          if (fLayer[iL].GetClusterSorted(iC)->GetLabel(0) ==
-              fLayer[iL + 1].GetClusterSorted(iD2)->GetLabel(0) &&
-              fLayer[iL].GetClusterSorted(iC)->GetLabel(0) > 0) {
-            numberOfGoodDoublets++;
-            fGDZ[iL]->Fill(dz);
-            fGDXY[iL]->Fill(fabs(cls->phi - cls2->phi));
-          } else {
-            fFDZ[iL]->Fill(dz);
-            fFDXY[iL]->Fill(fabs(cls->phi - cls2->phi));
-          }
-          totalNumberOfDoublets++;
+              if (fLayer[iL].GetClusterSorted(iC)->GetLabel(0) ==
+                  fLayer[iL + 1].GetClusterSorted(iD2)->GetLabel(0) &&
+                  fLayer[iL].GetClusterSorted(iC)->GetLabel(0) > 0) {
+                numberOfGoodDoublets++;
+                fGDZ[iL]->Fill(dz);
+                fGDXY[iL]->Fill(fabs(cls->phi - cls2->phi));
+              } else {
+                fFDZ[iL]->Fill(dz);
+                fFDXY[iL]->Fill(fabs(cls->phi - cls2->phi));
+              }
+              totalNumberOfDoublets++;
 #endif
+            }
+          }
         }
       }
-      fLayer[iL + 1].ResetFoundIterator();
+    }
+    for (int iS = 0; iS < nSectors; ++iS)
+      fDoublets[iL].insert(fDoublets[iL].end(),fSectorDoublets[iS].begin(),fSectorDoublets[iS].end());
+    if (iL > 0) {
+      for (int iD = (int)fDoublets[iL].size() - 1; iD >= 0; --iD)
+        fDoubletLUT[iL - 1][fDoublets[iL][iD].x] = iD;
     }
   }
 
-  // Trick to speed up the navigation of the cells array. The lookup table is build like:
-  // tLUT[l][i] = n;
-  // where n is the index inside fCells[l+1] of the first cells that uses the doublet
-  // fDoublets[l+1][i]
-  vector<int> tLUT[4];
-  tLUT[0].resize(fDoublets[1].size(),-1);
-  tLUT[1].resize(fDoublets[2].size(),-1);
-  tLUT[2].resize(fDoublets[3].size(),-1);
-  tLUT[3].resize(fDoublets[4].size(),-1);
-
+  // Cells: pairs of doublets sharing the middle point, split in the phi sectors of the inner point
   for (int iD = 0; iD < 5; ++iD)
   {
     if (fDoublets[iD + 1].size() == 0u || fDoublets[iD].size() == 0u) continue;
-
-    for (size_t iD0 = 0; iD0 < fDoublets[iD].size(); ++iD0)
+    const int nSectors = fLayer[iD].GetNPhiBins();
+    if ((int)fSectorCells.size() < nSectors) fSectorCells.resize(nSectors);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+    for (int iS = 0; iS < nSectors; ++iS)
     {
-      const int idx = fDoublets[iD][iD0].y;
-      bool first = true;
-      if (dLUT[iD][idx] == -1) continue;
-      for (size_t iD1 = dLUT[iD][idx]; iD1 < fDoublets[iD + 1].size(); ++iD1)
+      vector<AliITSUCACell> &cells = fSectorCells[iS];
+      cells.clear();
+      const size_t firstD = std::lower_bound(fDoublets[iD].begin(),fDoublets[iD].end(),
+                                             fLayer[iD].GetFirstClusterInPhiBin(iS),DoubletBefore) - fDoublets[iD].begin();
+      const size_t lastD = std::lower_bound(fDoublets[iD].begin(),fDoublets[iD].end(),
+                                            fLayer[iD].GetFirstClusterInPhiBin(iS + 1),DoubletBefore) - fDoublets[iD].begin();
+      for (size_t iD0 = firstD; iD0 < lastD; ++iD0)
       {
-        if (idx != fDoublets[iD + 1][iD1].x) break;
-        if (TMath::Abs(fDoublets[iD][iD0].tanL - fDoublets[iD + 1][iD1].tanL) < fCDTanL &&
-            CompareAngles(fDoublets[iD][iD0].phi,fDoublets[iD + 1][iD1].phi,fCDPhi)) {
-          const float tan = 0.5f * (fDoublets[iD][iD0].tanL + fDoublets[iD + 1][iD1].tanL);
-          const float extz = -tan * fLayer[iD][fDoublets[iD][iD0].x]->r +
-                              fLayer[iD][fDoublets[iD][iD0].x]->z;
-          if (fabs(extz - GetZ()) < fCDCAz[iD]) {
+        const int idx = fDoublets[iD][iD0].y;
+        if (fDoubletLUT[iD][idx] == -1) continue;
+        for (size_t iD1 = fDoubletLUT[iD][idx]; iD1 < fDoublets[iD + 1].size(); ++iD1)
+        {
+          if (idx != fDoublets[iD + 1][iD1].x) break;
+          if (TMath::Abs(fDoublets[iD][iD0].tanL - fDoublets[iD + 1][iD1].tanL) < fCDTanL &&
+              CompareAngles(fDoublets[iD][iD0].phi,fDoublets[iD + 1][iD1].phi,fCDPhi)) {
+            const float tan = 0.5f * (fDoublets[iD][iD0].tanL + fDoublets[iD + 1][iD1].tanL);
+            const float extz = -tan * fLayer[iD][fDoublets[iD][iD0].x]->r +
+                                fLayer[iD][fDoublets[iD][iD0].x]->z;
+            if (fabs(extz - GetZ()) < fCDCAz[iD]) {
 #ifdef _TUNING_
-            fGood = (fLayer[iD].GetClusterSorted(fDoublets[iD][iD0].x)->GetLabel(0) ==
-                     fLayer[iD + 1].GetClusterSorted(fDoublets[iD][iD0].y)->GetLabel(0) &&
-                     fLayer[iD].GetClusterSorted(fDoublets[iD][iD0].x)->GetLabel(0) ==
-                     fLayer[iD + 2].GetClusterSorted(fDoublets[iD + 1][iD1].y)->GetLabel(0) &&
-                     fLayer[iD].GetClusterSorted(fDoublets[iD][iD0].x)->GetLabel(0) > 0);
+              fGood = (fLayer[iD].GetClusterSorted(fDoublets[iD][iD0].x)->GetLabel(0) ==
+                       fLayer[iD + 1].GetClusterSorted(fDoublets[iD][iD0].y)->GetLabel(0) &&
+                       fLayer[iD].GetClusterSorted(fDoublets[iD][iD0].x)->GetLabel(0) ==
+                       fLayer[iD + 2].GetClusterSorted(fDoublets[iD + 1][iD1].y)->GetLabel(0) &&
+                       fLayer[iD].GetClusterSorted(fDoublets[iD][iD0].x)->GetLabel(0) > 0);
 #endif
-            float curv, n[3];
-            if (CellParams(iD,fLayer[iD][fDoublets[iD][iD0].x],fLayer[iD + 1][fDoublets[iD][iD0].y],
-                           fLayer[iD + 2][fDoublets[iD + 1][iD1].y],curv,n)) {
-              if (first && iD > 0) {
-                tLUT[iD - 1][iD0] = fCells[iD].size();
-                first = false;
-              }
-              fCells[iD].push_back(AliITSUCACell(fDoublets[iD][iD0].x,fDoublets[iD][iD0].y,
-                                                 fDoublets[iD + 1][iD1].y,iD0,iD1,curv,n));
+              float curv, n[3];
+              if (CellParams(iD,fLayer[iD][fDoublets[iD][iD0].x],fLayer[iD + 1][fDoublets[iD][iD0].y],
+                             fLayer[iD + 2][fDoublets[iD + 1][iD1].y],curv,n)) {
+                cells.push_back(AliITSUCACell(fDoublets[iD][iD0].x,fDoublets[iD][iD0].y,
+                                              fDoublets[iD + 1][iD1].y,iD0,iD1,curv,n));
 #ifdef _TUNING_
-              if (fGood) {
-                fTan->Fill(TMath::Abs(fDoublets[iD][iD0].tanL - fDoublets[iD + 1][iD1].tanL));
-                fPhi->Fill(TMath::Abs(fDoublets[iD][iD0].phi - fDoublets[iD + 1][iD1].phi));
-                fGDCAZ[iD]->Fill(fabs(extz-GetZ()));
-                numberOfGoodCells++;
-              } else {
-                fTanF->Fill(TMath::Abs(fDoublets[iD][iD0].tanL - fDoublets[iD + 1][iD1].tanL));
-                fPhiF->Fill(TMath::Abs(fDoublets[iD][iD0].phi - fDoublets[iD + 1][iD1].phi));
-                fFDCAZ[iD]->Fill(fabs(extz - GetZ()));
-              }
-              totalNumberOfCells++;
+                if (fGood) {
+                  fTan->Fill(TMath::Abs(fDoublets[iD][iD0].tanL - fDoublets[iD + 1][iD1].tanL));
+                  fPhi->Fill(TMath::Abs(fDoublets[iD][iD0].phi - fDoublets[iD + 1][iD1].phi));
+                  fGDCAZ[iD]->Fill(fabs(extz-GetZ()));
+                  numberOfGoodCells++;
+                } else {
+                  fTanF->Fill(TMath::Abs(fDoublets[iD][iD0].tanL - fDoublets[iD + 1][iD1].tanL));
+                  fPhiF->Fill(TMath::Abs(fDoublets[iD][iD0].phi - fDoublets[iD + 1][iD1].phi));
+                  fFDCAZ[iD]->Fill(fabs(extz - GetZ()));
+                }
+                totalNumberOfCells++;
 #endif
+              }
             }
           }
         }
       }
     }
+    for (int iS = 0; iS < nSectors; ++iS)
+      fCells[iD].insert(fCells[iD].end(),fSectorCells[iS].begin(),fSectorCells[iS].end());
   }
 
   // Adjacent cells: cells that share 2 points. In the following code adjacent cells are combined.
@@ -696,30 +741,61 @@ void AliITSUCATracker::MakeCells(int iteration)
   // to the list of neighbours of the outermost cell. When the cell is added to the neighbours of
   // the outermost cell the "level" of the latter is set to the level of the innermost one + 1.
   // ( only if $(level of the innermost) + 1 > $(level of the outermost) )
+  // The inner cells are sorted by their outer doublet (fCellLUT), so that each outer cell finds
+  // its candidates, in increasing order, through its inner doublet. The outer cells are then
+  // independent of each other; their neighbours are stored in the flat array fNeighbours.
   for (int iD = 0; iD < 4; ++iD) {
-    if (fCells[iD + 1].size() == 0u || tLUT[iD].size() == 0u) continue; // TODO: dealing with holes
-    for (size_t c0 = 0; c0 < fCells[iD].size(); ++c0) {
-      const int idx = fCells[iD][c0].d1();
-      if (tLUT[iD][idx] == -1) continue;
-      for (size_t c1 = tLUT[iD][idx]; c1 < fCells[iD + 1].size(); ++c1) {
-        if (idx != fCells[iD + 1][c1].d0()) break;
+    if (fCells[iD + 1].size() == 0u || fCells[iD].size() == 0u) continue; // TODO: dealing with holes
+    const int nDoublets = fDoublets[iD + 1].size();
+    fCellLUTFirst.assign(nDoublets + 1,0);
+    for (size_t c0 = 0; c0 < fCells[iD].size(); ++c0)
+      fCellLUTFirst[fCells[iD][c0].d1() + 1]++;
+    for (int i = 0; i < nDoublets; ++i)
+      fCellLUTFirst[i + 1] += fCellLUTFirst[i];
+    fCellLUTNext.assign(fCellLUTFirst.begin(),fCellLUTFirst.end() - 1);
+    fCellLUT.resize(fCells[iD].size());
+    for (size_t c0 = 0; c0 < fCells[iD].size(); ++c0)
+      fCellLUT[fCellLUTNext[fCells[iD][c0].d1()]++] = c0;
+
+    int nCandidates = 0;
+    for (size_t c1 = 0; c1 < fCells[iD + 1].size(); ++c1) {
+      const int idx = fCells[iD + 1][c1].d0();
+      fCells[iD + 1][c1].SetNeighbours(nCandidates,0);
+      nCandidates += fCellLUTFirst[idx + 1] - fCellLUTFirst[idx];
+    }
+    fNeighbours[iD + 1].resize(nCandidates);
+
+    const int nCells = fCells[iD + 1].size();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic,256)
+#endif
+    for (int c1 = 0; c1 < nCells; ++c1) {
+      AliITSUCACell &cell = fCells[iD + 1][c1];
+      const int idx = cell.d0();
+      const int first = cell.GetFirstNeighbour();
+      int nNeighbours = 0;
+      int level = cell.GetLevel();
+      for (int iN = fCellLUTFirst[idx]; iN < fCellLUTFirst[idx + 1]; ++iN) {
+        const int c0 = fCellLUT[iN];
 #ifdef _TUNING_
         fGood = (fLayer[iD].GetClusterSorted(fCells[iD][c0].x())->GetLabel(0) ==
                  fLayer[iD + 1].GetClusterSorted(fCells[iD][c0].y())->GetLabel(0) &&
                  fLayer[iD + 1].GetClusterSorted(fCells[iD][c0].y())->GetLabel(0) ==
                  fLayer[iD + 2].GetClusterSorted(fCells[iD][c0].z())->GetLabel(0) &&
                  fLayer[iD + 2].GetClusterSorted(fCells[iD][c0].z())->GetLabel(0) ==
-                 fLayer[iD + 3].GetClusterSorted(fCells[iD + 1][c1].z())->GetLabel(0) &&
+                 fLayer[iD + 3].GetClusterSorted(cell.z())->GetLabel(0) &&
                  fLayer[iD].GetClusterSorted(fCells[iD][c0].x())->GetLabel(0) > 0);
 #endif
-        float* n0 = fCells[iD][c0].GetN();
-        float* n1 = fCells[iD + 1][c1].GetN();
+        const float* n0 = fCells[iD][c0].GetN();
+        const float* n1 = cell.GetN();
         const float dn2 = ((n0[0] - n1[0]) * (n0[0] - n1[0]) + (n0[1] - n1[1]) * (n0[1] - n1[1]) +
                            (n0[2] - n1[2]) * (n0[2] - n1[2]));
-        const float dp = fabs(fCells[iD][c0].GetCurvature() - fCells[iD + 1][c1].GetCurvature());
+        const float dp = fabs(fCells[iD][c0].GetCurvature() - cell.GetCurvature());
         if (dn2 < fCDN[iD] && dp < fCDP[iD]) {
+          fNeighbours[iD + 1][first + nNeighbours++] = c0;
+          if (fCells[iD][c0].GetLevel() + 1 > level)
+            level = fCells[iD][c0].GetLevel() + 1;
 #ifdef _TUNING_
-          assert(fCells[iD + 1][c1].Combine(fCells[iD][c0], c0));
           if (fGood) {
             fGoodCombChi2[iD]->Fill(dp);
             fGoodCombN[iD]->Fill(dn2);
@@ -729,11 +805,11 @@ void AliITSUCATracker::MakeCells(int iteration)
             fFakeCombN[iD]->Fill(dn2);
             cellsWrongCombinations++;
           }
-#else
-          fCells[iD + 1][c1].Combine(fCells[iD][c0], c0);
 #endif
         }
       }
+      cell.SetNeighbours(first,nNeighbours);
+      cell.SetLevel(level);
     }
   }
 #ifdef _TUNING_
@@ -927,6 +1003,16 @@ void AliITSUCATracker::SetCuts(int it)
   }
 }
 
+//__________________________________________________________________________________________________
+void AliITSUCATracker::SetNThreads(Int_t n)
+{
+  // Number of threads building the doublets and the cells, the tracks do not depend on it
+#ifndef _OPENMP
+  if (n > 1) AliWarning("Compiled without OpenMP support, the cells are built serially");
+#endif
+  fNThreads = n;
+}
+
 //__________________________________________________________________________________________________
 void AliITSUCATracker::UnloadClusters()
 {
@@ -940,6 +1026,7 @@ void AliITSUCATracker::UnloadClusters()
   }
   for (int i = 0; i < 5; ++i) {
     fCells[i].clear();
+    fNeighbours[i].clear();
   }
   for (int i = 0; i < 4; ++i)
   {
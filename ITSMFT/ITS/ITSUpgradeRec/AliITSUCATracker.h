@@ -64,8 +64,10 @@ public:
   // Possibly, other public functions
   Double_t GetMaterialBudget(const double* p0, const double* p1, double& x2x0, double& rhol) const;
   Bool_t   GetSAonly() const { return fSAonly; }
+  Int_t    GetNThreads() const { return fNThreads; }
   void     SetChi2Cut(float cut) { fChi2Cut = cut; }
   void     SetPhiCut(float cut) { fPhiCut = cut; }
+  void     SetNThreads(Int_t n);
   void     SetSAonly(Bool_t sa = kTRUE) { fSAonly = sa; }
   void     SetZCut(float cut) { fZCut = cut; }
 
@@ -119,6 +121,14 @@ private:
   vector<AliITSUCACell>           fCells[5];
   TClonesArray                   *fCandidates[4];
   Bool_t                          fSAonly;             // kTRUE if the standalone tracking only
+  Int_t                           fNThreads;           // threads building doublets and cells
+  vector<int>                     fNeighbours[5];      //! neighbours of the cells, flat per layer
+  vector<int>                     fDoubletLUT[5];      //! first doublet of each cluster of the next layer
+  vector<int>                     fCellLUT;            //! inner cells sorted by their second doublet
+  vector<int>                     fCellLUTFirst;       //! first entry in fCellLUT of each doublet
+  vector<int>                     fCellLUTNext;        //! fill position in fCellLUT of each doublet
+  vector< vector<Doublets> >      fSectorDoublets;     //! doublets of each phi sector
+  vector< vector<AliITSUCACell> > fSectorCells;        //! cells of each phi sector
 
   
   // Cuts
@@ -136,7 +146,7 @@ private:
   static const int                fgkNumberOfIterations;
   static const float              fgkR[7];
   //
-  ClassDef(AliITSUCATracker,2)   //ITSU stand-alone tracker
+  ClassDef(AliITSUCATracker,3)   //ITSU stand-alone tracker
 };
 
 #endif // ALIITSUCATRACKER_H
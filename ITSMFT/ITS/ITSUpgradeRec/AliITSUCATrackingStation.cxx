@@ -42,10 +42,6 @@ AliITSUCATrackingStation::AliITSUCATrackingStation()
 ,fDPhiInv(-1)
 ,fNZBins(20)
 ,fNPhiBins(20)
-,fQueryZBmin(-1)
-,fQueryZBmax(-1)
-,fQueryPhiBmin(-1)
-,fQueryPhiBmax(-1)
 ,fBins(0)
 ,fOccBins(0)
 ,fNOccBins(0)
@@ -72,10 +68,6 @@ AliITSUCATrackingStation::AliITSUCATrackingStation(int nzbins,int nphibins,
 ,fDPhiInv(-1)
 ,fNZBins(nzbins)
 ,fNPhiBins(nphibins)
-,fQueryZBmin(-1)
-,fQueryZBmax(-1)
-,fQueryPhiBmin(-1)
-,fQueryPhiBmax(-1)
 ,fBins(0)
 ,fOccBins(0)
 ,fNOccBins(0)
@@ -277,62 +269,7 @@ int AliITSUCATrackingStation::SelectClusters(float zmin,float zmax,float phimin,
   //printf("Select: Z %f %f | Phi: %f %f\n",zmin,zmax,phimin,phimax);
   if (!fNOccBins) return 0;
   if (zmax < fZMin || zmin > fZMax || zmin > zmax) return 0;
-  fFoundBins.clear();
-  
-  fQueryZBmin = GetZBin(zmin);
-  if (fQueryZBmin < 0) fQueryZBmin = 0;
-  fQueryZBmax = GetZBin(zmax);
-  if (fQueryZBmax >= fNZBins) fQueryZBmax = fNZBins - 1;
-  BringTo02Pi(phimin);
-  BringTo02Pi(phimax);
-  fQueryPhiBmin = GetPhiBin(phimin);
-  fQueryPhiBmax = GetPhiBin(phimax);
-  int dbz = 0;
-  fNFoundClusters = 0;
-  int nbcheck = fQueryPhiBmax - fQueryPhiBmin + 1; //TODO:(MP) check if a circular buffer is feasible
-  if (nbcheck > 0)
-  { // no wrapping around 0-2pi, fast case
-    for (int ip = fQueryPhiBmin;ip <= fQueryPhiBmax;ip++) {
-      int binID = GetBinIndex(fQueryZBmin,ip);
-      if ( !(dbz = (fQueryZBmax-fQueryZBmin)) ) { // just one Z bin in the query range
-        ClBinInfo_t& binInfo = fBins[binID];
-        if (!binInfo.ncl) continue;
-        fNFoundClusters += binInfo.ncl;
-        fFoundBins.push_back(binID);
-        continue;
-      }
-      int binMax = binID + dbz;
-      for ( ; binID <= binMax; binID++) {
-        ClBinInfo_t& binInfo = fBins[binID];
-        if (!binInfo.ncl) continue;
-        fNFoundClusters += binInfo.ncl;
-        fFoundBins.push_back(binID);
-      }
-    }
-  }
-  else
-  {  // wrapping
-    nbcheck += fNPhiBins;
-    for (int ip0 = 0;ip0 <= nbcheck;ip0++) {
-      int ip = fQueryPhiBmin + ip0;
-      if (ip >= fNPhiBins) ip -= fNPhiBins;
-      int binID = GetBinIndex(fQueryZBmin,ip);
-      if ( !(dbz = (fQueryZBmax - fQueryZBmin)) ) { // just one Z bin in the query range
-        ClBinInfo_t& binInfo = fBins[binID];
-        if (!binInfo.ncl) continue;
-        fNFoundClusters += binInfo.ncl;
-        fFoundBins.push_back(binID);
-        continue;
-      }
-      int binMax = binID + dbz;
-      for (;binID <= binMax;binID++) {
-        ClBinInfo_t& binInfo = fBins[binID];
-        if (!binInfo.ncl) continue;
-        fNFoundClusters += binInfo.ncl;
-        fFoundBins.push_back(binID);
-      }
-    }
-  }
+  fNFoundClusters = SelectBins(zmin,zmax,phimin,phimax,fFoundBins);
   fFoundClusterIterator = fFoundBinIterator = 0;
   /*
    //printf("Selected -> %d cl in %d bins\n",fNFoundClusters,(int)fFoundBins.size());
@@ -346,6 +283,55 @@ int AliITSUCATrackingStation::SelectClusters(float zmin,float zmax,float phimin,
   return fNFoundClusters;
 }
 
+//_____________________________________________________________
+int AliITSUCATrackingStation::SelectBins(float zmin,float zmax,float phimin,float phimax,
+                                         std::vector<int> &bins) const
+{
+  // fill the occupied bins in the requested region into bins, in the same order
+  // as SelectClusters, and return the number of clusters they contain.
+  // Does not modify the station, so it can be used by several threads.
+  bins.clear();
+  if (!fNOccBins) return 0;
+  if (zmax < fZMin || zmin > fZMax || zmin > zmax) return 0;
+
+  int zbmin = GetZBin(zmin);
+  if (zbmin < 0) zbmin = 0;
+  int zbmax = GetZBin(zmax);
+  if (zbmax >= fNZBins) zbmax = fNZBins - 1;
+  BringTo02Pi(phimin);
+  BringTo02Pi(phimax);
+  const int phibmin = GetPhiBin(phimin);
+  const int phibmax = GetPhiBin(phimax);
+  const int dbz = zbmax - zbmin;
+  int nFound = 0;
+  int nbcheck = phibmax - phibmin + 1; //TODO:(MP) check if a circular buffer is feasible
+  if (nbcheck <= 0) nbcheck += fNPhiBins + 1; // wrapping around 0-2pi
+  for (int ip0 = 0; ip0 < nbcheck; ip0++) {
+    int ip = phibmin + ip0;
+    if (ip >= fNPhiBins) ip -= fNPhiBins;
+    const int binMin = GetBinIndex(zbmin,ip);
+    for (int binID = binMin; binID <= binMin + dbz; binID++) {
+      const ClBinInfo_t& binInfo = fBins[binID];
+      if (!binInfo.ncl) continue;
+      nFound += binInfo.ncl;
+      bins.push_back(binID);
+    }
+  }
+  return nFound;
+}
+
+//_____________________________________________________________
+int AliITSUCATrackingStation::GetFirstClusterInPhiBin(int iphi) const
+{
+  // index of the first sorted cluster with phi bin >= iphi, the clusters are
+  // sorted in phi first, so phi bins are contiguous ranges of sorted clusters
+  if (iphi <= 0) return 0;
+  if (iphi >= fNPhiBins) return fNClusters;
+  ClsInfo_t key;
+  key.zphibin = GetBinIndex(0,iphi);
+  return std::lower_bound(fSortedClInfo.begin(), fSortedClInfo.end(), key) - fSortedClInfo.begin();
+}
+
 //_____________________________________________________________
 int AliITSUCATrackingStation::GetNextClusterInfoID()
 {
@@ -79,6 +79,9 @@ public:
   void GetBinZPhi(int ipz,int &iz,int &iphi) const {iz = GetBinZ(ipz); iphi=GetBinPhi(ipz);}
   //
   int  SelectClusters(float zmin,float zmax,float phimin,float phimax);
+  int  SelectBins(float zmin,float zmax,float phimin,float phimax,std::vector<int> &bins) const;
+  int  GetBinClusters(int bin, int &first) const {first = fBins[bin].first; return fBins[bin].ncl;}
+  int  GetFirstClusterInPhiBin(int iphi) const;
   int  GetNFoundBins()                  const {return fFoundBins.size();}
   int  GetFoundBin(int i)               const {return fFoundBins[i];}
   int  GetFoundBinClusters(int i, int &first)  const;
@@ -116,10 +119,6 @@ protected:
   int   fNZBins;             // N cells in Z
   int   fNPhiBins;           // N cells in Phi
   //
-  int   fQueryZBmin;         // min bin in Z of the query
-  int   fQueryZBmax;         // max bin in Z of the query
-  int   fQueryPhiBmin;       // min bin in phi of the query
-  int   fQueryPhiBmax;       // max bin in phi of the query
   ClBinInfo_t* fBins;           // 2D (z,phi) grid of clusters binned in z,phi
   int* fOccBins;              // id's of bins with non-0 occupancy
   int  fNOccBins;             // number of occupied bins
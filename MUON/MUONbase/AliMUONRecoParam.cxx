@@ -87,7 +87,8 @@ AliMUONRecoParam::AliMUONRecoParam()
   fTryRecover(kFALSE),
   fDiscardMonoCathodClusters(kFALSE),
   fMonoCathodClNonBendingRes(0.),
-  fMonoCathodClBendingRes(0.)
+  fMonoCathodClBendingRes(0.),
+  fNClusteringThreads(1)
 {  
   /// Constructor
   
@@ -357,6 +358,7 @@ void AliMUONRecoParam::Print(Option_t *option) const
   cout << "Event Specie=" << GetEventSpecie() << endl;
   
   cout<<Form("Clustering mode = %s",fClusteringMode.Data())<<endl;
+  if (fNClusteringThreads > 1) cout<<Form("Detection elements clustered in %d threads",fNClusteringThreads)<<endl;
   cout<<Form("Tracking mode = %s",fTrackingMode.Data())<<endl;
 
 	TString bypass;
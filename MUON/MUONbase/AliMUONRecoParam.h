@@ -305,6 +305,14 @@ class AliMUONRecoParam : public AliDetectorRecoParam
   /// Get the bending resolution of mono-cathod clusters when the bending plane is missing
   Double_t GetMonoCathodClBendingRes() const { return fMonoCathodClBendingRes; }
   
+  /// Set the number of threads clustering the detection elements in parallel (<= 1 for serial clustering).
+  /// With more than one thread the random generator of each detection element is seeded from gRandom,
+  /// so the clusters fitted from random starting points differ from the ones of the serial clustering.
+  /// They do not depend on the number of threads
+  void     SetNClusteringThreads(Int_t nThreads) { fNClusteringThreads = nThreads; }
+  /// Get the number of threads clustering the detection elements in parallel
+  Int_t    GetNClusteringThreads() const { return fNClusteringThreads; }
+  
   /// Create object ready to be put in OCDB
   static TObjArray* Create(const char* settings);
   
@@ -415,13 +423,15 @@ private:
   Double32_t fMonoCathodClNonBendingRes; // resolution of mono-cathod clusters in the non-bending direction when the non-bending plane is missing
   Double32_t fMonoCathodClBendingRes; // resolution of mono-cathod clusters in the bending direction when the bending plane is missing
   
+  Int_t      fNClusteringThreads; ///< number of threads clustering the detection elements in parallel (<= 1 for serial clustering)
+  
   // functions
   void SetLowFluxParam();
   void SetHighFluxParam();
   void SetCosmicParam();
   void SetCalibrationParam();
   
-  ClassDef(AliMUONRecoParam,171) // MUON reco parameters
+  ClassDef(AliMUONRecoParam,172) // MUON reco parameters
   // we're at 171 not because we had that many versions, but because at some point (version 15->16)
   // 166 was committed by error, and we did not to go reverse afterwards...
 };
@@ -0,0 +1,361 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+//-----------------------------------------------------------------------------
+// Class AliMUONAbsorberTable
+// --------------------------
+// Material crossed in the front absorber by a straight line coming from the
+// interaction point, tabulated on a (theta, phi) grid. Each node holds the
+// radiation-length moments f0, f1 and f2 and the mean density and density*Z/A,
+// normalized to the path length, and the fraction of the path spent in each
+// material, so that the energy loss can still be computed for any momentum.
+// The direction of a track is given by its position in the middle of the
+// absorber seen from the origin, and the node values are interpolated
+// bilinearly. The table is built with the same TGeo navigation as
+// AliMUONTrackExtrap::GetAbsorberCorrectionParam and can be stored in a file
+// together with a fingerprint of the geometry it was built with.
+//-----------------------------------------------------------------------------
+
+#include "AliMUONAbsorberTable.h"
+
+#include "AliLog.h"
+
+#include <TFile.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TMath.h>
+#include <TObjArray.h>
+#include <TSystem.h>
+
+#include <vector>
+
+/// \cond CLASSIMP
+ClassImp(AliMUONAbsorberTable) // Class implementation in ROOT context
+/// \endcond
+
+const Double_t AliMUONAbsorberTable::fgkMaxOffset = 3.;
+const Double_t AliMUONAbsorberTable::fgkZTolerance = 0.1;
+
+//__________________________________________________________________________
+AliMUONAbsorberTable::AliMUONAbsorberTable()
+  : TObject(),
+    fGeoName(),
+    fGeoTitle(),
+    fGeoNVolumes(0),
+    fGeoNMaterials(0),
+    fZBeg(0.),
+    fZEnd(0.),
+    fNTheta(0),
+    fThetaMax(0.),
+    fNPhi(0),
+    fNMaterials(0),
+    fMatRho(),
+    fMatZ(),
+    fMatZoverA(),
+    fValues()
+{
+  /// Default constructor
+}
+
+//__________________________________________________________________________
+AliMUONAbsorberTable::~AliMUONAbsorberTable()
+{
+  /// Destructor
+}
+
+//__________________________________________________________________________
+void AliMUONAbsorberTable::GetMaterial(const TGeoMaterial* material, Double_t &rho, Double_t &x0,
+                                       Double_t &atomicZ, Double_t &atomicZoverA)
+{
+  /// Material properties, Z/A being averaged with the weights of the mixture
+  rho = material->GetDensity();
+  x0 = material->GetRadLen();
+  atomicZ = material->GetZ();
+  if (material->IsMixture()) {
+    const TGeoMixture* mixture = static_cast<const TGeoMixture*>(material);
+    atomicZoverA = 0.;
+    Double_t sum = 0.;
+    for (Int_t iel = 0; iel < mixture->GetNelements(); iel++) {
+      sum += mixture->GetWmixt()[iel];
+      atomicZoverA += mixture->GetZmixt()[iel]*mixture->GetWmixt()[iel]/mixture->GetAmixt()[iel];
+    }
+    atomicZoverA /= sum;
+  } else atomicZoverA = atomicZ/material->GetA();
+}
+
+//__________________________________________________________________________
+Bool_t AliMUONAbsorberTable::Walk(const Double_t xyzIn[3], const Double_t xyzOut[3], Double_t* fixed,
+                                  TArrayD& matLength, TObjArray& materials)
+{
+  /// Walk through the geometry from xyzIn to xyzOut as done in
+  /// AliMUONTrackExtrap::GetAbsorberCorrectionParam. Fill the (not normalized)
+  /// moments and density integrals and add the path length in each material,
+  /// new materials being appended to the list
+
+  for (Int_t i = 0; i < kNFixed; i++) fixed[i] = 0.;
+
+  Double_t pathLength = TMath::Sqrt((xyzOut[0] - xyzIn[0])*(xyzOut[0] - xyzIn[0])+
+                                    (xyzOut[1] - xyzIn[1])*(xyzOut[1] - xyzIn[1])+
+                                    (xyzOut[2] - xyzIn[2])*(xyzOut[2] - xyzIn[2]));
+  if (pathLength < TGeoShape::Tolerance()) return kFALSE;
+  Double_t b[3];
+  b[0] = (xyzOut[0] - xyzIn[0]) / pathLength;
+  b[1] = (xyzOut[1] - xyzIn[1]) / pathLength;
+  b[2] = (xyzOut[2] - xyzIn[2]) / pathLength;
+  TGeoNode *currentnode = gGeoManager->InitTrack(xyzIn, b);
+  if (!currentnode) return kFALSE;
+
+  Double_t rho, x0, atomicZ, atomicZoverA;
+  Double_t localPathLength = 0;
+  Double_t remainingPathLength = pathLength;
+  Double_t zB = xyzIn[2];
+  Double_t zE, dzB, dzE;
+  do {
+    TGeoMaterial *material = currentnode->GetVolume()->GetMedium()->GetMaterial();
+    GetMaterial(material, rho, x0, atomicZ, atomicZoverA);
+    Int_t iMat = materials.IndexOf(material);
+    if (iMat < 0) {
+      materials.Add(material);
+      iMat = materials.GetLast();
+    }
+    if (matLength.GetSize() <= iMat) matLength.Set(iMat+1);
+
+    gGeoManager->FindNextBoundary(remainingPathLength);
+    localPathLength = gGeoManager->GetStep() + 1.e-6;
+    if (localPathLength >= remainingPathLength) localPathLength = remainingPathLength;
+    else {
+      currentnode = gGeoManager->Step();
+      if (!currentnode) return kFALSE;
+      if (!gGeoManager->IsEntering()) {
+        gGeoManager->SetStep(0.001);
+        currentnode = gGeoManager->Step();
+        if (!gGeoManager->IsEntering() || !currentnode) return kFALSE;
+        localPathLength += 0.001;
+      }
+    }
+
+    zE = b[2] * localPathLength + zB;
+    dzB = zB - xyzIn[2];
+    dzE = zE - xyzIn[2];
+    fixed[kF0] += localPathLength / x0;
+    fixed[kF1] += (dzE*dzE - dzB*dzB) / b[2] / b[2] / x0 / 2.;
+    fixed[kF2] += (dzE*dzE*dzE - dzB*dzB*dzB) / b[2] / b[2] / b[2] / x0 / 3.;
+    fixed[kRho] += localPathLength * rho;
+    fixed[kRhoZoverA] += localPathLength * rho * atomicZoverA;
+    matLength[iMat] += localPathLength;
+
+    zB = zE;
+    remainingPathLength -= localPathLength;
+  } while (remainingPathLength > TGeoShape::Tolerance());
+
+  return kTRUE;
+}
+
+//__________________________________________________________________________
+Bool_t AliMUONAbsorberTable::Build(Double_t zBeg, Double_t zEnd, Int_t nTheta, Double_t thetaMax, Int_t nPhi)
+{
+  /// Build the table for straight lines from the origin crossing the absorber
+  /// from zBeg to zEnd, with nTheta x nPhi intervals up to the polar angle
+  /// thetaMax (rad) with respect to the -z axis
+
+  if (!gGeoManager) {
+    AliError("no TGeo");
+    return kFALSE;
+  }
+  if (nTheta <= 0 || nPhi <= 0 || thetaMax <= 0. || thetaMax >= TMath::PiOver2() || zBeg >= 0. || zEnd >= zBeg) {
+    AliError(Form("invalid binning or absorber range (%d,%g,%d) (%g,%g)", nTheta, thetaMax, nPhi, zBeg, zEnd));
+    return kFALSE;
+  }
+
+  fGeoName = gGeoManager->GetName();
+  fGeoTitle = gGeoManager->GetTitle();
+  fGeoNVolumes = gGeoManager->GetListOfVolumes()->GetEntriesFast();
+  fGeoNMaterials = gGeoManager->GetListOfMaterials()->GetSize();
+  fZBeg = zBeg;
+  fZEnd = zEnd;
+  fNTheta = nTheta;
+  fThetaMax = thetaMax;
+  fNPhi = nPhi;
+
+  // walk along the line of each node, the materials being collected on the way
+  const Int_t nNodes = (nTheta+1) * nPhi;
+  std::vector<Double_t> fixed(nNodes*kNFixed, 0.);
+  std::vector<TArrayD> matLength(nNodes);
+  TObjArray materials;
+  Int_t nFailed = 0;
+  for (Int_t iTheta = 0; iTheta <= nTheta; iTheta++) {
+    Double_t tanTheta = TMath::Tan(iTheta * thetaMax / nTheta);
+    for (Int_t iPhi = 0; iPhi < nPhi; iPhi++) {
+      Double_t phi = iPhi * TMath::TwoPi() / nPhi;
+      Double_t xyzIn[3] = {-zBeg*tanTheta*TMath::Cos(phi), -zBeg*tanTheta*TMath::Sin(phi), zBeg};
+      Double_t xyzOut[3] = {-zEnd*tanTheta*TMath::Cos(phi), -zEnd*tanTheta*TMath::Sin(phi), zEnd};
+      Int_t node = iTheta*nPhi + iPhi;
+      if (!Walk(xyzIn, xyzOut, &fixed[node*kNFixed], matLength[node], materials)) {
+        // flag the node to be filled from its neighbours
+        fixed[node*kNFixed+kRho] = -1.;
+        nFailed++;
+        continue;
+      }
+      Double_t pathLength = (zBeg - zEnd) * TMath::Sqrt(1. + tanTheta*tanTheta);
+      fixed[node*kNFixed+kF0] /= pathLength;
+      fixed[node*kNFixed+kF1] /= pathLength*pathLength;
+      fixed[node*kNFixed+kF2] /= pathLength*pathLength*pathLength;
+      fixed[node*kNFixed+kRho] /= pathLength;
+      fixed[node*kNFixed+kRhoZoverA] /= pathLength;
+      for (Int_t iMat = 0; iMat < matLength[node].GetSize(); iMat++) matLength[node][iMat] /= pathLength;
+    }
+  }
+  if (nFailed == nNodes) {
+    AliError("navigation failed for all the nodes");
+    fNTheta = fNPhi = 0;
+    return kFALSE;
+  }
+  if (nFailed > 0) AliWarning(Form("navigation failed for %d of %d nodes, using the neighbouring node", nFailed, nNodes));
+
+  // material list
+  fNMaterials = materials.GetEntriesFast();
+  fMatRho.Set(fNMaterials);
+  fMatZ.Set(fNMaterials);
+  fMatZoverA.Set(fNMaterials);
+  for (Int_t iMat = 0; iMat < fNMaterials; iMat++) {
+    Double_t x0;
+    GetMaterial(static_cast<TGeoMaterial*>(materials.UncheckedAt(iMat)), fMatRho[iMat], x0, fMatZ[iMat], fMatZoverA[iMat]);
+  }
+
+  // fill the table, failed nodes taking the values of the closest good node in the list
+  const Int_t nValues = GetNValues();
+  fValues.Set(nNodes*nValues);
+  fValues.Reset();
+  for (Int_t node = 0; node < nNodes; node++) {
+    Int_t src = node;
+    for (Int_t d = 1; fixed[src*kNFixed+kRho] < 0. && d <= nNodes; d++) {
+      src = (node + ((d%2) ? (d+1)/2 : nNodes - d/2)) % nNodes;
+    }
+    Double_t* values = fValues.GetArray() + node*nValues;
+    for (Int_t i = 0; i < kNFixed; i++) values[i] = fixed[src*kNFixed+i];
+    for (Int_t iMat = 0; iMat < matLength[src].GetSize(); iMat++) values[kNFixed+iMat] = matLength[src][iMat];
+  }
+
+  AliInfo(Form("absorber table built with %d x %d nodes and %d materials", nTheta+1, nPhi, fNMaterials));
+
+  return kTRUE;
+}
+
+//__________________________________________________________________________
+Bool_t AliMUONAbsorberTable::IsCompatible(Double_t zBeg, Double_t zEnd) const
+{
+  /// Check that the table was built for this absorber range in the current geometry
+  if (!gGeoManager || fNTheta <= 0) return kFALSE;
+  return (fZBeg == zBeg && fZEnd == zEnd &&
+          fGeoName == gGeoManager->GetName() && fGeoTitle == gGeoManager->GetTitle() &&
+          fGeoNVolumes == gGeoManager->GetListOfVolumes()->GetEntriesFast() &&
+          fGeoNMaterials == gGeoManager->GetListOfMaterials()->GetSize());
+}
+
+//__________________________________________________________________________
+AliMUONAbsorberTable* AliMUONAbsorberTable::Load(const char* fileName, Double_t zBeg, Double_t zEnd)
+{
+  /// Read the table from the file if it matches the current geometry,
+  /// otherwise build it and (over)write the file with the new one
+
+  if (!gGeoManager) {
+    AliErrorClass("no TGeo");
+    return 0x0;
+  }
+
+  TString name(fileName);
+  gSystem->ExpandPathName(name);
+  AliMUONAbsorberTable* table = 0x0;
+
+  if (!gSystem->AccessPathName(name.Data())) {
+    TFile* file = TFile::Open(name.Data());
+    if (file && file->IsOpen()) table = dynamic_cast<AliMUONAbsorberTable*>(file->Get("MUONAbsorberTable"));
+    delete file;
+    if (table && table->IsCompatible(zBeg, zEnd)) {
+      AliInfoClass(Form("absorber table read from %s", name.Data()));
+      return table;
+    }
+    AliInfoClass(Form("absorber table in %s does not match the current geometry, rebuilding it", name.Data()));
+    delete table;
+  }
+
+  table = new AliMUONAbsorberTable();
+  if (!table->Build(zBeg, zEnd)) {
+    delete table;
+    return 0x0;
+  }
+
+  TFile* file = TFile::Open(name.Data(), "RECREATE");
+  if (file && file->IsOpen()) {
+    table->Write("MUONAbsorberTable");
+    file->Close();
+  } else AliWarningClass(Form("cannot write the absorber table to %s", name.Data()));
+  delete file;
+
+  return table;
+}
+
+//__________________________________________________________________________
+Bool_t AliMUONAbsorberTable::Interpolate(const Double_t xyzIn[3], const Double_t xyzOut[3], Double_t* values) const
+{
+  /// Fill the GetNValues() values for the straight line from xyzIn to xyzOut.
+  /// Return kFALSE if the line does not cross the whole absorber from the
+  /// entrance to the exit, does not come from the vertex region or is out of the table
+
+  if (fNTheta <= 0) return kFALSE;
+  if (TMath::Abs(xyzIn[2] - fZBeg) > fgkZTolerance || TMath::Abs(xyzOut[2] - fZEnd) > fgkZTolerance) return kFALSE;
+
+  Double_t dz = xyzOut[2] - xyzIn[2];
+  Double_t slopeX = (xyzOut[0] - xyzIn[0]) / dz;
+  Double_t slopeY = (xyzOut[1] - xyzIn[1]) / dz;
+
+  // distance to the beam axis at z=0
+  Double_t x0 = xyzIn[0] - slopeX * xyzIn[2];
+  Double_t y0 = xyzIn[1] - slopeY * xyzIn[2];
+  if (x0*x0 + y0*y0 > fgkMaxOffset*fgkMaxOffset) return kFALSE;
+
+  // direction of the middle of the absorber seen from the origin
+  Double_t zMid = 0.5 * (fZBeg + fZEnd);
+  Double_t xMid = x0 + slopeX * zMid;
+  Double_t yMid = y0 + slopeY * zMid;
+  Double_t theta = TMath::ATan(TMath::Sqrt(xMid*xMid + yMid*yMid) / TMath::Abs(zMid));
+  if (theta > fThetaMax) return kFALSE;
+  Double_t phi = TMath::ATan2(yMid, xMid);
+  if (phi < 0.) phi += TMath::TwoPi();
+
+  Double_t t = theta / fThetaMax * fNTheta;
+  Int_t iTheta = TMath::Min(Int_t(t), fNTheta - 1);
+  Double_t wTheta = t - iTheta;
+  Double_t p = phi / TMath::TwoPi() * fNPhi;
+  Int_t iPhi = Int_t(p);
+  Double_t wPhi = p - iPhi;
+  if (iPhi >= fNPhi) iPhi -= fNPhi;
+  Int_t iPhi1 = (iPhi + 1) % fNPhi;
+
+  const Int_t nValues = GetNValues();
+  const Double_t* v00 = fValues.GetArray() + (iTheta*fNPhi + iPhi)*nValues;
+  const Double_t* v01 = fValues.GetArray() + (iTheta*fNPhi + iPhi1)*nValues;
+  const Double_t* v10 = fValues.GetArray() + ((iTheta+1)*fNPhi + iPhi)*nValues;
+  const Double_t* v11 = fValues.GetArray() + ((iTheta+1)*fNPhi + iPhi1)*nValues;
+  Double_t w00 = (1. - wTheta) * (1. - wPhi);
+  Double_t w01 = (1. - wTheta) * wPhi;
+  Double_t w10 = wTheta * (1. - wPhi);
+  Double_t w11 = wTheta * wPhi;
+  for (Int_t i = 0; i < nValues; i++) values[i] = w00*v00[i] + w01*v01[i] + w10*v10[i] + w11*v11[i];
+
+  return kTRUE;
+}
@@ -0,0 +1,87 @@
+#ifndef ALIMUONABSORBERTABLE_H
+#define ALIMUONABSORBERTABLE_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/*$Id$*/
+
+/// \ingroup rec
+/// \class AliMUONAbsorberTable
+/// \brief Tabulated material of the front absorber versus track direction
+///
+//  Author: The ALICE Off-line Project
+
+#include <TObject.h>
+#include <TString.h>
+#include <TArrayD.h>
+
+class TGeoMaterial;
+class TObjArray;
+
+class AliMUONAbsorberTable : public TObject
+{
+ public:
+  /// Content of a table node, followed by the fraction of the path in each material
+  enum {
+    kF0,         ///< 0th moment of the path length with 1/X0, divided by the path length
+    kF1,         ///< 1st moment, divided by the path length squared
+    kF2,         ///< 2nd moment, divided by the path length cubed
+    kRho,        ///< mean density (g/cm3)
+    kRhoZoverA,  ///< mean density times Z/A (g/cm3)
+    kNFixed      ///< number of values independent of the materials
+  };
+
+  AliMUONAbsorberTable();
+  virtual ~AliMUONAbsorberTable();
+
+  Bool_t Build(Double_t zBeg, Double_t zEnd, Int_t nTheta = 200, Double_t thetaMax = 0.2, Int_t nPhi = 72);
+  Bool_t IsCompatible(Double_t zBeg, Double_t zEnd) const;
+
+  static AliMUONAbsorberTable* Load(const char* fileName, Double_t zBeg, Double_t zEnd);
+
+  Bool_t Interpolate(const Double_t xyzIn[3], const Double_t xyzOut[3], Double_t* values) const;
+
+  /// Return the number of values per node (kNFixed + number of materials)
+  Int_t    GetNValues() const {return kNFixed + fNMaterials;}
+  /// Return the number of materials crossed in the absorber
+  Int_t    GetNMaterials() const {return fNMaterials;}
+  /// Return the density of material i (g/cm3)
+  Double_t GetMaterialRho(Int_t i) const {return fMatRho[i];}
+  /// Return the Z of material i
+  Double_t GetMaterialZ(Int_t i) const {return fMatZ[i];}
+  /// Return the Z/A of material i
+  Double_t GetMaterialZoverA(Int_t i) const {return fMatZoverA[i];}
+
+ private:
+  /// Not implemented
+  AliMUONAbsorberTable(const AliMUONAbsorberTable& rhs);
+  /// Not implemented
+  AliMUONAbsorberTable& operator=(const AliMUONAbsorberTable& rhs);
+
+  static void GetMaterial(const TGeoMaterial* material, Double_t &rho, Double_t &x0,
+                          Double_t &atomicZ, Double_t &atomicZoverA);
+  static Bool_t Walk(const Double_t xyzIn[3], const Double_t xyzOut[3], Double_t* fixed,
+                     TArrayD& matLength, TObjArray& materials);
+
+  static const Double_t fgkMaxOffset;     //!<! maximum distance of the track line to the beam axis at z=0 (cm)
+  static const Double_t fgkZTolerance;    //!<! maximum distance in z of the track ends to the absorber ends (cm)
+
+  TString  fGeoName;      ///< name of the geometry the table was built with
+  TString  fGeoTitle;     ///< title of the geometry the table was built with
+  Int_t    fGeoNVolumes;  ///< number of volumes of the geometry
+  Int_t    fGeoNMaterials;///< number of materials of the geometry
+  Double_t fZBeg;         ///< z of the absorber entrance (cm)
+  Double_t fZEnd;         ///< z of the absorber exit (cm)
+  Int_t    fNTheta;       ///< number of theta intervals
+  Double_t fThetaMax;     ///< maximum polar angle with respect to the -z axis (rad)
+  Int_t    fNPhi;         ///< number of phi intervals
+  Int_t    fNMaterials;   ///< number of materials crossed in the absorber
+  TArrayD  fMatRho;       ///< density of the materials (g/cm3)
+  TArrayD  fMatZ;         ///< Z of the materials
+  TArrayD  fMatZoverA;    ///< Z/A of the materials
+  TArrayD  fValues;       ///< GetNValues() values per node, phi index running fastest
+
+  ClassDef(AliMUONAbsorberTable,1) // Tabulated material of the front absorber
+};
+
+#endif
@@ -30,6 +30,9 @@ public:
   
   virtual AliMUONCluster* NextCluster();
   
+  /// Thread safe if the pre-clustering is
+  virtual Bool_t IsThreadSafe() const { return fPreClusterFinder->IsThreadSafe(); }
+  
 private:
   /// Not implemented
   AliMUONClusterFinderCOG(const AliMUONClusterFinderCOG& rhs);
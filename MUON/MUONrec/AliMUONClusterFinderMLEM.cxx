@@ -42,6 +42,7 @@
 #include "AliMUONVDigitStore.h"
 #include <Riostream.h>
 #include <TH2.h>
+#include <TClonesArray.h>
 #include <TMinuit.h>
 #include <TCanvas.h>
 #include <TMath.h>
@@ -77,9 +78,17 @@ fClusterNumber(0),
 fHistMlem(0x0),
 fHistAnode(0x0),
 fPixArray(new TObjArray(20)),
+fPixelPool(new TClonesArray("AliMUONPad",100)),
+fNPixels(0),
+fGridCharge(),
+fGridEntries(),
+fCoef(),
+fProbi(),
+fProbi1(),
 fDebug(0),
 fPlot(plot),
 fSplitter(0x0),
+fRandom(0x0),
 fNClusters(0),
 fNAddVirtualPads(0),
 fLowestPixelCharge(0),
@@ -98,6 +107,9 @@ AliMUONClusterFinderMLEM::~AliMUONClusterFinderMLEM()
 {
 /// Destructor
   delete fPixArray; fPixArray = 0;
+  delete fPixelPool;
+  delete fHistMlem;
+  delete fHistAnode;
 //  delete fDraw;
   delete fPreClusterFinder;
   delete fSplitter;
@@ -130,13 +142,14 @@ AliMUONClusterFinderMLEM::Prepare(Int_t detElemId,
                                              fLowestPadCharge,
                                              fLowestClusterCharge);
   fSplitter->SetDebug(fDebug);
+  fSplitter->SetRandom(fRandom);
     
   // find out current event number, and reset the cluster number
   AliRunLoader *runLoader = AliRunLoader::Instance();
   fEventNumber = runLoader ? runLoader->GetEventNumber() : 0;
   fClusterNumber = -1;
   fClusterList.Delete();
-  fPixArray->Delete();
+  ClearPixels();
 
   AliDebug(3,Form("EVT %d DE %d",fEventNumber,fDetElemId));
   
@@ -177,7 +190,7 @@ AliMUONClusterFinderMLEM::NextCluster()
 
   fPreCluster = fPreClusterFinder->NextCluster();
 
-  fPixArray->Delete();
+  ClearPixels();
   fClusterList.Delete(); // reset the list of clusters for this pre-cluster
   fClusterNumber = -1; //AZ
     
@@ -281,9 +294,6 @@ AliMUONClusterFinderMLEM::WorkOnPreCluster()
       }
     }
   } // for (Int_t i=0; i<nMax;
-  delete fHistMlem;
-  delete fHistAnode;
-  fHistMlem = fHistAnode = 0x0;
   delete cluster;
   return kTRUE;
 }
@@ -573,7 +583,7 @@ void AliMUONClusterFinderMLEM::BuildPixArray(AliMUONCluster& cluster)
     AliWarning("Got no pad at all ?!");
   }
   
-  fPixArray->Delete();
+  ClearPixels();
   BuildPixArrayOneCathode(cluster);
   
   Int_t nPix = fPixArray->GetLast()+1;
@@ -657,37 +667,44 @@ void AliMUONClusterFinderMLEM::BuildPixArrayOneCathode(AliMUONCluster& cluster)
     //cout << dist << " " << min[i] << " " << max[i] << " " << nbins[i] << endl;
   }
 
-  // Book histogram
-  TH2D *hist1 = new TH2D ("Grid", "", nbins[0], min[0], max[0], nbins[1], min[1], max[1]);
-  TH2D *hist2 = new TH2D ("Entries", "", nbins[0], min[0], max[0], nbins[1], min[1], max[1]);
-  TAxis *xaxis = hist1->GetXaxis();
-  TAxis *yaxis = hist1->GetYaxis();
+  // Book grid (flat arrays with the TH2 bin numbering, under/overflows included)
+  fGridAxis[0].Set(nbins[0], min[0], max[0]);
+  fGridAxis[1].Set(nbins[1], min[1], max[1]);
+  Int_t nxy = (nbins[0]+2) * (nbins[1]+2);
+  if (fGridCharge.GetSize() < nxy) {
+    fGridCharge.Set(nxy);
+    fGridEntries.Set(nxy);
+  }
+  memset(fGridCharge.GetArray(), 0, nxy*sizeof(Double_t));
+  memset(fGridEntries.GetArray(), 0, nxy*sizeof(Double_t));
+  TAxis *xaxis = &fGridAxis[0];
+  TAxis *yaxis = &fGridAxis[1];
 
-  // Fill histogram
+  // Fill grid
   for ( Int_t i = 0; i < mult; ++i) {
     AliMUONPad* pad = cluster.Pad(i);
     Int_t ix0 = xaxis->FindBin(pad->X());
     Int_t iy0 = yaxis->FindBin(pad->Y());
-    PadOverHist(0, ix0, iy0, pad, hist1, hist2);
+    PadOverGrid(0, ix0, iy0, pad);
   }
 
   // Store pixels
   for (Int_t i = 1; i <= nbins[0]; ++i) {
     Double_t x = xaxis->GetBinCenter(i);
     for (Int_t j = 1; j <= nbins[1]; ++j) {
-      if (hist2->GetBinContent(hist2->GetBin(i,j)) < 0.1) continue;
-      //if (hist2->GetBinContent(hist2->GetBin(i,j)) < 1.1 && cluster.Multiplicity(0) && 
+      Int_t bin = i + (nbins[0]+2) * j;
+      if (fGridEntries[bin] < 0.1) continue;
+      //if (fGridEntries[bin] < 1.1 && cluster.Multiplicity(0) && 
       //  cluster.Multiplicity(1)) continue;
       if (cath0 != cath1) {
 	// Two-sided cluster
-	Double_t cont = hist2->GetBinContent(hist2->GetBin(i,j));
+	Double_t cont = fGridEntries[bin];
 	if (cont < 999.) continue;
 	if (cont-Int_t(cont/1000.)*1000. < 0.5) continue;
       }
       Double_t y = yaxis->GetBinCenter(j);
-      Double_t charge = hist1->GetBinContent(hist1->GetBin(i,j));
-      AliMUONPad* pixPtr = new AliMUONPad(x, y, width[0], width[1], charge);
-      fPixArray->Add(pixPtr);
+      Double_t charge = fGridCharge[bin];
+      fPixArray->Add(NewPixel(x, y, width[0], width[1], charge));
     }  
   }
   //*
@@ -696,23 +713,21 @@ void AliMUONClusterFinderMLEM::BuildPixArrayOneCathode(AliMUONCluster& cluster)
     AliMUONPad* pixPtr = static_cast<AliMUONPad*> (fPixArray->UncheckedAt(0));
     pixPtr->SetSize(0,width[0]/2.);
     pixPtr->Shift(0,-width[0]/4.);
-    pixPtr = new AliMUONPad(pixPtr->X()+width[0], pixPtr->Y(), width[0]/2., width[1], pixPtr->Charge());
+    pixPtr = NewPixel(pixPtr->X()+width[0], pixPtr->Y(), width[0]/2., width[1], pixPtr->Charge());
     fPixArray->Add(pixPtr);
   }
   //*/
   //fPixArray->Print();
-  delete hist1;
-  delete hist2;
 }
 
 //_____________________________________________________________________________
-void AliMUONClusterFinderMLEM::PadOverHist(Int_t idir, Int_t ix0, Int_t iy0, AliMUONPad *pad,
-					   TH2D *hist1, TH2D *hist2)
+void AliMUONClusterFinderMLEM::PadOverGrid(Int_t idir, Int_t ix0, Int_t iy0, const AliMUONPad *pad)
 {
-  /// "Span" pad over histogram in the direction idir
+  /// "Span" pad over the pixel grid in the direction idir
 
-  TAxis *axis = idir == 0 ? hist1->GetXaxis() : hist1->GetYaxis();
+  const TAxis *axis = &fGridAxis[idir];
   Int_t nbins = axis->GetNbins(), cath = pad->Cathode();
+  Int_t nx2 = fGridAxis[0].GetNbins() + 2;
   Double_t bin = axis->GetBinWidth(1), amask = TMath::Power(1000.,cath*1.);
 
   Int_t nbinPad = (Int_t)(pad->Size(idir)/bin*2+fgkDistancePrecision) + 1; // number of bins covered by pad
@@ -722,15 +737,14 @@ void AliMUONClusterFinderMLEM::PadOverHist(Int_t idir, Int_t ix0, Int_t iy0, Ali
     if (ixy > nbins) break;
     Double_t lowEdge = axis->GetBinLowEdge(ixy);
     if (lowEdge + fgkDistancePrecision > pad->Coord(idir) + pad->Size(idir)) break;
-    if (idir == 0) PadOverHist(1, ixy, iy0, pad, hist1, hist2); // span in the other direction
+    if (idir == 0) PadOverGrid(1, ixy, iy0, pad); // span in the other direction
     else {
-      // Fill histogram
+      // Fill grid
+      Int_t bin = ix0 + nx2 * ixy;
       Double_t cont = pad->Charge();
-      if (hist2->GetBinContent(hist2->GetBin(ix0, ixy)) > 0.1) 
-	cont = TMath::Min (hist1->GetBinContent(hist1->GetBin(ix0, ixy)), cont);
-      hist1->SetBinContent(hist1->GetBin(ix0, ixy), cont);
-      //hist2->SetBinContent(hist2->GetBin(ix0, ixy), hist2->GetBinContent(hist2->GetBin(ix0, ixy))+1);
-      hist2->SetBinContent(hist2->GetBin(ix0, ixy), hist2->GetBinContent(hist2->GetBin(ix0, ixy))+amask);
+      if (fGridEntries[bin] > 0.1) cont = TMath::Min (fGridCharge[bin], cont);
+      fGridCharge[bin] = cont;
+      fGridEntries[bin] += amask;
     }
   }
 
@@ -739,15 +753,14 @@ void AliMUONClusterFinderMLEM::PadOverHist(Int_t idir, Int_t ix0, Int_t iy0, Ali
     if (ixy < 1) break;
     Double_t upEdge = axis->GetBinUpEdge(ixy);
     if (upEdge - fgkDistancePrecision < pad->Coord(idir) - pad->Size(idir)) break;
-    if (idir == 0) PadOverHist(1, ixy, iy0, pad, hist1, hist2); // span in the other direction
+    if (idir == 0) PadOverGrid(1, ixy, iy0, pad); // span in the other direction
     else {
-      // Fill histogram
+      // Fill grid
+      Int_t bin = ix0 + nx2 * ixy;
       Double_t cont = pad->Charge();
-      if (hist2->GetBinContent(hist2->GetBin(ix0, ixy)) > 0.1) 
-	cont = TMath::Min (hist1->GetBinContent(hist1->GetBin(ix0, ixy)), cont);
-      hist1->SetBinContent(hist1->GetBin(ix0, ixy), cont);
-      //hist2->SetBinContent(hist1->GetBin(ix0, ixy), hist2->GetBinContent(hist2->GetBin(ix0, ixy))+1);
-      hist2->SetBinContent(hist2->GetBin(ix0, ixy), hist2->GetBinContent(hist2->GetBin(ix0, ixy))+amask);
+      if (fGridEntries[bin] > 0.1) cont = TMath::Min (fGridCharge[bin], cont);
+      fGridCharge[bin] = cont;
+      fGridEntries[bin] += amask;
     }
   }
 }
@@ -855,15 +868,15 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
   while (1) 
   {
     ++lc;
-    delete fHistMlem;
-    fHistMlem = 0x0;
     
     AliDebug(2,Form("lc %d nPix %d(%d) npadTot %d npadOK %d",lc,nPix,fPixArray->GetLast()+1,npadTot,npadOK));
     AliDebug(2,Form("EVT%d PixArray=",fEventNumber));
     //StdoutToAliDebug(2,fPixArray->Print("full"));
         
-    coef = new Double_t [npadTot*nPix];
-    probi = new Double_t [nPix];
+    if (fCoef.GetSize() < npadTot*nPix) fCoef.Set(npadTot*nPix);
+    if (fProbi.GetSize() < nPix) fProbi.Set(nPix);
+    coef = fCoef.GetArray();
+    probi = fProbi.GetArray();
 
     // Calculate coefficients and pixel visibilities
     ComputeCoefficients(cluster,coef,probi);
@@ -912,9 +925,7 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
     
     AliDebug(2,Form("LowestPadCharge=%e",fLowestPadCharge));
     
-    delete fHistMlem;
-    
-    fHistMlem = new TH2D("mlem","mlem",nx,xylim[0],-xylim[1],ny,xylim[2],-xylim[3]);
+    BookHist(fHistMlem,"mlem",nx,xylim[0],-xylim[1],ny,xylim[2],-xylim[3]);
 
     for (Int_t ipix = 0; ipix < nPix; ++ipix) 
     {
@@ -932,9 +943,7 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
     if ( qTot < 1.e-4 || ( npadOK < 3 && qTot < fLowestClusterCharge ) )
     {
       AliDebug(1,Form("Deleting the above cluster (charge %e too low, npadOK=%d)",qTot,npadOK));
-      delete [] coef; 
-      delete [] probi; 
-      fPixArray->Delete(); 
+      ClearPixels(); 
       for ( Int_t i = 0; i < npadTot; ++i) 
       {
         AliMUONPad* pad = cluster.Pad(i);
@@ -948,9 +957,7 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
     {
       // Simple cluster - skip further passes thru EM-procedure
       Simple(cluster);
-      delete [] coef; 
-      delete [] probi; 
-      fPixArray->Delete(); 
+      ClearPixels(); 
       return kTRUE;
     }
 
@@ -1012,7 +1019,7 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
         } 
         else if (nPix < npadOK)
         {
-          pixPtr2 = new AliMUONPad(*pixPtr2);
+          pixPtr2 = NewPixel(*pixPtr2);
           pixPtr2->Shift(indx, -2*width);
 	  pixPtr2->SetStatus(fgkZero);
           fPixArray->Add(pixPtr2);
@@ -1049,7 +1056,7 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
             TMath::Abs((i%2 ? -1 : 1)*xylim[i]-xyCOG[i/2]) < pixPtr2->Size(i/2)) 
         {
           //AliMUONPad* p = static_cast<AliMUONPad*>(pixPtr->Clone());
-          AliMUONPad* p = new AliMUONPad(*pixPtr2);
+          AliMUONPad* p = NewPixel(*pixPtr2);
           p->SetCoord(i/2, xyCOG[i/2]+(i%2 ? 2:-2)*pixPtr2->Size(i/2));
 	  xylim[i] = p->Coord(i/2) * (i%2 ? -1 : 1); // update histo limits
           j = TMath::Even (i/2);
@@ -1063,8 +1070,6 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
       }
     } 
     nPix = fPixArray->GetEntriesFast();
-    delete [] coef; 
-    delete [] probi; 
   } // while (1)
 
   AliDebug(2,Form("At the end of while loop nPix=%d : ",fPixArray->GetLast()+1));
@@ -1126,9 +1131,7 @@ Bool_t AliMUONClusterFinderMLEM::MainLoop(AliMUONCluster& cluster, Int_t iSimple
     fSplitter->Split(cluster,fHistMlem,coef,fClusterList);
   }
   
-  delete [] coef; 
-  delete [] probi; 
-  fPixArray->Delete(); 
+  ClearPixels(); 
   
   return ok;
 }
@@ -1159,7 +1162,8 @@ void AliMUONClusterFinderMLEM::Mlem(AliMUONCluster& cluster,
 
   Int_t npad = cluster.Multiplicity();
 
-  Double_t* probi1 = new Double_t[nPix];
+  if (fProbi1.GetSize() < nPix) fProbi1.Set(nPix);
+  Double_t* probi1 = fProbi1.GetArray();
   Double_t probMax = TMath::MaxElement(nPix,probi);
   
   for (Int_t iter = 0; iter < nIter; ++iter) 
@@ -1213,11 +1217,9 @@ void AliMUONClusterFinderMLEM::Mlem(AliMUONCluster& cluster,
     }
     if (qTot < 1.e-6) {
       // Can happen in clusters with large number of overflows - speeding up 
-      delete [] probi1;
       return;
     }
   } // for (Int_t iter=0;
-  delete [] probi1;
 }
 
 //_____________________________________________________________________________
@@ -1409,8 +1411,7 @@ Int_t AliMUONClusterFinderMLEM::FindLocalMaxima(TObjArray *pixArray, Int_t *loca
 
   Int_t nx = TMath::Nint ((-xylim[1]-xylim[0])/pixPtr->Size(0)/2);
   Int_t ny = TMath::Nint ((-xylim[3]-xylim[2])/pixPtr->Size(1)/2);
-  if (pixArray == fPixArray) fHistAnode = new TH2D("anode","anode",nx,xylim[0],-xylim[1],ny,xylim[2],-xylim[3]);
-  else fHistAnode = new TH2D("anode1","anode1",nx,xylim[0],-xylim[1],ny,xylim[2],-xylim[3]);
+  BookHist(fHistAnode,"anode",nx,xylim[0],-xylim[1],ny,xylim[2],-xylim[3]);
   for (Int_t ipix = 0; ipix < nPix; ++ipix) {
     pixPtr = (AliMUONPad*) pixArray->UncheckedAt(ipix);
     fHistAnode->Fill(pixPtr->Coord(0), pixPtr->Coord(1), pixPtr->Charge());
@@ -1509,14 +1510,14 @@ void AliMUONClusterFinderMLEM::FindCluster(AliMUONCluster& cluster,
   for (Int_t i = 0; i < nxy; ++i) used[i] = kFALSE; 
 
   // Drop all pixels from the array - pick up only the ones from the cluster
-  fPixArray->Delete();
+  ClearPixels();
 
   Double_t wx = fHistAnode->GetXaxis()->GetBinWidth(1)/2; 
   Double_t wy = fHistAnode->GetYaxis()->GetBinWidth(1)/2;  
   Double_t yc = fHistAnode->GetYaxis()->GetBinCenter(ic);
   Double_t xc = fHistAnode->GetXaxis()->GetBinCenter(jc);
   Double_t cont = fHistAnode->GetBinContent( fHistAnode->GetBin(jc,ic));
-  fPixArray->Add(new AliMUONPad (xc, yc, wx, wy, cont));
+  fPixArray->Add(NewPixel(xc, yc, wx, wy, cont));
   used[(ic-1)*nx+jc-1] = kTRUE;
   AddBinSimple(fHistAnode, ic, jc);
   //fSplitter->AddBin(hist, ic, jc, 1, used, (TObjArray*)0); // recursive call
@@ -1575,8 +1576,8 @@ AliMUONClusterFinderMLEM::AddBinSimple(TH2D *hist, Int_t ic, Int_t jc)
       cont1 = hist->GetBinContent(hist->GetBin(j,i));
       if (cont1 > cont) continue;
       if (cont1 < fLowestPixelCharge) continue;
-      pixPtr = new AliMUONPad (hist->GetXaxis()->GetBinCenter(j), 
-			       hist->GetYaxis()->GetBinCenter(i), 0, 0, cont1);
+      pixPtr = NewPixel(hist->GetXaxis()->GetBinCenter(j), 
+			hist->GetYaxis()->GetBinCenter(i), 0, 0, cont1);
       fPixArray->Add(pixPtr);
     }
   }
@@ -1733,10 +1734,8 @@ void AliMUONClusterFinderMLEM::PadsInXandY(AliMUONCluster& cluster,
 //_____________________________________________________________________________
 void AliMUONClusterFinderMLEM::RemovePixel(Int_t i)
 {
-  /// Remove pixel at index i
-  AliMUONPad* pixPtr = Pixel(i);
+  /// Remove pixel at index i (its pool slot is recycled by ClearPixels)
   fPixArray->RemoveAt(i); 
-  delete pixPtr;
 }
 
 //_____________________________________________________________________________
@@ -1778,6 +1777,62 @@ AliMUONClusterFinderMLEM::Pixel(Int_t i) const
   return static_cast<AliMUONPad*>(fPixArray->UncheckedAt(i));
 }
 
+//_____________________________________________________________________________
+AliMUONPad* 
+AliMUONClusterFinderMLEM::NewPixel(Double_t x, Double_t y, Double_t dx, Double_t dy, Double_t charge)
+{
+  /// Create a pixel in the pool
+  return new ((*fPixelPool)[fNPixels++]) AliMUONPad(x, y, dx, dy, charge);
+}
+
+//_____________________________________________________________________________
+AliMUONPad* 
+AliMUONClusterFinderMLEM::NewPixel(const AliMUONPad& pixel)
+{
+  /// Create a copy of a pixel in the pool
+  return new ((*fPixelPool)[fNPixels++]) AliMUONPad(pixel);
+}
+
+//_____________________________________________________________________________
+void 
+AliMUONClusterFinderMLEM::ClearPixels()
+{
+  /// Empty the pixel array. The pool keeps its objects, which are 
+  /// overwritten by the next NewPixel calls
+  fPixArray->Clear();
+  fNPixels = 0;
+}
+
+//_____________________________________________________________________________
+void 
+AliMUONClusterFinderMLEM::BookHist(TH2D*& hist, const char* name, 
+                                   Int_t nx, Double_t xmin, Double_t xmax,
+                                   Int_t ny, Double_t ymin, Double_t ymax)
+{
+  /// Book the histogram at the first call, then only change its binning
+  /// and reset it. The finders of AliMUONSimpleClusterServer::ClusterizeParallel
+  /// book from several threads, so the histogram must never be appended to
+  /// gDirectory; the global AddDirectory flag is switched within a critical
+  /// section for the same reason
+  if (!hist) 
+  {
+#ifdef _OPENMP
+#pragma omp critical(AliMUONClusterFinderMLEMBookHist)
+#endif
+    {
+      Bool_t addDirectory = TH1::AddDirectoryStatus();
+      TH1::AddDirectory(kFALSE);
+      hist = new TH2D(name,name,nx,xmin,xmax,ny,ymin,ymax);
+      TH1::AddDirectory(addDirectory);
+    }
+  }
+  else 
+  {
+    hist->SetBins(nx,xmin,xmax,ny,ymin,ymax);
+    hist->Reset();
+  }
+}
+
 //_____________________________________________________________________________
 void 
 AliMUONClusterFinderMLEM::Print(Option_t* what) const
@@ -14,6 +14,7 @@
 
 class TH2D;
 class TMinuit;
+class TClonesArray;
 
 #ifndef ROOT_TObjArray
 #  include "TObjArray.h"
@@ -21,6 +22,12 @@ class TMinuit;
 #ifndef ROOT_TVector2
 #  include "TVector2.h"
 #endif
+#ifndef ROOT_TArrayD
+#  include "TArrayD.h"
+#endif
+#ifndef ROOT_TAxis
+#  include "TAxis.h"
+#endif
 
 class AliMUONPad;
 
@@ -47,6 +54,11 @@ public:
   
   virtual void SetChargeHints(Double_t lowestPadCharge, Double_t lowestClusterCharge);
   
+  /// Thread safe if the pre-clustering is and if we do not plot
+  virtual Bool_t IsThreadSafe() const { return !fPlot && fPreClusterFinder->IsThreadSafe(); }
+  /// Set the random generator of the splitter (gRandom if 0x0, not owner)
+  virtual void SetRandom(TRandom* random) { fRandom = random; }
+  
   virtual void Print(Option_t* opt="") const;
 
   virtual void Paint(Option_t* opt="");
@@ -84,12 +96,18 @@ private:
   /// build array of pixels
   void BuildPixArray(AliMUONCluster& cluster); 
   void BuildPixArrayOneCathode(AliMUONCluster& cluster); 
-  void PadOverHist(Int_t idir, Int_t ix0, Int_t iy0, AliMUONPad *pad,
-		   TH2D *hist1, TH2D *hist2);
+  void PadOverGrid(Int_t idir, Int_t ix0, Int_t iy0, const AliMUONPad *pad);
 
   void RemovePixel(Int_t i);
   
   AliMUONPad* Pixel(Int_t i) const;
+
+  AliMUONPad* NewPixel(Double_t x, Double_t y, Double_t dx, Double_t dy, Double_t charge);
+  AliMUONPad* NewPixel(const AliMUONPad& pixel);
+  void ClearPixels();
+
+  void BookHist(TH2D*& hist, const char* name, Int_t nx, Double_t xmin, Double_t xmax,
+                Int_t ny, Double_t ymin, Double_t ymax);
   
   Bool_t MainLoop(AliMUONCluster& cluster, Int_t iSimple); // repeat MLEM algorithm until pixels become sufficiently small
   
@@ -148,11 +166,22 @@ private:
   TH2D *fHistMlem; //!<! histogram for MLEM procedure
   TH2D *fHistAnode; //!<! histogram for local maxima search
   
-  TObjArray* fPixArray; //!<! collection of pixels
+  TObjArray* fPixArray; //!<! collection of pixels (not owner, pixels are in fPixelPool)
+  TClonesArray* fPixelPool; //!<! storage of the pixels, reused for all preclusters
+  Int_t fNPixels; //!<! number of pixels taken from fPixelPool
+  
+  TAxis fGridAxis[2]; //!<! x and y binning of the pad-over-pixel grid
+  TArrayD fGridCharge; //!<! grid contents: lowest charge of the pads covering the bin
+  TArrayD fGridEntries; //!<! grid contents: pads covering the bin (1 per cathode 0 pad, 1000 per cathode 1 pad)
+  
+  TArrayD fCoef; //!<! pad-pixel coefficients of the MLEM procedure
+  TArrayD fProbi; //!<! pixel visibilities
+  TArrayD fProbi1; //!<! work array of the MLEM iterations
   Int_t fDebug; //!<! debug level
   Bool_t fPlot; //!<! whether we should plot thing (for debug only, quite slow!)
   
   AliMUONClusterSplitterMLEM* fSplitter; //!<! helper class to go from pixel arrays to clusters
+  TRandom* fRandom; //!<! random generator of the splitter (gRandom if 0x0, not owner)
   Int_t fNClusters; //!<! total number of clusters
   Int_t fNAddVirtualPads; //!<! number of clusters for which we added virtual pads
   
@@ -71,6 +71,8 @@ fNpar(0),
 fQtot(0),
 fnCoupled(0),
 fDebug(0),
+fRandom(0x0),
+fQAver(0),
 fLowestPixelCharge(lowestPixelCharge),
 fLowestPadCharge(lowestPadCharge),
 fLowestClusterCharge(lowestClusterCharge)
@@ -208,7 +210,6 @@ AliMUONClusterSplitterMLEM::Fcn1(const AliMUONCluster& cluster,
   
   Int_t indx, npads=0;
   Double_t charge, delta, coef=0, chi2=0, qTot = 0;
-  static Double_t qAver = 0;
   
   Int_t mult = cluster.Multiplicity(), iend = fNpar / 3;
   for (Int_t j = 0; j < mult; ++j) 
@@ -235,12 +236,12 @@ AliMUONClusterSplitterMLEM::Fcn1(const AliMUONCluster& cluster,
     delta /= pad->Charge(); 
     chi2 += delta;
   } // for (Int_t j=0;
-  if (iflag == 0 && npads) qAver = qTot / npads;
+  if (iflag == 0 && npads) fQAver = qTot / npads;
   if (!npads && iflag==0)
   {
     AliError(Form("Got npads=0. Please check"));
   }
-  f = chi2 / qAver;
+  f = chi2 / fQAver;
 }
 
 //_____________________________________________________________________________
@@ -619,7 +620,7 @@ AliMUONClusterSplitterMLEM::Fit(const AliMUONCluster& cluster,
 	if (nFail > 10) 
         {
 	  param[idMax] -= shift[idMax];
-	  shift[idMax] = 4 * shiftSave * (gRandom->Rndm(0) - 0.5);
+	  shift[idMax] = 4 * shiftSave * ((fRandom ? fRandom : gRandom)->Rndm(0) - 0.5);
 	  param[idMax] += shift[idMax];
 	}
       }      
@@ -24,6 +24,7 @@ class TH2;
 class TObjArray;
 class AliMUONPad;
 class AliMUONMathieson;
+class TRandom;
 
 class AliMUONClusterSplitterMLEM : public TObject
 {
@@ -78,6 +79,8 @@ public:
   void UpdatePads(const AliMUONCluster& cluster, Int_t nfit, Double_t *par);
   /// Set debug level
   void SetDebug (Int_t debug) { fDebug = debug; }
+  /// Set the random generator (gRandom if 0x0)
+  void SetRandom (TRandom* random) { fRandom = random; }
 
 private:
   /// will not be implemented
@@ -97,6 +100,8 @@ private:
   Double_t fQtot; //!<! total charge
   Int_t fnCoupled; //!<! number of coupled pixels ?
   Int_t fDebug; //!<! debug level
+  TRandom* fRandom; //!<! random generator (gRandom if 0x0, not owner)
+  Double_t fQAver; //!<! average pad charge of the cluster being fitted
   
   Double_t fLowestPixelCharge; //!<! minimum allowed pixel charge
   Double_t fLowestPadCharge; //!<! minimum allowed pad charge
@@ -41,6 +41,9 @@ public:
   virtual AliMUONCluster* NextCluster();
 
   virtual Bool_t UsePad(const AliMUONPad& pad);
+
+  /// Several instances can run in parallel
+  virtual Bool_t IsThreadSafe() const { return kTRUE; }
   
 private:
   /// Not implemented
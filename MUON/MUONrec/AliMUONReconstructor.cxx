@@ -478,11 +478,29 @@ AliMUONReconstructor::CreateClusterServer(const AliMUONRecoParam& rp) const
     
     if ( !clusterFinder ) return 0x0;
     
-    clusterServer = new AliMUONSimpleClusterServer(clusterFinder,*fTransformer);
+    AliMUONSimpleClusterServer* simpleClusterServer = new AliMUONSimpleClusterServer(clusterFinder,*fTransformer);
+    clusterServer = simpleClusterServer;
 
     AliInfo(Form("Created AliMUONSimpleClusterServer (%p) for specie %d with clustering = %s (following requesting clustering mode %s)",
                  clusterServer,rp.GetEventSpecie(),clusterFinder->ClassName(),rp.GetClusteringMode()));
     
+    if ( rp.GetNClusteringThreads() > 1 )
+    {
+      if ( clusterFinder->IsThreadSafe() )
+      {
+        // one more cluster finder per additional clustering thread
+        for ( Int_t i = 1; i < rp.GetNClusteringThreads(); ++i )
+        {
+          simpleClusterServer->AddClusterFinder(CreateClusterFinder(rp.GetClusteringMode()));
+        }
+        AliInfo(Form("Clustering the detection elements in %d threads",simpleClusterServer->GetNofClusterFinders()));
+      }
+      else
+      {
+        AliWarning(Form("%s cannot be used in several threads: clustering will be serial",clusterFinder->ClassName()));
+      }
+    }
+    
     fClusterServers.AddAtAndExpand(clusterServer,rp.GetEventSpecie());
   }
   
@@ -23,6 +23,7 @@
 #include "AliMUONConstants.h"
 #include "AliMUONGeometryTransformer.h"
 #include "AliMUONPad.h"
+#include "AliMUONRawClusterV2.h"
 #include "AliMUONTriggerTrackToTrackerClusters.h"
 #include "AliMUONVCluster.h"
 #include "AliMUONVClusterFinder.h"
@@ -38,14 +39,25 @@
 #include "AliMpSegmentation.h"
 #include "AliMpVSegmentation.h"
 #include <Riostream.h>
+#include <TClonesArray.h>
+#include <TMath.h>
 #include <TObjArray.h>
+#include <TRandom3.h>
 #include <TString.h>
+#include <TThread.h>
 #include <float.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /// \class AliMUONSimpleClusterServer
 ///
 /// Implementation of AliMUONVClusterServer interface
 /// 
+/// With AliMUONRecoParam::SetNClusteringThreads(n), n > 1, and n-1 additional
+/// cluster finders given with AddClusterFinder, the detection elements of a
+/// chamber are clusterized in n OpenMP threads (see ClusterizeParallel).
 /// 
 /// \author Laurent Aphecetche, Subatech
 
@@ -76,7 +88,10 @@ AliMUONSimpleClusterServer::AliMUONSimpleClusterServer(AliMUONVClusterFinder* cl
   fkTransformer(transformer),
   fPads(),
   fTriggerTrackStore(0x0),
-  fBypass(0x0)
+  fBypass(0x0),
+  fThreadClusterFinders(0x0),
+  fThreadRandoms(0x0),
+  fDEClusters(0x0)
 {
     /// Ctor
     /// Note that we take ownership of the clusterFinder
@@ -98,6 +113,42 @@ AliMUONSimpleClusterServer::~AliMUONSimpleClusterServer()
   delete fPadsIterator[0];
   delete fPadsIterator[1];
   delete fBypass;
+  delete fThreadClusterFinders;
+  delete fThreadRandoms;
+  delete fDEClusters;
+}
+
+//_____________________________________________________________________________
+void
+AliMUONSimpleClusterServer::AddClusterFinder(AliMUONVClusterFinder* clusterFinder)
+{
+  /// Add a cluster finder for one more clustering thread (we take ownership).
+  /// It must be of the same kind as the main one, and thread safe.
+  
+  if ( !clusterFinder ) return;
+  
+  if ( !clusterFinder->IsThreadSafe() )
+  {
+    AliError(Form("%s cannot be used in several threads",clusterFinder->ClassName()));
+    delete clusterFinder;
+    return;
+  }
+  
+  if ( !fThreadClusterFinders )
+  {
+    fThreadClusterFinders = new TObjArray;
+    fThreadClusterFinders->SetOwner(kTRUE);
+  }
+  fThreadClusterFinders->Add(clusterFinder);
+}
+
+//_____________________________________________________________________________
+Int_t
+AliMUONSimpleClusterServer::GetNofClusterFinders() const
+{
+  /// Number of cluster finders, i.e. maximum number of clustering threads
+  
+  return 1 + ( fThreadClusterFinders ? fThreadClusterFinders->GetEntriesFast() : 0 );
 }
 
 //_____________________________________________________________________________
@@ -125,6 +176,13 @@ AliMUONSimpleClusterServer::Clusterize(Int_t chamberId,
     return 0;
   }
   
+  Int_t nThreads = TMath::Min(recoParam->GetNClusteringThreads(),GetNofClusterFinders());
+  
+  if ( nThreads > 1 && fClusterFinder->IsThreadSafe() )
+  {
+    return ClusterizeParallel(chamberId,clusterStore,area,*recoParam,nThreads);
+  }
+  
   AliMpDEIterator it;
   
   it.First(chamberId);
@@ -218,7 +276,7 @@ AliMUONSimpleClusterServer::Clusterize(Int_t chamberId,
           // Set MC label
           if (fDigitStore && fDigitStore->HasMCInformation()) 
           {
-            rawCluster->SetMCLabel(FindMCLabel(*cluster, detElemId, seg));
+            rawCluster->SetMCLabel(FindMCLabel(cluster->Position().X(), cluster->Position().Y(), detElemId, seg));
           }
           
           AliDebug(1,Form("Adding RawCluster detElemId %4d mult %2d charge %e (xl,yl,zl)=(%e,%e,%e) (xg,yg,zg)=(%e,%e,%e) label %d",
@@ -237,6 +295,251 @@ AliMUONSimpleClusterServer::Clusterize(Int_t chamberId,
 }
 
 
+//_____________________________________________________________________________
+Int_t
+AliMUONSimpleClusterServer::ClusterizeParallel(Int_t chamberId,
+                                               AliMUONVClusterStore& clusterStore,
+                                               const AliMpArea& area,
+                                               const AliMUONRecoParam& recoParam,
+                                               Int_t nThreads)
+{
+  /// Clusterize the detection elements of the chamber in nThreads threads,
+  /// each with its own cluster finder.
+  ///
+  /// The segmentations fill their pad buffer when asked for a pad, so the
+  /// DEs sharing a segmentation (the quadrants of stations 1 and 2) are
+  /// clusterized one after the other, by the same thread.
+  ///
+  /// The segmentations, which are created at first use, and the seeds of the
+  /// random generators are taken beforehand in DE order. The clusters of each
+  /// DE are kept aside in local coordinates, then added to the store in DE
+  /// order together with their global position and MC label. The content of
+  /// the store is therefore the same whatever the number of threads.
+  
+#ifndef _OPENMP
+  static Bool_t warned = kFALSE;
+  if ( !warned )
+  {
+    AliWarning("Compiled without OpenMP support, the detection elements are clusterized serially");
+    warned = kTRUE;
+  }
+  nThreads = 1;
+#endif
+  
+  // list the detection elements to clusterize
+  Int_t nofDEs = AliMpDEManager::GetNofDEInChamber(chamberId);
+  Int_t* detElemIds = new Int_t[nofDEs];
+  AliMpArea* deAreas = new AliMpArea[nofDEs];
+  TObjArray** pads = new TObjArray*[2*nofDEs];
+  const AliMpVSegmentation** segs = new const AliMpVSegmentation*[2*nofDEs];
+  UInt_t* seeds = new UInt_t[nofDEs];
+  Int_t n(0);
+  
+  AliMpDEIterator it;
+  
+  for ( it.First(chamberId); !it.IsDone(); it.Next() )
+  {
+    Int_t detElemId = it.CurrentDEId();
+    
+    pads[2*n] = PadArray(detElemId,0);
+    pads[2*n+1] = PadArray(detElemId,1);
+    
+    if ( !( pads[2*n] && pads[2*n]->GetLast()>=0 ) && 
+         !( pads[2*n+1] && pads[2*n+1]->GetLast()>=0 ) ) continue;
+    
+    if ( area.IsValid() && !Overlap(detElemId,area,deAreas[n]) ) continue;
+    
+    detElemIds[n] = detElemId;
+    segs[2*n] = AliMpSegmentation::Instance()->GetMpSegmentation(detElemId,AliMp::kCath0);
+    segs[2*n+1] = AliMpSegmentation::Instance()->GetMpSegmentation(detElemId,AliMp::kCath1);
+    // seed 0 would make TRandom3 take its seed from the clock
+    seeds[n] = gRandom->Integer(kMaxInt) + 1;
+    ++n;
+  }
+  
+  // group the DEs sharing a segmentation into tasks, in DE order
+  Int_t* task = new Int_t[nofDEs];
+  for ( Int_t i = 0; i < n; ++i )
+  {
+    task[i] = i;
+    for ( Int_t j = 0; j < i; ++j )
+    {
+      if ( segs[2*i] != segs[2*j] && segs[2*i] != segs[2*j+1] &&
+           segs[2*i+1] != segs[2*j] && segs[2*i+1] != segs[2*j+1] ) continue;
+      Int_t from = TMath::Max(task[i],task[j]);
+      Int_t to = TMath::Min(task[i],task[j]);
+      for ( Int_t k = 0; k <= i; ++k ) if ( task[k] == from ) task[k] = to;
+    }
+  }
+  Int_t* taskFirst = new Int_t[n+1];
+  Int_t* taskDEs = new Int_t[nofDEs];
+  Int_t nTasks(0);
+  taskFirst[0] = 0;
+  for ( Int_t i = 0; i < n; ++i )
+  {
+    if ( task[i] != i ) continue;
+    Int_t next = taskFirst[nTasks];
+    for ( Int_t k = i; k < n; ++k ) if ( task[k] == i ) taskDEs[next++] = k;
+    taskFirst[++nTasks] = next;
+  }
+  
+  nThreads = TMath::Min(nThreads,nTasks);
+  
+  // per thread cluster finders and random generators, per DE cluster arrays
+  if ( !fThreadRandoms )
+  {
+    fThreadRandoms = new TObjArray;
+    fThreadRandoms->SetOwner(kTRUE);
+  }
+  for ( Int_t i = fThreadRandoms->GetEntriesFast(); i < nThreads; ++i ) fThreadRandoms->Add(new TRandom3);
+  
+  if ( !fDEClusters )
+  {
+    fDEClusters = new TObjArray;
+    fDEClusters->SetOwner(kTRUE);
+  }
+  for ( Int_t i = fDEClusters->GetEntriesFast(); i < n; ++i ) fDEClusters->Add(new TClonesArray("AliMUONRawClusterV2",10));
+  
+  AliMUONVClusterFinder** clusterFinders = new AliMUONVClusterFinder*[TMath::Max(nThreads,1)];
+  clusterFinders[0] = fClusterFinder;
+  for ( Int_t i = 1; i < nThreads; ++i )
+  {
+    clusterFinders[i] = static_cast<AliMUONVClusterFinder*>(fThreadClusterFinders->UncheckedAt(i-1));
+  }
+  for ( Int_t i = 0; i < nThreads; ++i )
+  {
+    clusterFinders[i]->SetChargeHints(recoParam.LowestPadCharge(),recoParam.LowestClusterCharge());
+    clusterFinders[i]->SetRandom(static_cast<TRandom*>(fThreadRandoms->UncheckedAt(i)));
+  }
+  
+#ifdef _OPENMP
+  if ( nThreads > 1 ) TThread::Initialize();
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+  for ( Int_t t = 0; t < nTasks; ++t )
+  {
+#ifdef _OPENMP
+    Int_t iThread = omp_get_thread_num();
+#else
+    Int_t iThread = 0;
+#endif
+    for ( Int_t k = taskFirst[t]; k < taskFirst[t+1]; ++k )
+    {
+      Int_t i = taskDEs[k];
+      static_cast<TRandom*>(fThreadRandoms->UncheckedAt(iThread))->SetSeed(seeds[i]);
+      const AliMpVSegmentation* seg[2] = { segs[2*i], segs[2*i+1] };
+      TClonesArray* clusters = static_cast<TClonesArray*>(fDEClusters->UncheckedAt(i));
+      clusters->Clear("C");
+      ClusterizeDE(*clusterFinders[iThread],chamberId,detElemIds[i],&pads[2*i],deAreas[i],seg,recoParam,*clusters);
+    }
+  }
+  
+  // the main cluster finder uses gRandom again in serial clustering
+  fClusterFinder->SetRandom(0x0);
+  
+  // add the clusters to the store in DE order
+  Int_t nofAddedClusters(0);
+  Int_t nCluster = clusterStore.GetSize();
+  
+  for ( Int_t i = 0; i < n; ++i )
+  {
+    Int_t detElemId = detElemIds[i];
+    const AliMpVSegmentation* seg[2] = { segs[2*i], segs[2*i+1] };
+    TClonesArray* clusters = static_cast<TClonesArray*>(fDEClusters->UncheckedAt(i));
+    
+    for ( Int_t j = 0; j <= clusters->GetLast(); ++j )
+    {
+      AliMUONVCluster* cluster = static_cast<AliMUONVCluster*>(clusters->UncheckedAt(j));
+      AliMUONVCluster* rawCluster = clusterStore.Add(chamberId, detElemId, nCluster++);
+      
+      ++nofAddedClusters;
+      
+      for ( Int_t iDigit = 0; iDigit < cluster->GetNDigits(); ++iDigit )
+      {
+        rawCluster->AddDigitId(cluster->GetDigitId(iDigit));
+      }
+      
+      rawCluster->SetCharge(cluster->GetCharge());
+      rawCluster->SetChi2(cluster->GetChi2());
+      
+      Double_t xg, yg, zg;
+      fkTransformer.Local2Global(detElemId, cluster->GetX(), cluster->GetY(), 0, xg, yg, zg);
+      rawCluster->SetXYZ(xg, yg, zg);
+      rawCluster->SetErrXY(recoParam.GetDefaultNonBendingReso(chamberId),recoParam.GetDefaultBendingReso(chamberId));
+      
+      if (fDigitStore && fDigitStore->HasMCInformation()) 
+      {
+        rawCluster->SetMCLabel(FindMCLabel(cluster->GetX(), cluster->GetY(), detElemId, seg));
+      }
+    }
+    
+    clusters->Clear("C");
+  }
+  
+  AliDebug(1,Form("chamberId = %2d NofClusters after = %d (%d DEs, %d tasks in %d threads)",
+                  chamberId,nCluster,n,nTasks,nThreads));
+  
+  delete[] clusterFinders;
+  delete[] taskDEs;
+  delete[] taskFirst;
+  delete[] task;
+  delete[] seeds;
+  delete[] segs;
+  delete[] pads;
+  delete[] deAreas;
+  delete[] detElemIds;
+  
+  return nofAddedClusters;
+}
+
+//_____________________________________________________________________________
+void
+AliMUONSimpleClusterServer::ClusterizeDE(AliMUONVClusterFinder& clusterFinder,
+                                         Int_t chamberId, Int_t detElemId,
+                                         TObjArray* pads[2], const AliMpArea& deArea,
+                                         const AliMpVSegmentation* seg[2],
+                                         const AliMUONRecoParam& recoParam,
+                                         TClonesArray& clusters) const
+{
+  /// Clusterize one detection element into clusters, with their position
+  /// in local coordinates (see ClusterizeParallel)
+  
+  if ( clusterFinder.NeedSegmentation() )
+  {
+    clusterFinder.Prepare(detElemId,pads,deArea,seg);
+  }
+  else
+  {
+    clusterFinder.Prepare(detElemId,pads,deArea);
+  }
+  
+  AliMUONCluster* cluster;
+  
+  while ( ( cluster = clusterFinder.NextCluster() ) ) 
+  {      
+    AliMUONVCluster* rawCluster = 
+      new (clusters[clusters.GetLast()+1]) AliMUONRawClusterV2(chamberId, detElemId, 0);
+    
+    Int_t nPad = cluster->Multiplicity();
+    if (nPad < 1) AliWarning("no pad attached to the cluster");
+    
+    for (Int_t iPad=0; iPad<nPad; iPad++) 
+    {
+      AliMUONPad *pad = cluster->Pad(iPad);
+      
+      // skip virtual pads
+      if (!pad->IsReal()) continue;
+      
+      rawCluster->AddDigitId(pad->GetUniqueID());
+    }
+    
+    rawCluster->SetCharge(cluster->Charge());
+    rawCluster->SetChi2(cluster->Chi2());
+    rawCluster->SetXYZ(cluster->Position().X(), cluster->Position().Y(), 0.);
+    rawCluster->SetErrXY(recoParam.GetDefaultNonBendingReso(chamberId),recoParam.GetDefaultBendingReso(chamberId));
+  }
+}
+
 //_____________________________________________________________________________
 void
 AliMUONSimpleClusterServer::Global2Local(Int_t detElemId, const AliMpArea& globalArea,
@@ -371,9 +674,10 @@ AliMUONSimpleClusterServer::UseDigits(TIter& next, AliMUONVDigitStore* digitStor
 
 //_____________________________________________________________________________
 Int_t
-AliMUONSimpleClusterServer::FindMCLabel(const AliMUONCluster& cluster, Int_t detElemId, const AliMpVSegmentation* seg[2]) const
+AliMUONSimpleClusterServer::FindMCLabel(Double_t x, Double_t y, Int_t detElemId, const AliMpVSegmentation* seg[2]) const
 {
   /// Find the label of the most contributing MC track (-1 in case of failure)
+  /// for the cluster at local position (x,y)
   /// The data member fDigitStore must be set
   
   // --- get the digit (if any) located at the cluster position on both cathods ---
@@ -381,7 +685,7 @@ AliMUONSimpleClusterServer::FindMCLabel(const AliMUONCluster& cluster, Int_t det
   AliMUONVDigit* digit[2] = {0x0, 0x0};
   for (Int_t iCath = 0; iCath < 2; iCath++) {
     AliMpPad pad 
-      = seg[AliMp::GetCathodType(iCath)]->PadByPosition(cluster.Position().X(), cluster.Position().Y(),kFALSE);
+      = seg[AliMp::GetCathodType(iCath)]->PadByPosition(x, y, kFALSE);
     if (pad.IsValid()) {
       digit[iCath] = fDigitStore->FindObject(detElemId, pad.GetManuId(), pad.GetManuChannel(), iCath);
       if (digit[iCath]) nTracks[iCath] = digit[iCath]->Ntracks();
@@ -23,6 +23,7 @@ class AliMUONCluster;
 class AliMpVSegmentation;
 class AliMpExMap;
 class AliMpExMapIterator;
+class AliMUONVCluster;
 class TClonesArray;
 
 class AliMUONSimpleClusterServer : public AliMUONVClusterServer
@@ -45,6 +46,10 @@ public:
   /// Use trigger tracks. Return kFALSE if not used.
   virtual Bool_t UseTriggerTrackStore(AliMUONVTriggerTrackStore* trackStore);
 
+  void AddClusterFinder(AliMUONVClusterFinder* clusterFinder);
+  
+  Int_t GetNofClusterFinders() const;
+
 private:
   /// Not implemented
   AliMUONSimpleClusterServer(const AliMUONSimpleClusterServer& rhs);
@@ -57,7 +62,17 @@ private:
 
   TObjArray* PadArray(Int_t detElemId, Int_t cathode) const;
   
-  Int_t FindMCLabel(const AliMUONCluster& cluster, Int_t detElemId, const AliMpVSegmentation* seg[2]) const;
+  Int_t FindMCLabel(Double_t x, Double_t y, Int_t detElemId, const AliMpVSegmentation* seg[2]) const;
+  
+  Int_t ClusterizeParallel(Int_t chamberId,
+                           AliMUONVClusterStore& clusterStore,
+                           const AliMpArea& area,
+                           const AliMUONRecoParam& recoParam,
+                           Int_t nThreads);
+  
+  void ClusterizeDE(AliMUONVClusterFinder& clusterFinder, Int_t chamberId, Int_t detElemId,
+                    TObjArray* pads[2], const AliMpArea& deArea, const AliMpVSegmentation* seg[2],
+                    const AliMUONRecoParam& recoParam, TClonesArray& clusters) const;
   
 private:
   AliMUONVDigitStore* fDigitStore; //!<! the digit store (not owner)
@@ -67,6 +82,9 @@ private:
   AliMpExMapIterator* fPadsIterator[2]; ///< iterator for the map of TClonesArray of AliMUONPads
   AliMUONVTriggerTrackStore* fTriggerTrackStore; ///< trigger track store (if bypassing of St45 was requested) (not owner)
   AliMUONTriggerTrackToTrackerClusters* fBypass; ///< to convert trigger track into tracker clusters (owner)
+  TObjArray* fThreadClusterFinders; //!<! cluster finders of the additional clustering threads (owner)
+  TObjArray* fThreadRandoms; //!<! random generators of the clustering threads (owner)
+  TObjArray* fDEClusters; //!<! clusters of each detection element in parallel clustering (owner)
   
   ClassDef(AliMUONSimpleClusterServer,0) // Cluster server
 };
@@ -24,6 +24,7 @@
 
 #include "AliMUONTrackExtrap.h" 
 #include "AliMUONTrackParam.h"
+#include "AliMUONAbsorberTable.h"
 #include "AliMUONConstants.h"
 #include "AliMUONReconstructor.h"
 
@@ -34,6 +35,7 @@
 #include <TGeoManager.h>
 #include <TMath.h>
 #include <TDatabasePDG.h>
+#include <TArrayD.h>
 
 #include <Riostream.h>
 
@@ -51,6 +53,7 @@ const Bool_t   AliMUONTrackExtrap::fgkUseHelix = kFALSE;
 const Int_t    AliMUONTrackExtrap::fgkMaxStepNumber = 5000;
 const Double_t AliMUONTrackExtrap::fgkHelixStepLength = 6.;
 const Double_t AliMUONTrackExtrap::fgkRungeKuttaMaxResidue = 0.002;
+      AliMUONAbsorberTable* AliMUONTrackExtrap::fgAbsorberTable = 0x0;
 
 //__________________________________________________________________________
 void AliMUONTrackExtrap::SetField()
@@ -564,13 +567,40 @@ void AliMUONTrackExtrap::CorrectELossEffectInAbsorber(AliMUONTrackParam* param,
   param->SetCovariances(newParamCov);
 }
 
+//__________________________________________________________________________
+Bool_t AliMUONTrackExtrap::UseAbsorberTable(const char* fileName)
+{
+  /// Read the table of the absorber material from the file, or build it from the
+  /// current geometry and store it in the file if it does not match.
+  /// The table is then used by GetAbsorberCorrectionParam for tracks crossing
+  /// the whole absorber, the geometry being navigated for the others
+  ResetAbsorberTable();
+  fgAbsorberTable = AliMUONAbsorberTable::Load(fileName, AliMUONConstants::AbsZBeg(), AliMUONConstants::AbsZEnd());
+  if (!fgAbsorberTable) {
+    cout<<"E-AliMUONTrackExtrap::UseAbsorberTable: no absorber table, the geometry will be navigated"<<endl;
+    return kFALSE;
+  }
+  return kTRUE;
+}
+
+//__________________________________________________________________________
+void AliMUONTrackExtrap::ResetAbsorberTable()
+{
+  /// Stop using the absorber table
+  delete fgAbsorberTable;
+  fgAbsorberTable = 0x0;
+}
+
 //__________________________________________________________________________
 Bool_t AliMUONTrackExtrap::GetAbsorberCorrectionParam(Double_t trackXYZIn[3], Double_t trackXYZOut[3], Double_t pTotal,
 						      Double_t &pathLength, Double_t &f0, Double_t &f1, Double_t &f2,
-						      Double_t &meanRho, Double_t &totalELoss, Double_t &sigmaELoss2)
+						      Double_t &meanRho, Double_t &totalELoss, Double_t &sigmaELoss2,
+						      Bool_t useTable)
 {
   /// Parameters used to correct for Multiple Coulomb Scattering and energy loss in absorber
   /// Calculated assuming a linear propagation from trackXYZIn to trackXYZOut (order is important)
+  /// Taken from the absorber table if it is in use, useTable is set and the track crosses the
+  /// whole absorber, otherwise obtained by navigating through the geometry
   // pathLength: path length between trackXYZIn and trackXYZOut (cm)
   // f0:         0th moment of z calculated with the inverse radiation-length distribution
   // f1:         1st moment of z calculated with the inverse radiation-length distribution
@@ -587,6 +617,30 @@ Bool_t AliMUONTrackExtrap::GetAbsorberCorrectionParam(Double_t trackXYZIn[3], Do
   totalELoss = 0.;
   sigmaELoss2 = 0.;
   
+  // Use the absorber table if possible
+  if (useTable && fgAbsorberTable) {
+    TArrayD values(fgAbsorberTable->GetNValues());
+    if (fgAbsorberTable->Interpolate(trackXYZIn, trackXYZOut, values.GetArray())) {
+      pathLength = TMath::Sqrt((trackXYZOut[0] - trackXYZIn[0])*(trackXYZOut[0] - trackXYZIn[0])+
+			       (trackXYZOut[1] - trackXYZIn[1])*(trackXYZOut[1] - trackXYZIn[1])+
+			       (trackXYZOut[2] - trackXYZIn[2])*(trackXYZOut[2] - trackXYZIn[2]));
+      f0 = values[AliMUONAbsorberTable::kF0] * pathLength;
+      f1 = values[AliMUONAbsorberTable::kF1] * pathLength * pathLength;
+      f2 = values[AliMUONAbsorberTable::kF2] * pathLength * pathLength * pathLength;
+      meanRho = values[AliMUONAbsorberTable::kRho];
+      // the energy loss is additive per material, its fluctuation is proportional to rho*Z/A
+      for (Int_t iMat = 0; iMat < fgAbsorberTable->GetNMaterials(); iMat++) {
+	Double_t localPathLength = values[AliMUONAbsorberTable::kNFixed + iMat] * pathLength;
+	if (localPathLength <= 0.) continue;
+	totalELoss += BetheBloch(pTotal, localPathLength, fgAbsorberTable->GetMaterialRho(iMat),
+				 fgAbsorberTable->GetMaterialZ(iMat), fgAbsorberTable->GetMaterialZoverA(iMat));
+      }
+      Double_t sigmaELoss = EnergyLossFluctuation(pTotal, pathLength, values[AliMUONAbsorberTable::kRhoZoverA], 1.);
+      sigmaELoss2 = sigmaELoss*sigmaELoss;
+      return kTRUE;
+    }
+  }
+  
   // Check whether the geometry is available
   if (!gGeoManager) {
     cout<<"E-AliMUONTrackExtrap::GetAbsorberCorrectionParam: no TGeo"<<endl;
@@ -19,6 +19,7 @@
 
 class AliMagF;
 class AliMUONTrackParam;
+class AliMUONAbsorberTable;
 
 class AliMUONTrackExtrap : public TObject 
 {
@@ -75,6 +76,16 @@ class AliMUONTrackExtrap : public TObject
   
   static Bool_t ExtrapOneStepRungekutta(Double_t charge, Double_t step, const Double_t* vect, Double_t* vout);
   
+  // Use the tabulated absorber material instead of the geometry navigation when possible
+  static Bool_t UseAbsorberTable(const char* fileName = "MUONAbsorberTable.root");
+  static void   ResetAbsorberTable();
+  /// return the absorber table in use, if any
+  static const AliMUONAbsorberTable* GetAbsorberTable() {return fgAbsorberTable;}
+  
+  static Bool_t GetAbsorberCorrectionParam(Double_t trackXYZIn[3], Double_t trackXYZOut[3], Double_t pTotal,
+                                           Double_t &pathLength, Double_t &f0, Double_t &f1, Double_t &f2,
+                                           Double_t &meanRho, Double_t &totalELoss, Double_t &sigmaELoss2,
+                                           Bool_t useTable = kTRUE);
   
  private:
   static const Double_t fgkSimpleBPosition;     //!<! position of the dipole
@@ -85,6 +96,7 @@ class AliMUONTrackExtrap : public TObject
   static const Int_t    fgkMaxStepNumber;	//!<! Maximum number of steps for track extrapolation
   static const Double_t fgkHelixStepLength;	//!<! Step lenght for track extrapolation (used in Helix)
   static const Double_t fgkRungeKuttaMaxResidue;//!<! Maximal distance (in Z) to destination to stop the track extrapolation (used in Runge-Kutta)
+  static AliMUONAbsorberTable* fgAbsorberTable; //!<! Tabulated absorber material (0x0 if not used)
   
   // Functions
 
@@ -110,9 +122,6 @@ class AliMUONTrackExtrap : public TObject
                                          Double_t errXVtx, Double_t errYVtx,
                                          Double_t absZBeg, Double_t pathLength, Double_t f0, Double_t f1, Double_t f2);
   static void CorrectELossEffectInAbsorber(AliMUONTrackParam* param, Double_t eLoss, Double_t sigmaELoss2);
-  static Bool_t GetAbsorberCorrectionParam(Double_t trackXYZIn[3], Double_t trackXYZOut[3], Double_t pTotal,
-                                           Double_t &pathLength, Double_t &f0, Double_t &f1, Double_t &f2,
-                                           Double_t &meanRho, Double_t &totalELoss, Double_t &sigmaELoss2);
   
   static Double_t BetheBloch(Double_t pTotal, Double_t pathLength, Double_t rho, Double_t atomicZ, Double_t atomicZoverA);
   static Double_t EnergyLossFluctuation(Double_t pTotal, Double_t pathLength, Double_t rho, Double_t atomicZoverA);
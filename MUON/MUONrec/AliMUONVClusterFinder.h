@@ -21,6 +21,7 @@ class AliMUONRecoParam;
 class AliMpVSegmentation;
 class AliMUONPad;
 class AliMpArea;
+class TRandom;
 
 class AliMUONVClusterFinder : public TObject
 {
@@ -59,6 +60,16 @@ public:
    */
   virtual void SetChargeHints(Double_t /*lowestPadCharge*/, Double_t /*lowestClusterCharge*/) { }
   
+  /** Whether several instances of this cluster finder can work at the same
+   time, in different threads, on different detection elements. This is
+   not the case of cluster finders using the global fitter or other shared
+   objects.
+   */
+  virtual Bool_t IsThreadSafe() const { return kFALSE; }
+  
+  /// Set the random generator to be used instead of gRandom, if any (not owner)
+  virtual void SetRandom(TRandom* /*random*/) { }
+  
   ClassDef(AliMUONVClusterFinder,0) // Interface of a MUON cluster finder.
 };
 
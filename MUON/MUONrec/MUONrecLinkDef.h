@@ -20,6 +20,7 @@
 #pragma link C++ class AliMUONTrack+; 
 #pragma link C++ class AliMUONTrackParam+; 
 #pragma link C++ class AliMUONTrackExtrap+; 
+#pragma link C++ class AliMUONAbsorberTable+;
 #pragma link C++ class AliMUONTriggerTrack+; 
 #pragma link C++ class AliMUONVClusterFinder+;
 #pragma link C++ class AliMUONPad+;
@@ -0,0 +1,357 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//               Implementation of the AliESDfriendStore class
+//
+//  The store keeps the ESD friend tracks of a file in the tree
+//  "friendTracks", one track per entry, with the ESD track ID in a
+//  separate branch. The tree "friendIndex" holds per event the first
+//  entry and the number of tracks. The index is read completely when the
+//  store is opened, the track payload only on request, so that only the
+//  baskets of the selected tracks are read and decompressed.
+//
+//  Only the friend tracks are stored; the event level friend information
+//  (VZERO, TZERO, TPC occupancy) stays in the standard friend file.
+//
+//  Usage:
+//    AliESDfriendStore::Convert("AliESDfriends.root", "AliESDfriendStore.root");
+//    AliESDfriendStore* store = AliESDfriendStore::Open("AliESDfriendStore.root");
+//    Int_t iTrack = store->FindTrack(iEvent, esdTrack->GetID());
+//    if (iTrack >= 0) AliESDfriendTrack* friendTrack = store->GetTrack(iEvent, iTrack);
+//-------------------------------------------------------------------------
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TBranch.h>
+#include <TBits.h>
+
+#include "AliLog.h"
+#include "AliESDfriend.h"
+#include "AliESDfriendTrack.h"
+#include "AliESDfriendStore.h"
+
+ClassImp(AliESDfriendStore)
+
+//_____________________________________________________________________________
+AliESDfriendStore::AliESDfriendStore():
+  TObject(),
+  fFile(0),
+  fTrackTree(0),
+  fIndexTree(0),
+  fTrackBranch(0),
+  fIDBranch(0),
+  fTrack(0),
+  fESDtrackID(-1),
+  fFirst(0),
+  fNTrackBuf(0),
+  fWritable(kFALSE),
+  fFirstEntry(),
+  fNTracks(),
+  fIDCache(),
+  fIDCacheEvent(-1)
+{
+  //
+  // Default constructor, use Create or Open
+  //
+}
+
+//_____________________________________________________________________________
+AliESDfriendStore::~AliESDfriendStore()
+{
+  //
+  // Destructor
+  //
+  Close();
+}
+
+//_____________________________________________________________________________
+AliESDfriendStore* AliESDfriendStore::Create(const char* fileName, Int_t basketSize)
+{
+  //
+  // Create a new store for writing. Small baskets keep the amount of data
+  // decompressed per random access low
+  //
+  TFile* file = TFile::Open(fileName, "RECREATE");
+  if (!file || file->IsZombie()) {
+    AliErrorClass(Form("Cannot create %s", fileName));
+    delete file;
+    return 0;
+  }
+
+  AliESDfriendStore* store = new AliESDfriendStore();
+  store->fFile = file;
+  store->fWritable = kTRUE;
+  store->fTrackTree = new TTree("friendTracks", "ESD friend tracks");
+  store->fTrackTree->Branch("ESDtrackID", &store->fESDtrackID, "ESDtrackID/I", basketSize);
+  store->fTrackTree->Branch("FriendTrack.", "AliESDfriendTrack", &store->fTrack, basketSize);
+  store->fIndexTree = new TTree("friendIndex", "ESD friend track index");
+  store->fIndexTree->Branch("first", &store->fFirst, "first/L");
+  store->fIndexTree->Branch("ntracks", &store->fNTrackBuf, "ntracks/I");
+  return store;
+}
+
+//_____________________________________________________________________________
+Int_t AliESDfriendStore::WriteEvent(const AliESDfriend* friendEvent)
+{
+  //
+  // Append the friend tracks of one event, returns the number of tracks
+  // stored. An event without friend information gets an empty index entry
+  // to keep the event numbering aligned with the ESD tree
+  //
+  if (!fWritable) {
+    AliError("Store not opened for writing");
+    return -1;
+  }
+
+  fFirst = fTrackTree->GetEntries();
+  fNTrackBuf = 0;
+  if (friendEvent) {
+    const Bool_t sparse = friendEvent->GetESDIndicesStored();
+    const Int_t ntr = friendEvent->GetNumberOfTracks();
+    for (Int_t i=0; i<ntr; i++) {
+      AliESDfriendTrack* track = friendEvent->GetTrack(i);
+      if (!track) continue;
+      fESDtrackID = sparse ? track->GetESDtrackID() : i;
+      fTrack = track;
+      fTrackTree->Fill();
+      fNTrackBuf++;
+    }
+  }
+  fTrack = 0;
+  fIndexTree->Fill();
+  return fNTrackBuf;
+}
+
+//_____________________________________________________________________________
+void AliESDfriendStore::Close()
+{
+  //
+  // Write the trees if needed and close the file
+  //
+  if (!fFile) return;
+  if (fWritable) {
+    fFile->cd();
+    fTrackTree->Write();
+    fIndexTree->Write();
+  }
+  delete fFile; // deletes the trees
+  fFile = 0;
+  fTrackTree = 0;
+  fIndexTree = 0;
+  fTrackBranch = 0;
+  fIDBranch = 0;
+  if (!fWritable) delete fTrack;
+  fTrack = 0;
+  fWritable = kFALSE;
+  fFirstEntry.Set(0);
+  fNTracks.Set(0);
+  fIDCacheEvent = -1;
+}
+
+//_____________________________________________________________________________
+Int_t AliESDfriendStore::Convert(const char* friendFileName, const char* storeFileName, const char* treeName)
+{
+  //
+  // Convert a standard ESD friend file into a store, returns the number
+  // of events converted or -1 in case of error
+  //
+  TFile* in = TFile::Open(friendFileName);
+  if (!in || in->IsZombie()) {
+    AliErrorClass(Form("Cannot open %s", friendFileName));
+    delete in;
+    return -1;
+  }
+  TTree* tree = dynamic_cast<TTree*>(in->Get(treeName));
+  if (!tree || !tree->GetBranch("ESDfriend.")) {
+    AliErrorClass(Form("No tree %s with branch ESDfriend. in %s", treeName, friendFileName));
+    delete in;
+    return -1;
+  }
+
+  AliESDfriendStore* store = Create(storeFileName);
+  if (!store) {
+    delete in;
+    return -1;
+  }
+
+  AliESDfriend* friendEvent = 0;
+  tree->SetBranchAddress("ESDfriend.", &friendEvent);
+  const Int_t nev = tree->GetEntries();
+  for (Int_t iev=0; iev<nev; iev++) {
+    tree->GetEntry(iev);
+    if (friendEvent) friendEvent->SetOwner();
+    store->WriteEvent(friendEvent);
+  }
+  store->Close();
+  delete store;
+  delete in;
+  delete friendEvent;
+  return nev;
+}
+
+//_____________________________________________________________________________
+AliESDfriendStore* AliESDfriendStore::Open(const char* fileName)
+{
+  //
+  // Open a store for reading, the index is loaded into memory
+  //
+  TFile* file = TFile::Open(fileName);
+  if (!file || file->IsZombie()) {
+    AliErrorClass(Form("Cannot open %s", fileName));
+    delete file;
+    return 0;
+  }
+  TTree* trackTree = dynamic_cast<TTree*>(file->Get("friendTracks"));
+  TTree* indexTree = dynamic_cast<TTree*>(file->Get("friendIndex"));
+  if (!trackTree || !indexTree) {
+    AliErrorClass(Form("%s is not an ESD friend store", fileName));
+    delete file;
+    return 0;
+  }
+
+  AliESDfriendStore* store = new AliESDfriendStore();
+  store->fFile = file;
+  store->fTrackTree = trackTree;
+  store->fIndexTree = indexTree;
+
+  // random access: no read ahead of baskets which are not requested
+  trackTree->SetCacheSize(0);
+  store->fTrackBranch = trackTree->GetBranch("FriendTrack.");
+  store->fIDBranch = trackTree->GetBranch("ESDtrackID");
+  store->fTrackBranch->SetAddress(&store->fTrack);
+  store->fIDBranch->SetAddress(&store->fESDtrackID);
+
+  indexTree->SetBranchAddress("first", &store->fFirst);
+  indexTree->SetBranchAddress("ntracks", &store->fNTrackBuf);
+  const Int_t nev = indexTree->GetEntries();
+  store->fFirstEntry.Set(nev);
+  store->fNTracks.Set(nev);
+  for (Int_t iev=0; iev<nev; iev++) {
+    indexTree->GetEntry(iev);
+    store->fFirstEntry[iev] = store->fFirst;
+    store->fNTracks[iev] = store->fNTrackBuf;
+  }
+  return store;
+}
+
+//_____________________________________________________________________________
+Int_t AliESDfriendStore::GetNumberOfTracks(Int_t iEvent) const
+{
+  //
+  // Number of friend tracks stored for event iEvent
+  //
+  if (iEvent<0 || iEvent>=fNTracks.GetSize()) return 0;
+  return fNTracks[iEvent];
+}
+
+//_____________________________________________________________________________
+Long64_t AliESDfriendStore::GetEntry(Int_t iEvent, Int_t iTrack) const
+{
+  //
+  // Tree entry of track iTrack of event iEvent, -1 if out of range
+  //
+  if (iTrack<0 || iTrack>=GetNumberOfTracks(iEvent)) return -1;
+  return fFirstEntry[iEvent] + iTrack;
+}
+
+//_____________________________________________________________________________
+Int_t AliESDfriendStore::GetESDtrackID(Int_t iEvent, Int_t iTrack)
+{
+  //
+  // ESD track ID of friend track iTrack of event iEvent, only the ID
+  // branch is read
+  //
+  const Long64_t entry = GetEntry(iEvent, iTrack);
+  if (entry<0 || !fIDBranch) return -1;
+  if (fIDCacheEvent == iEvent) return fIDCache[iTrack];
+  fIDBranch->GetEntry(entry);
+  return fESDtrackID;
+}
+
+//_____________________________________________________________________________
+Bool_t AliESDfriendStore::CacheIDs(Int_t iEvent)
+{
+  //
+  // Read the ESD track IDs of event iEvent into fIDCache, unless they are
+  // already there. Returns kFALSE if the event has no tracks
+  //
+  const Int_t ntr = GetNumberOfTracks(iEvent);
+  if (!ntr || !fIDBranch) return kFALSE;
+  if (fIDCacheEvent != iEvent) {
+    fIDCache.Set(ntr);
+    for (Int_t i=0; i<ntr; i++) {
+      fIDBranch->GetEntry(fFirstEntry[iEvent] + i);
+      fIDCache[i] = fESDtrackID;
+    }
+    fIDCacheEvent = iEvent;
+  }
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+Int_t AliESDfriendStore::FindTrack(Int_t iEvent, Int_t esdTrackID)
+{
+  //
+  // Index of the friend track of ESD track esdTrackID in event iEvent,
+  // -1 if not stored. The IDs of the event are read once and kept
+  //
+  const Int_t ntr = GetNumberOfTracks(iEvent);
+  if (esdTrackID<0 || !CacheIDs(iEvent)) return -1;
+  // the IDs are stored in increasing order for standard friends
+  if (esdTrackID<ntr && fIDCache[esdTrackID]==esdTrackID) return esdTrackID;
+  for (Int_t i=0; i<ntr; i++) if (fIDCache[i]==esdTrackID) return i;
+  return -1;
+}
+
+//_____________________________________________________________________________
+AliESDfriendTrack* AliESDfriendStore::GetTrack(Int_t iEvent, Int_t iTrack)
+{
+  //
+  // Read friend track iTrack of event iEvent. The object is owned by the
+  // store and overwritten by the next call
+  //
+  const Long64_t entry = GetEntry(iEvent, iTrack);
+  if (entry<0 || !fTrackBranch) return 0;
+  if (fTrackBranch->GetEntry(entry) <= 0) return 0;
+  if (fTrack) fTrack->SetOwner();
+  return fTrack;
+}
+
+//_____________________________________________________________________________
+Int_t AliESDfriendStore::LoadEvent(Int_t iEvent, AliESDfriend &friendEvent, const TBits* selection)
+{
+  //
+  // Fill friendEvent with the friend tracks of event iEvent whose ESD track
+  // ID is set in selection (all tracks if selection is 0). The tracks are
+  // stored sparse, i.e. with the ESD track ID, returns the number of
+  // tracks loaded
+  //
+  friendEvent.Reset();
+  friendEvent.SetESDIndicesStored(kTRUE);
+  if (!CacheIDs(iEvent)) return 0;
+  const Int_t ntr = GetNumberOfTracks(iEvent);
+  Int_t nloaded = 0;
+  for (Int_t i=0; i<ntr; i++) {
+    const Int_t id = fIDCache[i];
+    if (selection && (id<0 || !selection->TestBitNumber(id))) continue;
+    AliESDfriendTrack* track = GetTrack(iEvent, i);
+    if (!track) continue;
+    AliESDfriendTrack* added = friendEvent.AddTrack(track);
+    added->SetESDtrackID(id);
+    nloaded++;
+  }
+  return nloaded;
+}
@@ -0,0 +1,73 @@
+#ifndef ALIESDFRIENDSTORE_H
+#define ALIESDFRIENDSTORE_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//                     Class AliESDfriendStore
+//   Side-car file with the ESD friend tracks stored one per tree entry
+//   and an index of the first entry and number of tracks per event, such
+//   that the friend payload of selected tracks can be read without
+//   streaming the full AliESDfriend of the event
+//-------------------------------------------------------------------------
+
+#include <TObject.h>
+#include <TString.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
+
+class TFile;
+class TTree;
+class TBranch;
+class TBits;
+class AliESDfriend;
+class AliESDfriendTrack;
+
+//_____________________________________________________________________________
+class AliESDfriendStore : public TObject {
+public:
+  AliESDfriendStore();
+  virtual ~AliESDfriendStore();
+
+  // writing
+  static AliESDfriendStore* Create(const char* fileName, Int_t basketSize=16000);
+  Int_t  WriteEvent(const AliESDfriend* friendEvent);
+  void   Close();
+  static Int_t Convert(const char* friendFileName, const char* storeFileName, const char* treeName="esdFriendTree");
+
+  // reading
+  static AliESDfriendStore* Open(const char* fileName);
+  Int_t  GetNumberOfEvents() const {return fNTracks.GetSize();}
+  Int_t  GetNumberOfTracks(Int_t iEvent) const;
+  Int_t  GetESDtrackID(Int_t iEvent, Int_t iTrack);
+  Int_t  FindTrack(Int_t iEvent, Int_t esdTrackID);
+  AliESDfriendTrack* GetTrack(Int_t iEvent, Int_t iTrack);
+  Int_t  LoadEvent(Int_t iEvent, AliESDfriend &friendEvent, const TBits* selection=0);
+
+private:
+  AliESDfriendStore(const AliESDfriendStore&);
+  AliESDfriendStore& operator=(const AliESDfriendStore&);
+
+  Long64_t GetEntry(Int_t iEvent, Int_t iTrack) const;
+  Bool_t   CacheIDs(Int_t iEvent);
+
+  TFile*             fFile;        //! side-car file
+  TTree*             fTrackTree;   //! friend tracks, one per entry
+  TTree*             fIndexTree;   //! index, one entry per event
+  TBranch*           fTrackBranch; //! branch with the friend track payload
+  TBranch*           fIDBranch;    //! branch with the ESD track ID
+  AliESDfriendTrack* fTrack;       //! buffer for the friend track
+  Int_t              fESDtrackID;  //! buffer for the ESD track ID
+  Long64_t           fFirst;       //! buffer for the first entry of an event
+  Int_t              fNTrackBuf;   //! buffer for the number of tracks of an event
+  Bool_t             fWritable;    //! file opened for writing
+  TArrayL64          fFirstEntry;  //! first track entry per event
+  TArrayI            fNTracks;     //! number of tracks per event
+  TArrayI            fIDCache;     //! ESD track IDs of the event fIDCacheEvent
+  Int_t              fIDCacheEvent;//! event of fIDCache
+
+  ClassDef(AliESDfriendStore,1) // random access store of ESD friend tracks
+};
+
+#endif
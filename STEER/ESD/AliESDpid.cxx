@@ -25,6 +25,7 @@
 
 #include "TArrayI.h"
 #include "TArrayF.h"
+#include "TArrayD.h"
 
 #include "AliLog.h"
 #include "AliPID.h"
@@ -54,10 +55,11 @@ Int_t AliESDpid::MakePID(AliESDEvent *event, Bool_t TPConly, Float_t /*timeZeroT
   if (subtractT0)
     timeZeroTOF = event->GetT0();
   */
+  MakeTPCPID(event);
+
   Int_t nTrk=event->GetNumberOfTracks();
   for (Int_t iTrk=0; iTrk<nTrk; iTrk++) {
     AliESDtrack *track=event->GetTrack(iTrk);
-    MakeTPCPID(track);
     if (!TPConly) {
       MakeITSPID(track);
       //MakeTOFPID(track, timeZeroTOF);
@@ -82,23 +84,82 @@ void AliESDpid::MakeTPCPID(AliESDtrack *track) const
     const AliExternalTrackParam *in=track->GetInnerParam();
     if (in) mom = in->GetP();
 
-    Double_t p[AliPID::kSPECIES];
     Double_t dedx=track->GetTPCsignal();
-    Bool_t mismatch=kTRUE, heavy=kTRUE;
+    Double_t bethe[AliPID::kSPECIES], sigma[AliPID::kSPECIES];
 
     for (Int_t j=0; j<AliPID::kSPECIES; j++) {
       AliPID::EParticleType type=AliPID::EParticleType(j);
-      Double_t bethe=fTPCResponse.GetExpectedSignal(mom,type);
-      Double_t sigma=fTPCResponse.GetExpectedSigma(mom,track->GetTPCsignalN(),type);
-      if (TMath::Abs(dedx-bethe) > fRange*sigma) {
-	p[j]=TMath::Exp(-0.5*fRange*fRange)/sigma;
+      bethe[j]=fTPCResponse.GetExpectedSignal(mom,type);
+      sigma[j]=fTPCResponse.GetExpectedSigma(mom,track->GetTPCsignalN(),type);
+    }
+
+    FillTPCpid(track,dedx,bethe,sigma,1);
+}
+//_________________________________________________________________________
+void AliESDpid::MakeTPCPID(AliESDEvent *event) const
+{
+  //
+  //  TPC pid of all the tracks of the event, same as MakeTPCPID(track):
+  //  the momenta and number of clusters of the tracks with TPC information
+  //  are collected first, then the expected signals and resolutions are
+  //  computed for all of them species by species, and the probabilities
+  //  are set in the tracks
+  //
+  Int_t nTrk=event->GetNumberOfTracks();
+  TArrayI index(nTrk);
+  TArrayF mom(nTrk);
+  TArrayI nPoints(nTrk);
+
+  Int_t n=0;
+  for (Int_t iTrk=0; iTrk<nTrk; iTrk++) {
+    AliESDtrack *track=event->GetTrack(iTrk);
+    if ((track->GetStatus()&AliESDtrack::kTPCin )==0)
+      if ((track->GetStatus()&AliESDtrack::kTPCout)==0) continue;
+
+    const AliExternalTrackParam *in=track->GetInnerParam();
+    index[n]   = iTrk;
+    mom[n]     = in ? in->GetP() : track->GetP();
+    nPoints[n] = track->GetTPCsignalN();
+    n++;
+  }
+  if (n==0) return;
+
+  // expected signals and resolutions, species after species
+  TArrayD bethe(AliPID::kSPECIES*n), sigma(AliPID::kSPECIES*n);
+  for (Int_t j=0; j<AliPID::kSPECIES; j++) {
+    AliPID::EParticleType type=AliPID::EParticleType(j);
+    fTPCResponse.GetExpectedSignals(n,mom.GetArray(),type,bethe.GetArray()+j*n);
+    fTPCResponse.GetExpectedSigmas(n,nPoints.GetArray(),bethe.GetArray()+j*n,sigma.GetArray()+j*n);
+  }
+
+  for (Int_t i=0; i<n; i++) {
+    AliESDtrack *track=event->GetTrack(index[i]);
+    FillTPCpid(track,track->GetTPCsignal(),bethe.GetArray()+i,sigma.GetArray()+i,n);
+  }
+}
+//_________________________________________________________________________
+void AliESDpid::FillTPCpid(AliESDtrack *track, Double_t dedx,
+                           const Double_t *bethe, const Double_t *sigma, Int_t stride) const
+{
+  //
+  //  Set the TPC pid of the track from the gaussian response, given the
+  //  expected signals and resolutions of the species, stride apart
+  //
+    Double_t p[AliPID::kSPECIES];
+    Bool_t mismatch=kTRUE, heavy=kTRUE;
+
+    for (Int_t j=0; j<AliPID::kSPECIES; j++) {
+      Double_t bb=bethe[j*stride];
+      Double_t sig=sigma[j*stride];
+      if (TMath::Abs(dedx-bb) > fRange*sig) {
+	p[j]=TMath::Exp(-0.5*fRange*fRange)/sig;
       } else {
-        p[j]=TMath::Exp(-0.5*(dedx-bethe)*(dedx-bethe)/(sigma*sigma))/sigma;
+        p[j]=TMath::Exp(-0.5*(dedx-bb)*(dedx-bb)/(sig*sig))/sig;
         mismatch=kFALSE;
       }
 
       // Check for particles heavier than (AliPID::kSPECIES - 1)
-      if (dedx < (bethe + fRange*sigma)) heavy=kFALSE;
+      if (dedx < (bb + fRange*sig)) heavy=kFALSE;
 
     }
 
@@ -146,8 +207,8 @@ void AliESDpid::MakeITSPID(AliESDtrack *track) const
 
     Bool_t mismatch=kTRUE, heavy=kTRUE;
     for (Int_t j=0; j<AliPID::kSPECIES; j++) {
-      Double_t mass=AliPID::ParticleMass(j);//GeV/c^2
-      Double_t bethe=fITSResponse.Bethe(momITS,mass);
+      AliPID::EParticleType type=AliPID::EParticleType(j);
+      Double_t bethe=fITSResponse.Bethe(momITS,type);
       Double_t sigma=fITSResponse.GetResolution(bethe,nPointsForPid,isSA);
       if (TMath::Abs(dedx-bethe) > fRange*sigma) {
 	p[j]=TMath::Exp(-0.5*fRange*fRange)/sigma;
@@ -35,6 +35,7 @@ AliESDpid& operator=(const AliESDpid& a){if (this==&a) return *this; AliPIDRespo
   void  MakePIDForTracking(AliESDEvent *event) const;
 
   void MakeTPCPID(AliESDtrack *track) const;
+  void MakeTPCPID(AliESDEvent *event) const;
   void MakeITSPID(AliESDtrack *track) const;
   void MakeTOFPID(AliESDtrack *track, Float_t /*timeZeroTOF*/) const;
   Bool_t CheckTOFMatching(AliESDtrack *track) const;
@@ -56,6 +57,7 @@ protected:
   virtual Float_t GetNumberOfSigmasTOFold(const AliVParticle *track, AliPID::EParticleType type) const;
 
 private:
+  void FillTPCpid(AliESDtrack *track, Double_t dedx, const Double_t *bethe, const Double_t *sigma, Int_t stride) const;
 
   Float_t           fRangeTOFMismatch; // nSigma max for TOF matching with TPC
   AliVEventHandler *fEventHandler; //! MC event handler
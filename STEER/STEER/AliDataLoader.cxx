@@ -32,6 +32,7 @@
 #include "AliLog.h"
 
 #include <TFile.h>
+#include <TTree.h>
 #include <TROOT.h>
 #include <TString.h>
 #include <TBits.h>
@@ -48,7 +49,8 @@ AliDataLoader::AliDataLoader():
  fNEventsPerFile(0),
  fBaseLoaders(0x0),
  fEventFolder(0x0),
- fFolder(0x0)
+ fFolder(0x0),
+ fKeepLoaded(kFALSE)
 {
   
 }
@@ -65,7 +67,8 @@ AliDataLoader::AliDataLoader(const char* filename, const char* contname,
  fNEventsPerFile(0),
  fBaseLoaders(new TObjArray(4)),
  fEventFolder(0x0),
- fFolder(0x0)
+ fFolder(0x0),
+ fKeepLoaded(kFALSE)
 {
   //constructor
   // creates a 0 loader, depending on option, default "T" is specialized loader for trees
@@ -256,10 +259,35 @@ void AliDataLoader::Unload()
 {
   //
   //unloads main data -  shortcut method 
+  //data kept in memory (see SetKeepLoaded) stay loaded
   //
+  if (fKeepLoaded)
+    {
+      AliDebug(1, Form("%s are kept in memory, not unloaded",GetName()));
+      return;
+    }
   GetBaseLoader(0)->Unload();
 }
 
+//______________________________________________________________________________
+void AliDataLoader::SetKeepLoaded(Bool_t keep)
+{
+  //
+  // Keeps the main data in memory once loaded: Unload() leaves them in place
+  // and the baskets of the tree are read into memory at the first Load(), so
+  // that the same event can be processed several times without going back
+  // to the file (e.g. background sdigits used for several signal events).
+  // Switching it off unloads the data.
+  //
+  if (fKeepLoaded && !keep)
+    {
+      fKeepLoaded = kFALSE;
+      Unload();
+      return;
+    }
+  fKeepLoaded = keep;
+}
+
 //______________________________________________________________________________
 void AliDataLoader::UnloadAll()
 {
@@ -335,7 +363,10 @@ Int_t AliDataLoader::Load(Option_t* opt)
   //
   // Writes primary data ==  first BaseLoader
   //
-  return GetBaseLoader(0)->Load(opt);
+  Bool_t cache = fKeepLoaded && !GetBaseLoader(0)->IsLoaded();
+  Int_t retval = GetBaseLoader(0)->Load(opt);
+  if (retval == 0 && cache && Tree()) Tree()->LoadBaskets();
+  return retval;
 }
 
 //______________________________________________________________________________
@@ -95,6 +95,9 @@ class AliDataLoader: public TNamed
    
    void Synchronize();
 
+   void               SetKeepLoaded(Bool_t keep);//keep main data in memory, Unload() does nothing
+   Bool_t             GetKeepLoaded() const {return fKeepLoaded;}
+
   protected:
    AliRunLoader*      GetRunLoader();//gets the run-loader from event folder
 
@@ -113,6 +116,7 @@ class AliDataLoader: public TNamed
 
    TFolder*     fEventFolder;//!event folder
    TFolder*     fFolder;//! folder with data
+   Bool_t       fKeepLoaded;//! main data stay in memory after Unload()
    
    ClassDef(AliDataLoader,3)
  };
@@ -128,6 +128,7 @@ AliDigitizationInput::AliDigitizationInput(): TNamed("AliDigitizationInput","The
  fNinputs(0),
  fNinputsGiven(0),
  fRegionOfInterest(kFALSE),
+ fCacheBkgrdSDigits(kTRUE),
  fInputStreams(0x0),
  fOutRunLoader(0x0),
  fOutputInitialized(kFALSE),
@@ -154,6 +155,7 @@ AliDigitizationInput::AliDigitizationInput(Int_t nInputStreams, Int_t sperb):
  fNinputs(nInputStreams),
  fNinputsGiven(0),
  fRegionOfInterest(kFALSE),
+ fCacheBkgrdSDigits(kTRUE),
  fInputStreams(new TClonesArray("AliStream",nInputStreams)),
  fOutRunLoader(0x0),
  fOutputInitialized(kFALSE),
@@ -233,15 +235,20 @@ Bool_t AliDigitizationInput::ConnectInputTrees()
 {
   //
   // loads events 
+  // background events used for several signal events keep their
+  // sdigits in memory until the next background event is loaded
   //
   Int_t eventNr[MAXSTREAMSTOMERGE], delta[MAXSTREAMSTOMERGE];
   fCombi->Combination(eventNr, delta);
+  Bool_t cache = fCacheBkgrdSDigits && (fCombi->GetSperb() > 1);
   for (Int_t i=0;i<fNinputs;i++) 
    {
     if (delta[i] == 1)
      {
       AliStream *iStream = static_cast<AliStream*>(fInputStreams->At(i));//gets the "i" defined  in combination
+      if (cache && i > 0) KeepSDigits(i, kFALSE);
       if (!iStream->NextEventInStream()) return kFALSE; //sets serial number
+      if (cache && i > 0) KeepSDigits(i, kTRUE);
      } 
     else if (delta[i] != 0) 
      {
@@ -254,6 +261,23 @@ Bool_t AliDigitizationInput::ConnectInputTrees()
 }
 
 
+//_______________________________________________________________________
+void AliDigitizationInput::KeepSDigits(Int_t input, Bool_t keep) const
+{
+  //
+  // Keeps the sdigits of all detectors of input stream "input" in memory
+  // or releases them
+  //
+  AliRunLoader* rl = AliRunLoader::GetRunLoader(GetInputFolderName(input));
+  if (!rl) return;
+  TIter next(rl->GetArrayOfLoaders());
+  AliLoader *loader;
+  while ((loader = (AliLoader*)next()))
+   {
+     loader->GetSDigitsDataLoader()->SetKeepLoaded(keep);
+   }
+}
+
 //_______________________________________________________________________
 
 void AliDigitizationInput::SetOutputFile(TString fn)
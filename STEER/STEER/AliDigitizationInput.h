@@ -57,6 +57,8 @@ public:
   Int_t     GetMask(Int_t i) const {return fkMASK[i];}
   void      SetRegionOfInterest(Bool_t flag) {fRegionOfInterest = flag;};
   Bool_t    GetRegionOfInterest() const {return fRegionOfInterest;};
+  void      SetCacheBkgrdSDigits(Bool_t flag) {fCacheBkgrdSDigits = flag;}
+  Bool_t    GetCacheBkgrdSDigits() const {return fCacheBkgrdSDigits;}
   Int_t     GetNinputs() const {return fNinputs;}
   const TString& GetInputFolderName(Int_t i) const;
   const char* GetOutputFolderName();
@@ -101,6 +103,7 @@ private:
   AliDigitizationInput(const AliDigitizationInput& dig); // not implemented
   AliDigitizationInput& operator=(const AliDigitizationInput& dig); // not implemented
   void Copy(TObject& dig) const;
+  void KeepSDigits(Int_t input, Bool_t keep) const;
 
   Int_t             fkMASK[MAXSTREAMSTOMERGE];  //! masks for track ids from
                                               //  different source files
@@ -117,6 +120,8 @@ private:
   Int_t             fNinputs;             // nr of input streams - can be taken from the TClonesArray dimension
   Int_t             fNinputsGiven;        // nr of input streams given by user
   Bool_t            fRegionOfInterest;    // digitization in region of interest
+  Bool_t            fCacheBkgrdSDigits;   // keep background sdigits in memory while
+                                          // they are used for several signal events
   TClonesArray *    fInputStreams;        // input signal streams
 
 //  AliStream*        fOutputStream;
@@ -129,7 +134,7 @@ private:
                                           // with type 2 of comb.)  
   static const TString fgkDefOutFolderName;//default name for output foler 
   static const TString fgkBaseInFolderName;//default name for input foler
-  ClassDef(AliDigitizationInput,2)
+  ClassDef(AliDigitizationInput,3)
 };
 
 #endif // ALIRUNDIGITIZER_H
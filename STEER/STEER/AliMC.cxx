@@ -29,6 +29,7 @@
 #include <TFile.h>
 #include <TGeoGlobalMagField.h>
 #include <TGeoManager.h>
+#include <TGeoMedium.h>
 #include <TParticle.h>
 #include <TROOT.h>
 #include <TStopwatch.h>
@@ -69,6 +70,8 @@ AliMC::AliMC() :
   fSaveRndmEventStatus(kFALSE),
   fReadRndmStatus(kFALSE),
   fUseMonitoring(kFALSE),
+  fMonitorSampling(0),
+  fMonitorFileName("timing.root"),
   fRndmFileName("random.root"),
   fEventEnergy(0),
   fSummEnergy(0),
@@ -81,6 +84,7 @@ AliMC::AliMC() :
   fImedia(0),
   fTransParName("\0"),
   fMonitor(0),
+  fStepState(),
   fHitLists(0),
   fTmpTreeTR(0),
   fTmpFileTR(0),
@@ -101,6 +105,8 @@ AliMC::AliMC(const char *name, const char *title) :
   fSaveRndmEventStatus(kFALSE),
   fReadRndmStatus(kFALSE),
   fUseMonitoring(kFALSE),
+  fMonitorSampling(0),
+  fMonitorFileName("timing.root"),
   fRndmFileName("random.root"),
   fEventEnergy(0),
   fSummEnergy(0),
@@ -113,6 +119,7 @@ AliMC::AliMC(const char *name, const char *title) :
   fImedia(new TArrayI(1000)),
   fTransParName("\0"),
   fMonitor(0),
+  fStepState(),
   fHitLists(new TList()),
   fTmpTreeTR(0),
   fTmpFileTR(0),
@@ -976,8 +983,9 @@ void AliMC::FinishRun()
 
   // Monitoring information
   if (fMonitor) {
-    fMonitor->Print();
-    fMonitor->Export("timing.root");
+    if (fMonitor->GetSampling() > 0) fMonitor->PrintRanked();
+    else fMonitor->Print();
+    fMonitor->Export(fMonitorFileName);
   }
 
   //Output energy summary tables
@@ -985,6 +993,33 @@ void AliMC::FinishRun()
   ToAliDebug(1, EnergySummary());
 }
 
+//_______________________________________________________________________
+void AliMC::CreateTransportMonitor()
+{
+  //
+  // Create the transport monitor. The tracking media are labelled with
+  // the detector name and medium number used in the transport parameter
+  // file, see ReadTransPar
+  //
+  fMonitor = new AliTransportMonitor(fMC->NofVolumes()+1);
+  fMonitor->SetSampling(fMonitorSampling);
+  if (fMonitorSampling > 0) {
+    TIter next(gAlice->Modules());
+    AliModule *mod;
+    while ((mod = (AliModule*)next())) {
+      TArrayI *idtmed = mod->GetIdtmed();
+      if (!idtmed) continue;
+      for (Int_t numed = 0; numed < idtmed->GetSize(); numed++) {
+        Int_t ktmed = idtmed->At(numed);
+        if (ktmed <= 0) continue;
+        TGeoMedium *med = gGeoManager ? gGeoManager->GetMedium(ktmed) : 0;
+        fMonitor->SetMediumLabel(ktmed, Form("%s %d %s", mod->GetName(), numed, med ? med->GetName() : ""));
+      }
+    }
+  }
+  fMonitor->Start();
+}
+
 //_______________________________________________________________________
 void AliMC::BeginPrimary()
 {
@@ -1020,7 +1055,8 @@ void AliMC::Stepping()
   //
   //verbose.Stepping();
 
-  Int_t id = DetFromMate(fMC->CurrentMedium());
+  Int_t medium = fMC->CurrentMedium();
+  Int_t id = DetFromMate(medium);
   if (id < 0) return;
 
 
@@ -1035,11 +1071,21 @@ void AliMC::Stepping()
 
   // --- If monitoring timing was requested, monitor the step
   if (fUseMonitoring) {
-    if (!fMonitor) {
-      fMonitor = new AliTransportMonitor(fMC->NofVolumes()+1);
-      fMonitor->Start();
-    }  
-    if (fMC->IsNewTrack() || fMC->TrackTime() == 0. || fMC->TrackStep()<1.1E-10) {
+    if (!fMonitor) CreateTransportMonitor();
+    if (fMonitorSampling > 0) {
+    // Sampling mode: the other steps only cost the counter
+      if (fMonitor->SampleStep()) {
+        if (!fMC->IsNewTrack() && fMC->TrackStep()>=1.1E-10) {
+          Int_t copy;
+          Double_t px, py, pz, etot;
+          fMC->TrackMomentum(px, py, pz, etot);
+          fMonitor->SampleInfo(fMC->CurrentVolID(copy), medium, fMC->TrackPid(), etot);
+        } else {
+          // not a real step, the sample is taken at the next one
+          fMonitor->SkipSample();
+        }
+      }
+    } else if (fMC->IsNewTrack() || fMC->TrackTime() == 0. || fMC->TrackStep()<1.1E-10) {
       fMonitor->DummyStep();
     } else {
     // Normal stepping
@@ -1058,8 +1104,12 @@ void AliMC::Stepping()
     AliSimulation::Instance()->Lego()->StepManager();
   else {
     Int_t copy;
+    Int_t volId = fMC->CurrentVolID(copy);
+    Double_t edep = fMC->Edep();
+    fStepState.SetVolume(volId, copy, medium);
+    fStepState.SetEdep(edep);
     //Update energy deposition tables
-    AddEnergyDeposit(fMC->CurrentVolID(copy),fMC->Edep());
+    AddEnergyDeposit(volId, edep);
     //
     // write tracke reference for track which is dissapearing - MI
 
@@ -1073,7 +1123,13 @@ void AliMC::Stepping()
     //Call the appropriate stepping routine;
     AliModule *det = static_cast<AliModule*>(gAlice->Modules()->UncheckedAt(id));
     if(det && det->StepManagerIsEnabled()) {
-      det->StepManager();
+      if (det->UsesStepState()) {
+        // Kinematics only for the modules which use them
+        fStepState.Fill(fMC, GetCurrentTrackNumber());
+        det->StepManagerWithState(fStepState);
+      } else {
+        det->StepManager();
+      }
     }
   }
 }
@@ -1171,6 +1227,10 @@ void AliMC::BeginEvent()
   runloader->SetEventNumber(gAlice->GetEventNrInRun());// sets new files, cleans the previous event stuff, if necessary, etc.,
   AliDebug(1, Form("EventNr is %d",gAlice->GetEventNrInRun()));
 
+  // Reproducible per-event seed in event-parallel simulation
+  UInt_t seed = AliSimulation::Instance()->GetEventSeed(gAlice->GetEventNrInRun());
+  if (seed) gRandom->SetSeed(seed);
+
   fEventEnergy.Reset();
     // Clean detector information
 
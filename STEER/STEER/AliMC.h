@@ -18,6 +18,8 @@
 #include <TMCProcess.h>
 #include <TVirtualMCApplication.h>
 
+#include "AliStepState.h"
+
 class TParticle;
 class TFile;
 class TTree;
@@ -114,6 +116,9 @@ public:
    Bool_t         IsGeometryFromCDB() const;
 // Monitor transport   
    void           SetUseMonitoring(Bool_t flag=kTRUE)      { fUseMonitoring = flag; }
+   void           SetMonitorSampling(Int_t nsteps)         { fMonitorSampling = nsteps; }
+   void           SetMonitorFileName(const char *fname)    { fMonitorFileName = fname; }
+   const char    *GetMonitorFileName() const               { return fMonitorFileName.Data(); }
    AliTransportMonitor *GetTransportMonitor() const        { return fMonitor; }
 // Random number generator status
    void           SetSaveRndmStatus(Bool_t value)          { fSaveRndmStatus = value; }  
@@ -127,6 +132,7 @@ public:
    void MakeTmpTrackRefsTree();
    void ReorderAndExpandTreeTR();
    void CacheVMCInstance(); // Cache pointer to VMC object (to avoid _tls_ penalties)
+   void CreateTransportMonitor();
 
  private:
    void RemapHits();
@@ -136,6 +142,8 @@ public:
    Bool_t         fSaveRndmEventStatus; //! Options to save random engine status for each event
    Bool_t         fReadRndmStatus;    //! Options to read random engine status
    Bool_t         fUseMonitoring;     //! Activate monitoring
+   Int_t          fMonitorSampling;   //! Monitor one step in fMonitorSampling (0: all steps)
+   TString        fMonitorFileName;   //! File the monitoring is exported to at the end of the run
    TString        fRndmFileName;      //! The file name of random engine status to be read in
    TArrayF        fEventEnergy;       //! Energy deposit for current event
    TArrayF        fSummEnergy;        //! Energy per event in each volume
@@ -148,13 +156,14 @@ public:
    TArrayI       *fImedia;            //! Array of correspondence between media and detectors
    TString        fTransParName;      //  Name of the transport parameters file
    AliTransportMonitor *fMonitor;     //! Transport monitoring tool
+   AliStepState   fStepState;         //! State of the current step
    TList         *fHitLists;          //! Lists of hits to be remapped by PurifyKine
    //Temporary Track Reference tree related
    TTree         *fTmpTreeTR;            //! Temporary track reference tree
    TFile         *fTmpFileTR;            //! Temporary track reference file
    TClonesArray   fTrackReferences;      //! List of track references - for one primary track only
    TClonesArray   fTmpTrackReferences;   //! Temporary list of track references - for one primary track only
-   ClassDef(AliMC, 4)
+   ClassDef(AliMC, 5)
 };
 
  
@@ -26,6 +26,7 @@ public:
   AliMergeCombi(Int_t dim, Int_t sperb);
   virtual ~AliMergeCombi();
   Bool_t Combination(Int_t evNumber[], Int_t delta[]);
+  Int_t  GetSperb() const {return fSperb;}
   
 private:  
   Int_t fDim;               //! dimension of arrays evNumber and delta
@@ -23,6 +23,7 @@ class TFile;
 class TTree;
 class TVirtualMC;
 class AliLoader;
+class AliStepState;
 class AliTrackReference;
 class AliDigitizer;
 class AliDigitizationInput;
@@ -129,6 +130,10 @@ public:
   virtual void        SetTimeGate(Float_t) {}
   virtual Float_t     GetTimeGate() const {return 1.e10;}
   virtual void        StepManager() {}
+  // Modules returning kTRUE get the step state filled by AliMC and are
+  // called through StepManagerWithState instead of StepManager
+  virtual Bool_t      UsesStepState() const {return kFALSE;}
+  virtual void        StepManagerWithState(const AliStepState &) {StepManager();}
   virtual void        DisableStepManager() {fEnable = kFALSE;}
   virtual Bool_t      StepManagerIsEnabled() const {return fEnable;}
   virtual void        SetBufferSize(Int_t) {}  
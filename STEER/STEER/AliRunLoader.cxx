@@ -63,6 +63,7 @@
 #include <TFolder.h>
 #include <TObjArray.h>
 #include <TString.h>
+#include <TSystem.h>
 
 ClassImp(AliRunLoader)
 
@@ -1815,6 +1816,31 @@ void AliRunLoader::CdGAFile()
  
 /**************************************************************************/
 
+Int_t AliRunLoader::SwitchGAFile(const char* dirname)
+{
+//continues the session with a new galice file in directory dirname,
+//the files of the data loaders are moved to the same directory.
+//Used by the forked workers of the event-parallel simulation: the current
+//file shares its descriptor with the parent process, therefore it is
+//released without being written or closed
+  TString dir(dirname);
+  if (!dir.EndsWith("/")) dir += "/";
+  TString filename = dir + gSystem->BaseName(GetFileName());
+  TFile* file = TFile::Open(filename,"RECREATE");
+  if (!file || !file->IsOpen())
+   {
+     AliError(Form("Can not open file %s.",filename.Data()));
+     delete file;
+     return 1;
+   }
+  if (fGAFile) gROOT->GetListOfFiles()->Remove(fGAFile);
+  fGAFile = file;
+  SetDirName(dir);
+  return 0;
+}
+
+/**************************************************************************/
+
 void AliRunLoader::GetListOfDetectors(const char * namelist,TObjArray& pointerarray) const
  {
 //this method looks for all Loaders corresponding 
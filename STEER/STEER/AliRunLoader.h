@@ -146,6 +146,7 @@ class AliRunLoader: public TNamed
 
     TFolder*    GetEventFolder() const {return fEventFolder;}
     void        CdGAFile();
+    Int_t       SwitchGAFile(const char* dirname);
 
     void        MakeTrackRefsContainer();
     void        SetDirName(TString& dirname);
@@ -72,6 +72,14 @@
 // than two event streams. It is assumed that the sdigits were already       //
 // produced for the background events.                                       //
 //                                                                           //
+// A background event used for several signal events keeps its sdigits in   //
+// memory until the next background event is read. This can be switched off //
+// by sim.SetCacheBkgrdSDigits(kFALSE). With                                 //
+//                                                                           //
+//   sim.SetNumberOfDigitizationWorkers(4);                                  //
+//                                                                           //
+// the detectors are digitized by 4 forked processes in parallel.            //
+//                                                                           //
 // The output of raw data can be switched on by calling                      //
 //                                                                           //
 //   sim.SetWriteRawData("MUON");   // write raw data for MUON               //
@@ -163,10 +171,17 @@
 #include "AliStack.h"
 #include "AliSimulation.h"
 #include "AliSysInfo.h"
+#include "AliTransportMonitor.h"
 #include "AliVertexGenFile.h"
 #include "AliLumiTools.h"
 #include <TGraph.h>
+#include <TKey.h>
+#include <TTree.h>
+#include <TArrayI.h>
 #include <fstream>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
 
 using std::ofstream;
 ClassImp(AliSimulation)
@@ -199,6 +214,7 @@ AliSimulation::AliSimulation(const char* configFileName,
   fWriteSelRawData(kFALSE),
   fStopOnError(kFALSE),
   fUseMonitoring(kFALSE),
+  fMonitorSampling(0),
   fNEvents(1),
   fConfigFileName(configFileName),
   fGAliceFileName("galice.root"),
@@ -207,11 +223,16 @@ AliSimulation::AliSimulation(const char* configFileName,
   fAlignObjArray(NULL),
   fUseBkgrdVertex(kTRUE),
   fRegionOfInterest(kFALSE),
+  fCacheBkgrdSDigits(kTRUE),
   fCDBUri(""),
   fQARefUri(""), 
   fSpecCDBUri(),
   fRun(-1),
   fSeed(0),
+  fNWorkers(0),
+  fEventOffset(0),
+  fNDigWorkers(0),
+  fDigWorker(kFALSE),
   fInitCDBCalled(kFALSE),
   fInitRunNumberCalled(kFALSE),
   fSetRunNumberFromDataCalled(kFALSE),
@@ -452,6 +473,44 @@ void AliSimulation::SetSeed(Int_t seed)
 	fSeed = seed;
 }
 
+//_____________________________________________________________________________
+UInt_t AliSimulation::GetEventSeed(Int_t eventNr) const
+{
+// Seed for event eventNr of this process, derived from the run seed and the
+// event number in the run, such that the events do not depend on how they
+// are distributed among the workers. Returns 0 (keep the random generator
+// going) in sequential mode
+
+  if (fNWorkers <= 0) return 0;
+  return HashSeed(UInt_t(fSeed) ^ (UInt_t(fEventOffset + eventNr + 1) * 0x9e3779b9u));
+}
+
+//_____________________________________________________________________________
+UInt_t AliSimulation::GetDigitizationSeed(Int_t eventNr, Int_t detIndex) const
+{
+// Seed for the digitizer of detector detIndex (index in the list of
+// detectors of gAlice) in event eventNr, such that the digits do not
+// depend on how the detectors are distributed among the digitization
+// workers. Returns 0 (keep the random generator going) in sequential mode
+
+  if (fNDigWorkers <= 0) return 0;
+  return HashSeed(UInt_t(fSeed) ^ (UInt_t(eventNr + 1) * 0x9e3779b9u)
+                  ^ (UInt_t(detIndex + 1) * 0x7f4a7c15u));
+}
+
+//_____________________________________________________________________________
+UInt_t AliSimulation::HashSeed(UInt_t seed)
+{
+// Scramble the bits of seed, never returns 0
+
+  seed ^= seed >> 16;
+  seed *= 0x85ebca6bu;
+  seed ^= seed >> 13;
+  seed *= 0xc2b2ae35u;
+  seed ^= seed >> 16;
+  return seed ? seed : 1;
+}
+
 //_____________________________________________________________________________
 Bool_t AliSimulation::SetRunNumberFromData()
 {
@@ -1086,6 +1145,7 @@ Bool_t AliSimulation::RunSimulation(Int_t nEvents)
   
   // Setup monitoring if requested
   gAlice->GetMCApp()->SetUseMonitoring(fUseMonitoring);
+  gAlice->GetMCApp()->SetMonitorSampling(fMonitorSampling);
 
   AliInfo(Form("initializing gAlice with config file %s",
           fConfigFileName.Data()));
@@ -1209,14 +1269,8 @@ Bool_t AliSimulation::RunSimulation(Int_t nEvents)
 
    //Must be here because some MCs (G4) adds detectors here and not in Config.C
    gAlice->InitLoaders();
-   AliRunLoader::Instance()->MakeTree("E");
-   AliRunLoader::Instance()->LoadKinematics("RECREATE");
-   AliRunLoader::Instance()->LoadTrackRefs("RECREATE");
-   AliRunLoader::Instance()->LoadHits("all","RECREATE");
-   //
-   // Save stuff at the beginning of the file to avoid file corruption
-   AliRunLoader::Instance()->CdGAFile();
-   gAlice->Write();
+   // in event-parallel mode the output is opened by the workers
+   if (fNWorkers <= 0) OpenSimulationOutput(AliRunLoader::Instance());
    gAlice->SetEventNrInRun(-1); //important - we start Begin event from increasing current number in run
    AliSysInfo::AddStamp("RunSimulation_InitLoaders");
   //___________________________________________________________________________________________
@@ -1335,10 +1389,14 @@ Bool_t AliSimulation::RunSimulation(Int_t nEvents)
 
   // Create the Root Tree with one branch per detector
   //Hits moved to begin event -> now we are crating separate tree for each event
-  TVirtualMC::GetMC()->ProcessRun(nEvents);
+  if (fNWorkers > 0) {
+    if (!RunSimulationWorkers(runLoader, nEvents)) return kFALSE;
+  } else {
+    TVirtualMC::GetMC()->ProcessRun(nEvents);
 
-  // End of this run, close files
-  if(nEvents>0) FinishRun();
+    // End of this run, close files
+    if(nEvents>0) FinishRun();
+  }
 
   AliSysInfo::AddStamp("Stop_ProcessRun");
   delete runLoader;
@@ -1487,17 +1545,32 @@ Bool_t AliSimulation::RunDigitization(const char* detectors,
   delete gAlice;
   gAlice = NULL;
 
+  if (fNDigWorkers > 0 && !fDigWorker) return RunDigitizationWorkers(detectors, excludeDetectors);
+  return DigitizeEvents(detectors, excludeDetectors);
+}
+
+//_____________________________________________________________________________
+Bool_t AliSimulation::DigitizeEvents(const char* detectors, 
+				     const char* excludeDetectors)
+{
+// run the digitizers of the selected detectors over the events, the CDB
+// has to be initialized. Without any selected detector only the event
+// headers and the digitization input are written to the galice file
+
   Int_t nStreams = 1;
   if (fBkgrdFileNames) nStreams = fBkgrdFileNames->GetEntriesFast() + 1;
   Int_t signalPerBkgrd = GetNSignalPerBkgrd();
   AliDigitizationInput digInp(nStreams, signalPerBkgrd);
   // digInp.SetEmbeddingFlag(fEmbeddingFlag);
   digInp.SetRegionOfInterest(fRegionOfInterest);
+  digInp.SetCacheBkgrdSDigits(fCacheBkgrdSDigits);
   digInp.SetInputStream(0, fGAliceFileName.Data());
   for (Int_t iStream = 1; iStream < nStreams; iStream++) {
     const char* fileName = ((TObjString*)(fBkgrdFileNames->At(iStream-1)))->GetName();
     digInp.SetInputStream(iStream, fileName);
   }
+  // the galice file is shared by the digitization workers, only read it
+  if (fDigWorker) digInp.GetInputStream(0)->ChangeMode("READ");
   TObjArray detArr;
   detArr.SetOwner(kTRUE);
   TString detStr = detectors;
@@ -1508,6 +1581,7 @@ Bool_t AliSimulation::RunDigitization(const char* detectors,
   }
   AliRunLoader* runLoader = AliRunLoader::GetRunLoader(digInp.GetInputStream(0)->GetFolderName());
   TObjArray* detArray = runLoader->GetAliRun()->Detectors();
+  TArrayI detIndex(detArray->GetEntriesFast());
   //
   if (fUseDetectorsFromGRP) {
     AliInfo("Will run only for detectors seen in the GRP");
@@ -1524,6 +1598,7 @@ Bool_t AliSimulation::RunDigitization(const char* detectors,
       if (fStopOnError) return kFALSE;
       else continue;
     }
+    detIndex[detArr.GetEntriesFast()] = iDet;
     detArr.AddLast(digitizer);    
     AliInfo(Form("Created digitizer from SDigits -> Digits for %s", det->GetName()));    
 
@@ -1543,16 +1618,108 @@ Bool_t AliSimulation::RunDigitization(const char* detectors,
     if (outRl) outRl->SetEventNumber(eventsCreated-1);
     static_cast<AliStream*>(digInp.GetInputStream(0))->ImportgAlice(); // use gAlice of the first input stream
     for (int id=0;id<ndigs;id++) {
+      UInt_t seed = GetDigitizationSeed(eventsCreated-1, detIndex[id]);
+      if (seed) gRandom->SetSeed(seed);
       ((AliDigitizer*)detArr[id])->Digitize("");
       AliSysInfo::AddStamp(Form("Digit_%s_%d",detArr[id]->GetName(),eventsCreated), 0,2, eventsCreated);       
     }
     digInp.FinishEvent();
   };
-  digInp.FinishGlobal();
+  // the workers leave the galice file to the parent process, which writes
+  // it once all of them are done (see RunDigitizationWorkers)
+  if (!fDigWorker) digInp.FinishGlobal();
   // 
   return kTRUE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliSimulation::RunDigitizationWorkers(const char* detectors, 
+					     const char* excludeDetectors)
+{
+  // Detector-parallel digitization: the selected detectors are distributed
+  // over fNDigWorkers forked processes, each of them runs the digitizers of
+  // its detectors over all events. Every detector writes its digits to its
+  // own files and the workers only read the galice file, so there is nothing
+  // to merge. Once the workers are done the galice file is written by this
+  // process as in the sequential digitization. gRandom is reseeded per event
+  // and detector (see GetDigitizationSeed), the digits do not depend on the
+  // number of workers.
+
+  AliRunLoader* runLoader = LoadRun("READ");
+  if (!runLoader) return kFALSE;
+  TObjArray* detArray = runLoader->GetAliRun()->Detectors();
+  if (fUseDetectorsFromGRP) DeactivateDetectorsAbsentInGRP(detArray);
+
+  TString detStr = detectors;
+  TString detExcl = excludeDetectors;
+  TObjArray detNames;
+  detNames.SetOwner(kTRUE);
+  for (Int_t iDet = 0; iDet < detArray->GetEntriesFast(); iDet++) {
+    AliModule* det = (AliModule*) detArray->At(iDet);
+    if (!det || !det->IsActive()) continue;
+    if (!IsSelected(det->GetName(), detStr) || IsSelected(det->GetName(), detExcl)) continue;
+    detNames.AddLast(new TObjString(det->GetName()));
+  }
+  delete runLoader;
+  gAlice = NULL;
+
+  if ((detStr.CompareTo("ALL") != 0) && !detStr.IsNull()) {
+    AliError(Form("the following detectors were not found: %s", detStr.Data()));
+    if (fStopOnError) return kFALSE;
+  }
+
+  if (fSeed == 0) {
+    fSeed = 1 + gRandom->Integer(kMaxInt - 1);
+    AliInfo(Form("No seed set, using %d for the digitization seeds", fSeed));
+  }
+
+  // round robin, the detectors come in the order of gAlice
+  const Int_t nWorkers = TMath::Min(fNDigWorkers, detNames.GetEntriesFast());
+  if (nWorkers <= 1) return DigitizeEvents(detectors, excludeDetectors);
+  std::vector<TString> workerDets(nWorkers);
+  for (Int_t i = 0; i < detNames.GetEntriesFast(); i++) {
+    TString& list = workerDets[i % nWorkers];
+    if (!list.IsNull()) list += " ";
+    list += ((TObjString*)detNames.At(i))->GetString();
+  }
+
+  std::vector<pid_t> pids;
+  Bool_t status = kTRUE;
+  fflush(stdout);
+  fflush(stderr);
+  for (Int_t iWorker = 0; iWorker < nWorkers; iWorker++) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      gSystem->RedirectOutput(Form("digworker%d.log", iWorker), "w");
+      fDigWorker = kTRUE;
+      Bool_t ok = DigitizeEvents(workerDets[iWorker].Data(), excludeDetectors);
+      fflush(stdout);
+      fflush(stderr);
+      _exit(ok ? 0 : 1);
+    }
+    if (pid < 0) {
+      AliError(Form("Could not fork digitization worker %d", iWorker));
+      status = kFALSE;
+      break;
+    }
+    AliInfo(Form("Digitization worker %d (pid %d): %s", iWorker, (Int_t)pid,
+                 workerDets[iWorker].Data()));
+    pids.push_back(pid);
+  }
+
+  for (size_t i = 0; i < pids.size(); i++) {
+    int wstatus = 0;
+    if (waitpid(pids[i], &wstatus, 0) < 0 || !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+      AliError(Form("Digitization worker %d failed, see digworker%d.log", (Int_t)i, (Int_t)i));
+      status = kFALSE;
+    }
+  }
+  // event headers and digitization input, without digitizers
+  if (status) status = DigitizeEvents("", "");
+  AliSysInfo::AddStamp("RunDigitization_Workers");
+  return status;
+}
+
 //_____________________________________________________________________________
 Bool_t AliSimulation::RunHitsDigitization(const char* detectors)
 {
@@ -2296,6 +2463,323 @@ void AliSimulation::FinishRun()
   AliRunLoader::Instance()->Synchronize();
 }
 
+//_____________________________________________________________________________
+void AliSimulation::OpenSimulationOutput(AliRunLoader* runLoader) const
+{
+  // Create the header tree and the kinematics, track references and hits
+  // files of the simulation
+  runLoader->MakeTree("E");
+  runLoader->LoadKinematics("RECREATE");
+  runLoader->LoadTrackRefs("RECREATE");
+  runLoader->LoadHits("all","RECREATE");
+  //
+  // Save stuff at the beginning of the file to avoid file corruption
+  runLoader->CdGAFile();
+  gAlice->Write();
+}
+
+//_____________________________________________________________________________
+Bool_t AliSimulation::RunSimulationWorkers(AliRunLoader* runLoader, Int_t nEvents)
+{
+  // Event-parallel simulation: the geometry, physics tables and OCDB objects
+  // are initialised once in this process, then fNWorkers processes are forked
+  // which share this state copy-on-write. Each worker transports a contiguous
+  // slice of the events into the directory simworker<i>/ with a per-event
+  // seed (see GetEventSeed), afterwards the outputs are merged into the
+  // files of this process.
+
+  Bool_t supported = kTRUE;
+  if (fEventsPerFile.GetEntriesFast() > 0) {
+    AliWarning("Event-parallel simulation does not support several events files per detector");
+    supported = kFALSE;
+  }
+  if (fBkgrdFileNames && fBkgrdFileNames->GetEntriesFast() > 0) {
+    AliWarning("Event-parallel simulation does not support merging with background files");
+    supported = kFALSE;
+  }
+  if (IsLegoRun()) supported = kFALSE;
+  if (!supported || nEvents <= 0) {
+    AliWarning("Running the simulation sequentially");
+    OpenSimulationOutput(runLoader);
+    TVirtualMC::GetMC()->ProcessRun(nEvents);
+    if (nEvents > 0) FinishRun();
+    return kTRUE;
+  }
+
+  const Int_t nWorkers = TMath::Min(fNWorkers, nEvents);
+  if (fSeed == 0) {
+    fSeed = 1 + gRandom->Integer(kMaxInt - 1);
+    AliInfo(Form("No seed set, using %d for the per-event seeds", fSeed));
+  }
+
+  TObjArray dirNames(nWorkers);
+  dirNames.SetOwner();
+  TArrayI nEventsWorker(nWorkers);
+  std::vector<pid_t> pids;
+  Bool_t status = kTRUE;
+
+  fflush(stdout);
+  fflush(stderr);
+  for (Int_t iWorker = 0; iWorker < nWorkers; iWorker++) {
+    Int_t first = Int_t(Long64_t(iWorker) * nEvents / nWorkers);
+    nEventsWorker[iWorker] = Int_t(Long64_t(iWorker + 1) * nEvents / nWorkers) - first;
+    TString dirName = Form("simworker%d/", iWorker);
+    dirNames.AddAt(new TObjString(dirName), iWorker);
+    gSystem->mkdir(dirName, kTRUE);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+      // never return into the caller, the worker only leaves through _exit
+      _exit(RunSimulationWorker(runLoader, dirName, first, nEventsWorker[iWorker]));
+    }
+    if (pid < 0) {
+      AliError(Form("Could not fork worker %d", iWorker));
+      status = kFALSE;
+      break;
+    }
+    AliInfo(Form("Worker %d (pid %d): events %d to %d in %s", iWorker, (Int_t)pid,
+                 first, first + nEventsWorker[iWorker] - 1, dirName.Data()));
+    pids.push_back(pid);
+  }
+
+  for (size_t i = 0; i < pids.size(); i++) {
+    int wstatus = 0;
+    if (waitpid(pids[i], &wstatus, 0) < 0 || !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+      AliError(Form("Worker %d failed, see %ssim.log", (Int_t)i,
+                    ((TObjString*)dirNames.At(i))->GetName()));
+      status = kFALSE;
+    }
+  }
+  if (!status) return kFALSE;
+  AliSysInfo::AddStamp("RunSimulation_Workers");
+
+  if (!MergeWorkerOutput(runLoader, dirNames, nEventsWorker)) return kFALSE;
+
+  // transport monitoring of the workers
+  if (fUseMonitoring) {
+    const char* listName = "simworker_timing.txt";
+    ofstream list(listName);
+    for (Int_t iWorker = 0; iWorker < nWorkers; iWorker++)
+      list << ((TObjString*)dirNames.At(iWorker))->GetString() << "timing.root" << std::endl;
+    list.close();
+    delete AliTransportMonitor::MergeFiles(listName, gAlice->GetMCApp()->GetMonitorFileName());
+  }
+
+  // the generator and the detectors were only used by the workers, which
+  // called their FinishRun already: their run level objects were merged
+  // above, only the run objects of this process are written here
+  runLoader->WriteHeader("OVERWRITE");
+  runLoader->CdGAFile();
+  gAlice->Write(0,TObject::kOverwrite);
+  runLoader->Write(0,TObject::kOverwrite);
+  runLoader->Synchronize();
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+Int_t AliSimulation::RunSimulationWorker(AliRunLoader* runLoader, const char* dirName,
+                                         Int_t firstEvent, Int_t nEvents)
+{
+  // Body of a forked worker, returns the exit status of the process
+
+  gSystem->RedirectOutput(Form("%ssim.log", dirName), "w");
+  fEventOffset = firstEvent;
+
+  // the open galice file belongs to the parent process
+  if (runLoader->SwitchGAFile(dirName)) return 1;
+  SetGAliceFile(runLoader->GetFileName());
+  gAlice->GetMCApp()->SetMonitorFileName(Form("%stiming.root", dirName));
+
+  if (fOrderedTimeStamps.size()) {
+    size_t skip = std::min(size_t(firstEvent), fOrderedTimeStamps.size());
+    fOrderedTimeStamps.erase(fOrderedTimeStamps.begin(), fOrderedTimeStamps.begin() + skip);
+  }
+
+  OpenSimulationOutput(runLoader);
+  TVirtualMC::GetMC()->ProcessRun(nEvents);
+  FinishRun();
+
+  // close all output files before leaving, _exit skips the ROOT cleanup
+  delete runLoader;
+  fflush(stdout);
+  fflush(stderr);
+  return 0;
+}
+
+//_____________________________________________________________________________
+Bool_t AliSimulation::MergeWorkerOutput(AliRunLoader* runLoader, const TObjArray& dirNames,
+                                        const TArrayI& nEvents) const
+{
+  // Merge the outputs of the workers: the event headers are appended to the
+  // header tree of this process, the Event<n> directories of all other files
+  // are copied with the event number shifted by the offset of the worker
+
+  runLoader->MakeTree("E");
+  runLoader->CdGAFile();
+  gAlice->Write();
+
+  AliHeader* header = runLoader->GetHeader();
+  AliStack* stack = header->Stack();
+  TTree* treeE = runLoader->TreeE();
+  const Int_t nWorkers = dirNames.GetEntriesFast();
+
+  // event headers
+  Int_t offset = 0;
+  for (Int_t iWorker = 0; iWorker < nWorkers; iWorker++) {
+    TString dirName = ((TObjString*)dirNames.At(iWorker))->GetString();
+    TFile* file = TFile::Open(dirName + gSystem->BaseName(runLoader->GetFileName()));
+    TTree* workerTreeE = file ? dynamic_cast<TTree*>(file->Get(AliRunLoader::GetHeaderContainerName())) : 0;
+    if (!workerTreeE) {
+      AliError(Form("No event headers from worker %d", iWorker));
+      delete file;
+      return kFALSE;
+    }
+    AliHeader* workerHeader = 0;
+    workerTreeE->SetBranchAddress(AliRunLoader::GetHeaderBranchName(), &workerHeader);
+    for (Int_t iev = 0; iev < workerTreeE->GetEntries(); iev++) {
+      workerTreeE->GetEntry(iev);
+      *header = *workerHeader;
+      header->SetEvent(offset + iev);
+      header->SetEventNrInRun(offset + iev);
+      treeE->Fill();
+    }
+    delete workerHeader;
+    delete file;
+    offset += nEvents[iWorker];
+  }
+  // the stacks read with the worker headers are only needed for writing
+  header->SetStack(stack);
+
+  // kinematics, track references and hits files, as found for the first worker
+  TString firstDir = ((TObjString*)dirNames.At(0))->GetString();
+  TString galiceName = gSystem->BaseName(runLoader->GetFileName());
+  void* dir = gSystem->OpenDirectory(firstDir);
+  const char* entry;
+  Bool_t status = kTRUE;
+  while ((entry = gSystem->GetDirEntry(dir))) {
+    TString fileName(entry);
+    if (!fileName.EndsWith(".root") || fileName == galiceName) continue;
+    AliDebug(1, Form("Merging %s", fileName.Data()));
+
+    TFile* out = TFile::Open(fileName, "RECREATE");
+    if (!out || !out->IsOpen()) {
+      AliError(Form("Cannot create %s", fileName.Data()));
+      delete out;
+      status = kFALSE;
+      continue;
+    }
+    offset = 0;
+    for (Int_t iWorker = 0; iWorker < nWorkers; iWorker++) {
+      TString dirName = ((TObjString*)dirNames.At(iWorker))->GetString();
+      TFile* in = TFile::Open(dirName + fileName);
+      if (!in || !in->IsOpen()) {
+        AliError(Form("Missing %s%s", dirName.Data(), fileName.Data()));
+        delete in;
+        status = kFALSE;
+        continue;
+      }
+      CopyWorkerKeys(in, out, offset, iWorker == 0, 0);
+      delete in;
+      offset += nEvents[iWorker];
+    }
+    out->Write();
+    delete out;
+  }
+  gSystem->FreeDirectory(dir);
+
+  // objects written into the galice files by the workers, e.g. in the
+  // FinishRun of the detectors; the header tree and the run objects of
+  // this process are written by the caller
+  runLoader->CdGAFile();
+  TDirectory* gaFile = gDirectory;
+  TObjArray skip;
+  skip.SetOwner();
+  skip.Add(new TObjString(AliRunLoader::GetHeaderContainerName()));
+  skip.Add(new TObjString(gAlice->GetName()));
+  skip.Add(new TObjString(runLoader->GetName()));
+  offset = 0;
+  for (Int_t iWorker = 0; iWorker < nWorkers; iWorker++) {
+    TString dirName = ((TObjString*)dirNames.At(iWorker))->GetString();
+    TFile* in = TFile::Open(dirName + galiceName);
+    if (!in || !in->IsOpen()) {
+      AliError(Form("Missing %s%s", dirName.Data(), galiceName.Data()));
+      delete in;
+      status = kFALSE;
+      continue;
+    }
+    CopyWorkerKeys(in, gaFile, offset, iWorker == 0, &skip);
+    delete in;
+    offset += nEvents[iWorker];
+  }
+
+  runLoader->CdGAFile();
+  return status;
+}
+
+//_____________________________________________________________________________
+void AliSimulation::CopyWorkerKeys(TDirectory* in, TDirectory* out, Int_t offset,
+                                   Bool_t runObjects, const TObjArray* skip)
+{
+  // Copy the Event<n> directories of a worker file into out, with the event
+  // number shifted by offset, and its run level objects if runObjects is set
+  // (they are taken from the first worker). The keys named in skip are left out.
+  TIter next(in->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)next())) {
+    if (key != in->GetKey(key->GetName())) continue; // older cycle
+    if (skip && skip->FindObject(key->GetName())) continue;
+    Int_t event = -1;
+    TString name(key->GetName());
+    if (name.BeginsWith("Event") && TString(name(5, name.Length())).IsDigit()) {
+      event = TString(name(5, name.Length())).Atoi();
+    }
+    if (event < 0) {
+      if (!runObjects) continue;
+      TClass* cl = TClass::GetClass(key->GetClassName());
+      if (cl && cl->InheritsFrom(TDirectory::Class())) {
+        CopyDirectory(in->GetDirectory(key->GetName()), out->mkdir(key->GetName()));
+      } else {
+        TObject* obj = key->ReadObj();
+        out->cd();
+        obj->Write(key->GetName(), TObject::kOverwrite);
+        delete obj;
+      }
+      continue;
+    }
+    TDirectory* target = out->mkdir(Form("Event%d", event + offset));
+    CopyDirectory(in->GetDirectory(key->GetName()), target);
+  }
+}
+
+//_____________________________________________________________________________
+void AliSimulation::CopyDirectory(TDirectory* source, TDirectory* target)
+{
+  // Copy all objects of source into target, trees are cloned without
+  // unstreaming the baskets
+  if (!source || !target) return;
+  TIter next(source->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)next())) {
+    if (key != source->GetKey(key->GetName())) continue; // older cycle
+    TClass* cl = TClass::GetClass(key->GetClassName());
+    if (!cl) continue;
+    if (cl->InheritsFrom(TDirectory::Class())) {
+      CopyDirectory(source->GetDirectory(key->GetName()), target->mkdir(key->GetName()));
+    } else if (cl->InheritsFrom(TTree::Class())) {
+      TTree* tree = (TTree*)source->Get(key->GetName());
+      target->cd();
+      TTree* copy = tree->CloneTree(-1, "fast");
+      copy->Write();
+      delete copy;
+    } else {
+      TObject* obj = key->ReadObj();
+      target->cd();
+      obj->Write(key->GetName());
+      delete obj;
+    }
+  }
+}
+
 //_____________________________________________________________________________
 Int_t AliSimulation::GetDetIndex(const char* detector)
 {
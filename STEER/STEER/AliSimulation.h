@@ -20,6 +20,8 @@
 #include <time.h>
 #include <algorithm>
 
+class TArrayI;
+class TDirectory;
 class AliCDBId;
 class AliCDBParam;
 class AliRunLoader;
@@ -56,6 +58,7 @@ public:
   void           SetUseBkgrdVertex(Bool_t useBkgrdVertex)
                    {fUseBkgrdVertex = useBkgrdVertex;};
   void           SetRegionOfInterest(Bool_t flag) {fRegionOfInterest = flag;};
+  void           SetCacheBkgrdSDigits(Bool_t flag) {fCacheBkgrdSDigits = flag;};
   void           SetMakeDigits(const char* detectors)
                    {fMakeDigits = detectors;};
   void           SetMakeDigitsFromHits(const char* detectors)
@@ -72,12 +75,19 @@ public:
   void           SetAlignObjArray(TObjArray *array)
                    {fAlignObjArray = array;
 		   fLoadAlignFromCDB = kFALSE;}
-  void           SetUseMonitoring(Bool_t flag=kTRUE) {fUseMonitoring = flag;}
+  void           SetUseMonitoring(Bool_t flag=kTRUE, Int_t sampling=0)
+                   {fUseMonitoring = flag; fMonitorSampling = sampling;}
 
   Bool_t         MisalignGeometry(AliRunLoader *runLoader = NULL);
 
   void           SetRunNumber(Int_t run);
   void           SetSeed(Int_t seed);
+  void           SetNumberOfWorkers(Int_t nWorkers) {fNWorkers = nWorkers;}
+  Int_t          GetNumberOfWorkers() const {return fNWorkers;}
+  UInt_t         GetEventSeed(Int_t eventNr) const;
+  void           SetNumberOfDigitizationWorkers(Int_t nWorkers) {fNDigWorkers = nWorkers;}
+  Int_t          GetNumberOfDigitizationWorkers() const {return fNDigWorkers;}
+  UInt_t         GetDigitizationSeed(Int_t eventNr, Int_t detIndex) const;
     
   void 		 ProcessEnvironmentVars();
 		   
@@ -163,6 +173,18 @@ private:
   AliRunLoader*  LoadRun(const char* mode = "UPDATE") const;
   Int_t          GetNSignalPerBkgrd(Int_t nEvents = 0) const;
   Bool_t         IsSelected(TString detName, TString& detectors) const;
+  void           OpenSimulationOutput(AliRunLoader* runLoader) const;
+  Bool_t         RunSimulationWorkers(AliRunLoader* runLoader, Int_t nEvents);
+  Int_t          RunSimulationWorker(AliRunLoader* runLoader, const char* dirName,
+				     Int_t firstEvent, Int_t nEvents);
+  Bool_t         MergeWorkerOutput(AliRunLoader* runLoader, const TObjArray& dirNames,
+				   const TArrayI& nEvents) const;
+  static void    CopyDirectory(TDirectory* source, TDirectory* target);
+  static void    CopyWorkerKeys(TDirectory* in, TDirectory* out, Int_t offset,
+                                Bool_t runObjects, const TObjArray* skip);
+  Bool_t         RunDigitizationWorkers(const char* detectors, const char* excludeDetectors);
+  Bool_t         DigitizeEvents(const char* detectors, const char* excludeDetectors);
+  static UInt_t  HashSeed(UInt_t seed);
 
   static AliSimulation *fgInstance;    // Static pointer to object
 
@@ -181,6 +203,7 @@ private:
   Bool_t         fWriteSelRawData;    // write detectors raw data in a separate file accoring to the trigger cluster
   Bool_t         fStopOnError;        // stop or continue on errors
   Bool_t         fUseMonitoring;      // monitor simulation timing per volume
+  Int_t          fMonitorSampling;    // monitor only one step in fMonitorSampling (0: all steps)
 
   Int_t          fNEvents;            // number of events
   TString        fConfigFileName;     // name of the config file
@@ -191,12 +214,17 @@ private:
   TObjArray*     fAlignObjArray;      // array with the alignment objects to be applied to the geometry
   Bool_t         fUseBkgrdVertex;     // use vertex from background in case of merging
   Bool_t         fRegionOfInterest;   // digitization in region of interest
+  Bool_t         fCacheBkgrdSDigits;  // keep background sdigits in memory while used for several signal events
 
   TString 	 fCDBUri;	                     //! Uri of the default CDB storage
   TString 	 fQARefUri;	                     //! Uri of the default QA reference storage
   TObjArray      fSpecCDBUri;                        //! Array with detector specific CDB storages
   Int_t 	   fRun; 		                     //! Run number, will be passed to CDB and gAlice!!
   Int_t 	   fSeed;                        //! Seed for random number generator 
+  Int_t          fNWorkers;                    // number of forked workers for event-parallel simulation, 0 = sequential
+  Int_t          fEventOffset;                 //! number of the first event of this worker in the run
+  Int_t          fNDigWorkers;                 // number of forked workers for detector-parallel digitization, 0 = sequential
+  Bool_t         fDigWorker;                   //! this process is a digitization worker
   Bool_t 	   fInitCDBCalled;               //! flag to check if CDB storages are already initialized
   Bool_t 	   fInitRunNumberCalled;         //! flag to check if run number is already initialized
   Bool_t 	   fSetRunNumberFromDataCalled;  //! flag to check if run number is already loaded from run loader
@@ -237,7 +265,7 @@ private:
   static const Char_t *fgkRunHLTAuto;         // flag for automatic HLT mode detection
   static const Char_t *fgkHLTDefConf;         // default configuration to run HLT
 
-  ClassDef(AliSimulation, 15)  // class for running generation, simulation and digitization
+  ClassDef(AliSimulation, 18)  // class for running generation, simulation and digitization
 };
 
 #endif
@@ -0,0 +1,79 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// State of the current transport step.                                      //
+//                                                                           //
+// AliMC::Stepping fills the volume, copy number, medium and energy deposit  //
+// of every step, which it needs anyway for the energy deposition tables.    //
+// For the modules which return kTRUE from AliModule::UsesStepState() the    //
+// kinematics and the track status are added with one pass over the VMC      //
+// before calling AliModule::StepManagerWithState, so that the module does   //
+// not need to query the VMC again.                                          //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include <TVirtualMC.h>
+
+#include "AliStepState.h"
+
+ClassImp(AliStepState)
+
+//_______________________________________________________________________
+AliStepState::AliStepState():
+  fVolId(0),
+  fCopy(0),
+  fMedium(0),
+  fPdg(0),
+  fTrack(-1),
+  fStatus(0),
+  fCharge(0),
+  fEdep(0),
+  fStep(0),
+  fTrackLength(0)
+{
+  //
+  // Default constructor
+  //
+  for (Int_t i=0; i<4; i++) fPosition[i] = fMomentum[i] = 0;
+}
+
+//_______________________________________________________________________
+void AliStepState::Fill(TVirtualMC *mc, Int_t track)
+{
+  //
+  // Fill the kinematics and the status of the current step
+  //
+  fTrack = track;
+  fPdg = mc->TrackPid();
+  fCharge = mc->TrackCharge();
+  fStep = mc->TrackStep();
+  fTrackLength = mc->TrackLength();
+  mc->TrackPosition(fPosition[0], fPosition[1], fPosition[2]);
+  fPosition[3] = mc->TrackTime();
+  mc->TrackMomentum(fMomentum[0], fMomentum[1], fMomentum[2], fMomentum[3]);
+  fStatus = 0;
+  if (mc->IsNewTrack())         fStatus |= kNewTrack;
+  if (mc->IsTrackEntering())    fStatus |= kEntering;
+  if (mc->IsTrackExiting())     fStatus |= kExiting;
+  if (mc->IsTrackInside())      fStatus |= kInside;
+  if (mc->IsTrackAlive())       fStatus |= kAlive;
+  if (mc->IsTrackStop())        fStatus |= kStop;
+  if (mc->IsTrackDisappeared()) fStatus |= kDisappeared;
+  if (mc->IsTrackOut())         fStatus |= kOut;
+}
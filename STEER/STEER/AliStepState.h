@@ -0,0 +1,79 @@
+#ifndef ALISTEPSTATE_H
+#define ALISTEPSTATE_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+//
+// State of the current transport step, filled once per step by
+// AliMC::Stepping and handed to AliModule::StepManagerWithState
+//
+
+#include <Rtypes.h>
+
+class TVirtualMC;
+
+class AliStepState {
+public:
+  enum {kNewTrack=BIT(0), kEntering=BIT(1), kExiting=BIT(2), kInside=BIT(3),
+        kAlive=BIT(4), kStop=BIT(5), kDisappeared=BIT(6), kOut=BIT(7)};
+
+  AliStepState();
+  virtual ~AliStepState() {}
+
+  // Filled for every step by AliMC
+  void     SetVolume(Int_t volId, Int_t copy, Int_t medium) {fVolId = volId; fCopy = copy; fMedium = medium;}
+  void     SetEdep(Double_t edep) {fEdep = edep;}
+  // Filled only for the modules which use the step state
+  void     Fill(TVirtualMC *mc, Int_t track);
+
+  Int_t    GetVolId()       const {return fVolId;}
+  Int_t    GetCopy()        const {return fCopy;}
+  Int_t    GetMedium()      const {return fMedium;}
+  Int_t    GetPdg()         const {return fPdg;}
+  Int_t    GetTrack()       const {return fTrack;}
+  Double_t GetCharge()      const {return fCharge;}
+  Double_t GetEdep()        const {return fEdep;}
+  Double_t GetStep()        const {return fStep;}
+  Double_t GetTrackLength() const {return fTrackLength;}
+  Double_t X()              const {return fPosition[0];}
+  Double_t Y()              const {return fPosition[1];}
+  Double_t Z()              const {return fPosition[2];}
+  Double_t T()              const {return fPosition[3];}
+  Double_t Px()             const {return fMomentum[0];}
+  Double_t Py()             const {return fMomentum[1];}
+  Double_t Pz()             const {return fMomentum[2];}
+  Double_t Etot()           const {return fMomentum[3];}
+  const Double_t *GetPosition() const {return fPosition;}
+  const Double_t *GetMomentum() const {return fMomentum;}
+  void     GetPosition(Float_t *xyz) const {for (Int_t i=0; i<3; i++) xyz[i] = fPosition[i];}
+  void     GetMomentum(Float_t *pxyz) const {for (Int_t i=0; i<3; i++) pxyz[i] = fMomentum[i];}
+
+  Bool_t   IsNewTrack()           const {return fStatus & kNewTrack;}
+  Bool_t   IsTrackEntering()      const {return fStatus & kEntering;}
+  Bool_t   IsTrackExiting()       const {return fStatus & kExiting;}
+  Bool_t   IsTrackInside()        const {return fStatus & kInside;}
+  Bool_t   IsTrackAlive()         const {return fStatus & kAlive;}
+  Bool_t   IsTrackStop()          const {return fStatus & kStop;}
+  Bool_t   IsTrackDisappeared()   const {return fStatus & kDisappeared;}
+  Bool_t   IsTrackOut()           const {return fStatus & kOut;}
+
+private:
+  Int_t    fVolId;          // current volume id
+  Int_t    fCopy;           // copy number of the current volume
+  Int_t    fMedium;         // tracking medium id
+  Int_t    fPdg;            // PDG code of the particle
+  Int_t    fTrack;          // current track number in the stack
+  UInt_t   fStatus;         // track status bits
+  Double_t fCharge;         // particle charge
+  Double_t fEdep;           // energy deposited in the step
+  Double_t fStep;           // step length
+  Double_t fTrackLength;    // track length
+  Double_t fPosition[4];    // position and time at the end of the step
+  Double_t fMomentum[4];    // momentum and total energy at the end of the step
+
+  ClassDef(AliStepState, 1) // State of the current transport step
+};
+
+#endif
@@ -17,6 +17,14 @@
 // particle for each geometry volume.
 //
 //  andrei.gheata@cern.ch 
+//
+// In sampling mode (SetSampling(n), n>0) only one step out of n is timed.
+// The cost of the sampled step, scaled by n, is booked per volume, tracking
+// medium, particle type and energy bin (two bins per decade). The cost table
+// of many jobs can be merged with MergeFiles() and the most expensive
+// combinations listed with PrintRanked(); the media are labelled as
+// "DET numed name", i.e. with the keys of the transport parameter file read
+// by AliMC::ReadTransPar.
 
 #include "AliTransportMonitor.h"
 
@@ -30,11 +38,19 @@
 #include "TGeoManager.h"
 #include "AliPDG.h"
 #include "TVirtualMC.h"
+#include "TObjString.h"
+#include "TSystem.h"
 #include <RVersion.h>
+#include <Riostream.h>
+
+using std::ifstream;
+using std::ofstream;
+using std::endl;
 
 ClassImp(AliTransportMonitor)
 ClassImp(AliTransportMonitor::AliTransportMonitorVol)
 ClassImp(AliTransportMonitor::AliTransportMonitorVol::AliPMonData)
+ClassImp(AliTransportMonitor::AliCostCell)
 
 typedef AliTransportMonitor::AliTransportMonitorVol::AliPMonData PMonData;
 
@@ -93,16 +109,7 @@ PMonData &AliTransportMonitor::AliTransportMonitorVol::GetPMonData(Int_t pdg)
   //
   // unknown heavy fragment ?
   //  TParticlePDG* pdgP = (TDatabasePDG::Instance())->GetParticle(pdg);
-  Int_t apdg = TMath::Abs(pdg);
-  if ((apdg > 10000) 
-      && (apdg != 1000010020)
-      && (apdg != 1000010030)
-      && (apdg != 1000020030)
-      && (apdg != 1000020040)
-      && (apdg != 50000050)
-      && (apdg != 50000051)
-      ) 
-    pdg = 1111111111; 
+  pdg = AliTransportMonitor::NormalizedPDG(pdg);
 
   PMonData *data;
   if (fNtypes) {
@@ -162,7 +169,13 @@ AliTransportMonitor::AliTransportMonitor()
                     :TObject(),
                      fTotalTime(0),
                      fTimer(),
-                     fVolumeMon(0)
+                     fVolumeMon(0),
+                     fSampling(0),
+                     fStepCounter(0),
+                     fNPendingSamples(0),
+                     fCosts(),
+                     fMedia(0),
+                     fCostIndex()
 {
 // Default constructor
 }
@@ -172,7 +185,13 @@ AliTransportMonitor::AliTransportMonitor(Int_t nvolumes)
                     :TObject(),
                      fTotalTime(0),
                      fTimer(),
-                     fVolumeMon(0)
+                     fVolumeMon(0),
+                     fSampling(0),
+                     fStepCounter(0),
+                     fNPendingSamples(0),
+                     fCosts(),
+                     fMedia(0),
+                     fCostIndex()
 {
 // Default constructor
   fVolumeMon = new TObjArray(nvolumes);
@@ -189,6 +208,7 @@ AliTransportMonitor::~AliTransportMonitor()
 {
 // Destructor
   delete fVolumeMon;
+  delete fMedia;
 }
 
 //______________________________________________________________________________
@@ -337,7 +357,7 @@ void AliTransportMonitor::Merge(AliTransportMonitor* mergeMon)
 {
 
   // merge with monitor 
-  if (!fVolumeMon) 
+  if (!fVolumeMon && mergeMon->GetVolumes()) 
     {
       TObjArray* arr = mergeMon->GetVolumes();
       Int_t nvol = arr->GetEntriesFast();
@@ -351,16 +371,34 @@ void AliTransportMonitor::Merge(AliTransportMonitor* mergeMon)
     } // first time
 
 
-  Int_t n = fVolumeMon->GetEntriesFast();
+  Int_t n = fVolumeMon ? fVolumeMon->GetEntriesFast() : 0;
   TObjArray* mergeVols = mergeMon->GetVolumes();
-  fTotalTime = 0;
-  for (Int_t i = 0; i < n; i++)
-    {
-      AliTransportMonitorVol *volMon1 = (AliTransportMonitorVol*)fVolumeMon->At(i);      
-      AliTransportMonitorVol *volMon2 = (AliTransportMonitorVol*)mergeVols->At(i);      
-      volMon1->Merge(volMon2);
-      fTotalTime += (volMon1->GetTotalTime());
-    }
+  if (mergeVols && mergeVols->GetEntriesFast() == n) {
+    for (Int_t i = 0; i < n; i++)
+      {
+        AliTransportMonitorVol *volMon1 = (AliTransportMonitorVol*)fVolumeMon->At(i);      
+        AliTransportMonitorVol *volMon2 = (AliTransportMonitorVol*)mergeVols->At(i);      
+        volMon1->Merge(volMon2);
+      }
+  } else if (mergeVols) {
+    Error("Merge", "Monitors have different number of volumes, only the cost tables are merged");
+  }
+  // Sampled steps are not booked per volume, take the total from the monitor
+  fTotalTime += mergeMon->GetTotalTime();
+  if (!fSampling) fSampling = mergeMon->GetSampling();
+
+  // Cost tables
+  Int_t ncells = mergeMon->GetNCostCells();
+  for (Int_t i = 0; i < ncells; i++) {
+    const AliCostCell &cell = mergeMon->GetCostCell(i);
+    AliCostCell &mine = GetCostCell(cell.fVolume, cell.fMedium, cell.fPDG, cell.fEBin);
+    mine.fNSteps += cell.fNSteps;
+    mine.fTime   += cell.fTime;
+  }
+  if (!fMedia && mergeMon->fMedia) {
+    fMedia = (TObjArray*)mergeMon->fMedia->Clone();
+    fMedia->SetOwner();
+  }
 }
 //______________________________________________________________________________
 AliTransportMonitor *AliTransportMonitor::Import(const char *fname)
@@ -380,4 +418,225 @@ AliTransportMonitor *AliTransportMonitor::Import(const char *fname)
   return mon;
 }
 
-    
+//______________________________________________________________________________
+AliTransportMonitor *AliTransportMonitor::MergeFiles(const char *fileList, const char *outFile)
+{
+// Merge the monitors exported by many jobs. The list is a text file with one
+// monitoring file per line. The merged monitor is exported to outFile (if
+// not empty) and returned.
+  TString listName = fileList;
+  gSystem->ExpandPathName(listName);
+  ifstream in(listName.Data());
+  if (!in.good()) {
+    ::Error("MergeFiles", "Cannot open file list %s", fileList);
+    return 0;
+  }
+  AliTransportMonitor *merged = new AliTransportMonitor();
+  Int_t nfiles = 0;
+  TString line;
+  while (line.ReadLine(in)) {
+    line = line.Strip(TString::kBoth);
+    if (line.IsNull() || line.BeginsWith("#")) continue;
+    AliTransportMonitor *mon = Import(line.Data());
+    if (!mon) continue;
+    merged->Merge(mon);
+    delete mon;
+    nfiles++;
+  }
+  ::Info("MergeFiles", "Merged %d monitoring files from %s", nfiles, fileList);
+  if (!nfiles) {
+    delete merged;
+    return 0;
+  }
+  if (outFile && strlen(outFile)) merged->Export(outFile);
+  return merged;
+}
+
+//______________________________________________________________________________
+Int_t AliTransportMonitor::NormalizedPDG(Int_t pdg)
+{
+// Heavy fragments unknown to the PDG data base are all booked as "1111111111"
+  Int_t apdg = TMath::Abs(pdg);
+  if ((apdg > 10000) 
+      && (apdg != 1000010020)
+      && (apdg != 1000010030)
+      && (apdg != 1000020030)
+      && (apdg != 1000020040)
+      && (apdg != 50000050)
+      && (apdg != 50000051)
+      ) 
+    return 1111111111; 
+  return pdg;
+}
+
+//______________________________________________________________________________
+Int_t AliTransportMonitor::EnergyBin(Double_t energy)
+{
+// Energy bin (total energy in GeV), two bins per decade starting at 1 keV
+  if (energy <= 1.e-6) return 0;
+  Int_t ebin = Int_t(2.*(TMath::Log10(energy)+6.));
+  return (ebin < kNEBins) ? ebin : kNEBins-1;
+}
+
+//______________________________________________________________________________
+Double_t AliTransportMonitor::EnergyBinLowEdge(Int_t ebin)
+{
+// Lower edge of an energy bin in GeV
+  return TMath::Power(10., 0.5*ebin-6.);
+}
+
+//______________________________________________________________________________
+void AliTransportMonitor::SampleInfo(Int_t volId, Int_t medium, Int_t pdg, Double_t energy)
+{
+// Book the sampled step. Its time is scaled by the sampling factor to
+// estimate the cost of all the steps it stands for.
+// A sample deferred from steps which could not be timed stands for the
+// steps of all the pending samples.
+  fTimer.Stop();
+  Double_t scale = ((fSampling > 1) ? fSampling : 1.) * TMath::Max(fNPendingSamples, 1);
+  fNPendingSamples = 0;
+  Double_t dt = scale*fTimer.RealTime();
+  fTotalTime += dt;
+  AliCostCell &cell = GetCostCell(volId, medium, NormalizedPDG(pdg), EnergyBin(energy));
+  cell.fNSteps += scale;
+  cell.fTime   += dt;
+  if (fSampling <= 1) fTimer.Start(kTRUE);
+}
+
+//______________________________________________________________________________
+AliTransportMonitor::AliCostCell &AliTransportMonitor::GetCostCell(Int_t volId, Int_t medium, Int_t pdg, Int_t ebin)
+{
+// Retrieve the cost cell for the given combination, create it if needed.
+// The medium is not part of the key since a volume has a single medium.
+  if (fCostIndex.size() != fCosts.size()) {
+    // table read from file
+    fCostIndex.clear();
+    for (UInt_t i=0; i<fCosts.size(); i++) {
+      const AliCostCell &cell = fCosts[i];
+      ULong64_t key = (ULong64_t(cell.fVolume)<<40) | (ULong64_t(cell.fEBin&0xff)<<32) | UInt_t(cell.fPDG);
+      fCostIndex[key] = i;
+    }
+  }
+  ULong64_t key = (ULong64_t(volId)<<40) | (ULong64_t(ebin&0xff)<<32) | UInt_t(pdg);
+  CostMap_t::iterator it = fCostIndex.find(key);
+  if (it != fCostIndex.end()) return fCosts[it->second];
+  AliCostCell cell;
+  cell.fVolume = volId;
+  cell.fMedium = medium;
+  cell.fPDG    = pdg;
+  cell.fEBin   = ebin;
+  fCostIndex[key] = fCosts.size();
+  fCosts.push_back(cell);
+  return fCosts.back();
+}
+
+//______________________________________________________________________________
+void AliTransportMonitor::SetMediumLabel(Int_t medium, const char *label)
+{
+// Set the label of a tracking medium, used in the reports
+  if (medium < 0) return;
+  if (!fMedia) {
+    fMedia = new TObjArray(medium+1);
+    fMedia->SetOwner();
+  }
+  if (medium < fMedia->GetSize()) delete fMedia->At(medium);
+  fMedia->AddAtAndExpand(new TObjString(label), medium);
+}
+
+//______________________________________________________________________________
+const char *AliTransportMonitor::GetMediumLabel(Int_t medium) const
+{
+// Label of a tracking medium, the medium number if not set
+  TObject *label = (fMedia && medium >= 0 && medium < fMedia->GetSize()) ? fMedia->At(medium) : 0;
+  if (label) return label->GetName();
+  return Form("medium %d", medium);
+}
+
+//______________________________________________________________________________
+void AliTransportMonitor::PrintRanked(Int_t ntop, Option_t *opt) const
+{
+// Print the ntop most expensive volume/particle combinations of the cost
+// table, summed over the energy bins. With option "E" the energy bins are
+// ranked separately.
+  TString sopt(opt);
+  sopt.ToUpper();
+  Bool_t perBin = sopt.Contains("E");
+  Int_t ncells = fCosts.size();
+  if (!ncells) {
+    Info("PrintRanked", "Cost table is empty, was sampling mode on ?");
+    return;
+  }
+  // Sum the energy bins, remembering the most expensive one
+  std::vector<AliCostCell> rows;
+  std::vector<Int_t> peak;
+  std::map<ULong64_t, Int_t> index;
+  Double_t total = 0.;
+  for (Int_t i=0; i<ncells; i++) {
+    const AliCostCell &cell = fCosts[i];
+    total += cell.fTime;
+    ULong64_t key = (ULong64_t(cell.fVolume)<<40) | UInt_t(cell.fPDG);
+    if (perBin) key |= ULong64_t(cell.fEBin&0xff)<<32;
+    std::map<ULong64_t, Int_t>::iterator it = index.find(key);
+    if (it == index.end()) {
+      index[key] = rows.size();
+      rows.push_back(cell);
+      peak.push_back(i);
+      continue;
+    }
+    AliCostCell &row = rows[it->second];
+    row.fNSteps += cell.fNSteps;
+    row.fTime   += cell.fTime;
+    if (cell.fTime > fCosts[peak[it->second]].fTime) peak[it->second] = i;
+  }
+  Int_t nrows = rows.size();
+  std::vector<Double_t> times(nrows);
+  std::vector<Int_t> isort(nrows);
+  for (Int_t i=0; i<nrows; i++) times[i] = rows[i].fTime;
+  TMath::Sort(nrows, &times[0], &isort[0], kTRUE);
+
+  TDatabasePDG *pdgDB = TDatabasePDG::Instance();    
+  if (!pdgDB->ParticleList()) AliPDG::AddParticlesToPdgDataBase();
+  if (ntop <= 0 || ntop > nrows) ntop = nrows;
+  printf("=============================================================================\n");
+  printf("Transport cost ranking: %d of %d combinations, total %g [s], sampling 1/%d\n",
+         ntop, nrows, total, TMath::Max(fSampling,1));
+  printf("%4s %-20s %-32s %-14s %7s %7s %12s %10s %s\n", "rank", "volume", "medium (DET numed name)", "particle",
+         "t(%)", "cum(%)", "steps", "us/step", perBin ? "energy [GeV]" : "peak energy [GeV]");
+  Double_t cumulant = 0.;
+  for (Int_t i=0; i<ntop; i++) {
+    const AliCostCell &row = rows[isort[i]];
+    Double_t frac = (total > 0) ? 100.*row.fTime/total : 0.;
+    cumulant += frac;
+    const char *volName = (fVolumeMon && row.fVolume < fVolumeMon->GetEntriesFast()) ?
+                          fVolumeMon->At(row.fVolume)->GetName() : Form("volume %d", row.fVolume);
+    TParticlePDG *pdgP = pdgDB->GetParticle(row.fPDG);
+    TString particle = pdgP ? pdgP->GetName() : Form("%d", row.fPDG);
+    Int_t ebin = perBin ? row.fEBin : fCosts[peak[isort[i]]].fEBin;
+    printf("%4d %-20s %-32s %-14s %7.2f %7.2f %12.0f %10.3g %g-%g\n", i+1, volName, GetMediumLabel(row.fMedium),
+           particle.Data(), frac, cumulant, row.fNSteps, (row.fNSteps > 0) ? 1.e6*row.fTime/row.fNSteps : 0.,
+           EnergyBinLowEdge(ebin), EnergyBinLowEdge(ebin+1));
+  }
+  printf("=============================================================================\n");
+}
+
+//______________________________________________________________________________
+void AliTransportMonitor::ExportCosts(const char *fname) const
+{
+// Write the cost table as text, one line per volume/particle/energy bin
+  ofstream out(fname);
+  if (!out.good()) {
+    Error("ExportCosts", "Cannot create %s", fname);
+    return;
+  }
+  out << "# volume medium_label pdg emin[GeV] emax[GeV] steps time[s]" << endl;
+  for (UInt_t i=0; i<fCosts.size(); i++) {
+    const AliCostCell &cell = fCosts[i];
+    const char *volName = (fVolumeMon && cell.fVolume < fVolumeMon->GetEntriesFast()) ?
+                          fVolumeMon->At(cell.fVolume)->GetName() : Form("%d", cell.fVolume);
+    TString label = GetMediumLabel(cell.fMedium);
+    label.ReplaceAll(" ", "_");
+    out << volName << " " << label << " " << cell.fPDG << " "
+        << EnergyBinLowEdge(cell.fEBin) << " " << EnergyBinLowEdge(cell.fEBin+1) << " "
+        << cell.fNSteps << " " << cell.fTime << endl;
+  }
+}
@@ -8,6 +8,7 @@
 #endif
 
 #include <map>
+#include <vector>
 
 #ifndef ROOT_TStopwatch
 #include "TStopwatch.h"
@@ -74,8 +75,21 @@ public:
   ClassDef(AliTransportMonitorVol,2)  // Helper to hold particle info per volume
   };
   //________________________________________________________________
+  class AliCostCell {
+  public:
+    Int_t         fVolume;     // volume id
+    Int_t         fMedium;     // tracking medium id
+    Int_t         fPDG;        // particle PDG
+    Int_t         fEBin;       // energy bin, see EnergyBin()
+    Double_t      fNSteps;     // number of steps (estimated in sampling mode)
+    Double_t      fTime;       // transport time (estimated in sampling mode)
+    AliCostCell() : fVolume(0), fMedium(0), fPDG(0), fEBin(0), fNSteps(0), fTime(0) {}
+    virtual ~AliCostCell() {}
+    ClassDef(AliCostCell, 1)     // Step cost per volume, medium, particle and energy bin
+  };
+  //________________________________________________________________
 private:
-  AliTransportMonitor(const AliTransportMonitor&other) : TObject(other), fTotalTime(0), fTimer(), fVolumeMon(0) {}
+  AliTransportMonitor(const AliTransportMonitor&other) : TObject(other), fTotalTime(0), fTimer(), fVolumeMon(0), fSampling(0), fStepCounter(0), fNPendingSamples(0), fCosts(), fMedia(0), fCostIndex() {}
   AliTransportMonitor &operator=(const AliTransportMonitor&) {return *this;}
 public:
   AliTransportMonitor();
@@ -86,6 +100,23 @@ public:
                              Int_t    pdg,
                              Double_t energy, 
                              Double_t x, Double_t y, Double_t z);
+  // Sampling mode: only one step in fSampling is timed and booked in the
+  // cost table, the others only cost the call to SampleStep()
+  void              SetSampling(Int_t nsteps)  {fSampling = nsteps;}
+  Int_t             GetSampling() const        {return fSampling;}
+  inline Bool_t     SampleStep();
+  void              SkipSample()               {fTimer.Start(kTRUE);}
+  void              SampleInfo(Int_t volId, Int_t medium, Int_t pdg, Double_t energy);
+  void              SetMediumLabel(Int_t medium, const char *label);
+  const char       *GetMediumLabel(Int_t medium) const;
+  Int_t             GetNCostCells() const      {return fCosts.size();}
+  const AliCostCell &GetCostCell(Int_t i) const {return fCosts[i];}
+  void              PrintRanked(Int_t ntop=20, Option_t *opt="") const;
+  void              ExportCosts(const char *fname) const;
+  static Int_t      EnergyBin(Double_t energy);
+  static Double_t   EnergyBinLowEdge(Int_t ebin);
+  static Int_t      NormalizedPDG(Int_t pdg);
+  //
   void              Print(Option_t *volName="") const;
   void              DummyStep();
   void              Start();
@@ -93,14 +124,41 @@ public:
   void              Export(const char *fname);
   TObjArray*        GetVolumes() const {return fVolumeMon;}
   void              Merge(AliTransportMonitor* mergeMon);
+  Double_t          GetTotalTime() const {return fTotalTime;}
   static AliTransportMonitor *Import(const char *fname);
+  static AliTransportMonitor *MergeFiles(const char *fileList, const char *outFile="timing_merged.root");
 private:
+  AliCostCell      &GetCostCell(Int_t volId, Int_t medium, Int_t pdg, Int_t ebin);
+
+  enum {kNEBins = 20};           // energy bins: 2 per decade from 1 keV
   Double_t          fTotalTime;  // Total simulation time
   TStopwatch        fTimer;      //! Global timer
   TObjArray        *fVolumeMon;  // Array of monitoring objects per volume
+  Int_t             fSampling;   // Time one step in fSampling (0: every step, per volume only)
+  Int_t             fStepCounter;//! Steps since the last sample
+  Int_t             fNPendingSamples;//! Samples due but not yet booked
+  std::vector<AliCostCell> fCosts; // Step cost table
+  TObjArray        *fMedia;      // Labels of the tracking media ("DET numed name")
+  typedef std::map<ULong64_t, Int_t> CostMap_t;
+  CostMap_t         fCostIndex;  //! Map of the cost table, rebuilt after reading
   
-ClassDef(AliTransportMonitor,1)  // Class to monitor timing per volume 
+ClassDef(AliTransportMonitor,2)  // Class to monitor timing per volume 
 };
+
+//______________________________________________________________________________
+inline Bool_t AliTransportMonitor::SampleStep()
+{
+// Count the step; returns kTRUE while a sample is due. It has to be booked
+// with SampleInfo(), or deferred to the next step with SkipSample() if this
+// step cannot be timed. The timer is started one step before the sampled one.
+  if (++fStepCounter >= fSampling) {
+    fStepCounter = 0;
+    fNPendingSamples++;
+  } else if (fStepCounter == fSampling-1 && !fNPendingSamples) {
+    fTimer.Start(kTRUE);
+  }
+  return fNPendingSamples > 0;
+}
 //______________________________________________________________________________
 
 
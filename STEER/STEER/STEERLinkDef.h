@@ -47,6 +47,7 @@
 #pragma link C++ class  AliRunLoader+;
 #pragma link C++ class  AliReconstructor+;
 #pragma link C++ class  AliMC+;
+#pragma link C++ class  AliStepState+;
 #pragma link C++ class  AliSimulation+;
 #pragma link C++ class  AliReconstruction+;
 #pragma link C++ class  AliRecoInputHandler+;
@@ -157,6 +158,7 @@
 #pragma link C++ class AliTransportMonitor+;
 #pragma link C++ class AliTransportMonitor::AliTransportMonitorVol+;
 #pragma link C++ struct AliTransportMonitor::AliTransportMonitorVol::AliPMonData+;
+#pragma link C++ class AliTransportMonitor::AliCostCell+;
 
 #pragma link C++ class AliParamList+;
 
@@ -244,9 +244,39 @@ AliGenEventHeader*  AliHeader::GenEventHeader() const
 }
 
 //_______________________________________________________________________
-void AliHeader::Copy(TObject&) const
+void AliHeader::Copy(TObject& obj) const
 {
-  AliFatal("Not implemented");
+  //
+  // Copy this header into obj. The generator and detector headers are
+  // owned by the header and therefore cloned, the stack is only referenced
+  //
+  AliHeader& head = static_cast<AliHeader&>(obj);
+  if (&head == this) return;
+  TObject::Copy(head);
+  head.fRun          = fRun;
+  head.fNvertex      = fNvertex;
+  head.fNprimary     = fNprimary;
+  head.fNtrack       = fNtrack;
+  head.fEvent        = fEvent;
+  head.fEventNrInRun = fEventNrInRun;
+  head.fTimeStamp    = fTimeStamp;
+  head.fStack        = fStack;
+
+  delete head.fGenHeader;
+  head.fGenHeader = fGenHeader ? static_cast<AliGenEventHeader*>(fGenHeader->Clone()) : 0;
+
+  if (head.fDetHeaders) {
+    head.fDetHeaders->Delete();
+    delete head.fDetHeaders;
+    head.fDetHeaders = 0;
+  }
+  if (fDetHeaders) {
+    head.fDetHeaders = new TObjArray(fDetHeaders->GetSize());
+    for (Int_t i = 0; i < fDetHeaders->GetEntriesFast(); i++) {
+      TObject* detHeader = fDetHeaders->At(i);
+      if (detHeader) head.fDetHeaders->AddAt(detHeader->Clone(), i);
+    }
+  }
 }
 
 
@@ -71,6 +71,8 @@ fTuneMConData(kFALSE),
 fTuneMConDataMask(kDetTOF|kDetTPC),
 fIsMC(isMC),
 fCachePID(kFALSE),
+fCacheEventPID(kFALSE),
+fFillEventPIDCache(kFALSE),
 fOADBPath(),
 fCustomTPCpidResponse(),
 fCustomTPCpidResponseOADBFile(),
@@ -108,7 +110,11 @@ fCurrentEvent(NULL),
 fCurrentMCEvent(NULL),
 fCurrCentrality(0.0),
 fBeamTypeNum(kPP),
-fNoTOFmism(kFALSE)
+fNoTOFmism(kFALSE),
+fEventPIDCacheNtracks(0),
+fEventPIDNSigma(),
+fEventPIDProb(),
+fEventPIDStatus()
 {
   //
   // default ctor
@@ -147,6 +153,8 @@ fTuneMConData(other.fTuneMConData),
 fTuneMConDataMask(other.fTuneMConDataMask),
 fIsMC(other.fIsMC),
 fCachePID(other.fCachePID),
+fCacheEventPID(other.fCacheEventPID),
+fFillEventPIDCache(other.fFillEventPIDCache),
 fOADBPath(other.fOADBPath),
 fCustomTPCpidResponse(other.fCustomTPCpidResponse),
 fCustomTPCpidResponseOADBFile(other.fCustomTPCpidResponseOADBFile),
@@ -184,7 +192,11 @@ fCurrentEvent(NULL),
 fCurrentMCEvent(NULL),
 fCurrCentrality(0.0),
 fBeamTypeNum(kPP),
-fNoTOFmism(other.fNoTOFmism)
+fNoTOFmism(other.fNoTOFmism),
+fEventPIDCacheNtracks(0),
+fEventPIDNSigma(),
+fEventPIDProb(),
+fEventPIDStatus()
 {
   //
   // copy ctor
@@ -249,7 +261,9 @@ AliPIDResponse& AliPIDResponse::operator=(const AliPIDResponse &other)
     fCurrentEvent=other.fCurrentEvent;
     fCurrentMCEvent=other.fCurrentMCEvent;
     fNoTOFmism = other.fNoTOFmism;
-
+    fCacheEventPID = other.fCacheEventPID;
+    fFillEventPIDCache = other.fFillEventPIDCache;
+    fEventPIDCacheNtracks = 0;
   }
   return *this;
 }
@@ -267,7 +281,15 @@ Float_t AliPIDResponse::NumberOfSigmas(EDetector detector, const AliVParticle *v
 
   if ( detPID && detPID->HasNumberOfSigmas(detector)){
     return detPID->GetNumberOfSigmas(detector, type);
-  } else if (fCachePID) {
+  }
+
+  // then in the event cache
+  const Int_t idx=GetEventPIDCacheIndex(track, detector);
+  if (idx>=0 && type>=0 && type<AliPID::kSPECIESC) {
+    return fEventPIDNSigma.At(idx*AliPID::kSPECIESC+(Int_t)type);
+  }
+
+  if (fCachePID) {
     FillTrackDetectorPID(track, detector);
     detPID=track->GetDetectorPID();
     return detPID->GetNumberOfSigmas(detector, type);
@@ -487,7 +509,16 @@ AliPIDResponse::EDetPidStatus AliPIDResponse::ComputePIDProbability  (EDetector
 
   if ( detPID && detPID->HasRawProbability(detector)){
     return detPID->GetRawProbability(detector, p, nSpecies);
-  } else if (fCachePID) {
+  }
+
+  const Int_t idx=GetEventPIDCacheIndex(track, detector);
+  if (idx>=0 && nSpecies<=AliPID::kSPECIESC) {
+    const Double_t *prob=fEventPIDProb.GetArray()+idx*AliPID::kSPECIESC;
+    for (Int_t ipart=0; ipart<nSpecies; ++ipart) p[ipart]=prob[ipart];
+    return (EDetPidStatus)fEventPIDStatus.At(idx);
+  }
+
+  if (fCachePID) {
     FillTrackDetectorPID(track, detector);
     detPID=track->GetDetectorPID();
     return detPID->GetRawProbability(detector, p, nSpecies);
@@ -566,7 +597,12 @@ AliPIDResponse::EDetPidStatus AliPIDResponse::CheckPIDStatus(EDetector detector,
 
   if ( detPID ){
     return detPID->GetPIDStatus(detector);
-  } else if (fCachePID) {
+  }
+
+  const Int_t idx=GetEventPIDCacheIndex(track, detector);
+  if (idx>=0) return (EDetPidStatus)fEventPIDStatus.At(idx);
+
+  if (fCachePID) {
     FillTrackDetectorPID(track, detector);
     detPID=track->GetDetectorPID();
     return detPID->GetPIDStatus(detector);
@@ -586,6 +622,7 @@ void AliPIDResponse::InitialiseEvent(AliVEvent *event, Int_t pass, Int_t run)
 
 
   fCurrentEvent=NULL;
+  fEventPIDCacheNtracks=0;
   if (!event) return;
   fCurrentEvent=event;
   if (run>0) fRun=run;
@@ -643,6 +680,78 @@ void AliPIDResponse::InitialiseEvent(AliVEvent *event, Int_t pass, Int_t run)
     }
   }
 
+  // invalidate the PID values cached for the previous event
+  ResetEventPIDCache();
+}
+
+//______________________________________________________________________________
+void AliPIDResponse::ResetEventPIDCache()
+{
+  //
+  // setup the event PID cache for the current event. The arrays are only
+  // enlarged, such that no reallocation happens for events of similar size.
+  // If requested the values are computed for all tracks and detectors
+  //
+
+  fEventPIDCacheNtracks=0;
+  if (!fCacheEventPID || !fCurrentEvent) return;
+
+  const Int_t ntracks=fCurrentEvent->GetNumberOfTracks();
+  const Int_t nentries=ntracks*kNdetectors;
+  if (fEventPIDStatus.GetSize()<nentries){
+    fEventPIDStatus.Set(nentries);
+    fEventPIDNSigma.Set(nentries*AliPID::kSPECIESC);
+    fEventPIDProb.Set(nentries*AliPID::kSPECIESC);
+  }
+  fEventPIDStatus.Reset(-1);
+  fEventPIDCacheNtracks=ntracks;
+
+  if (!fFillEventPIDCache) return;
+
+  for (Int_t itrack=0; itrack<ntracks; ++itrack){
+    AliVTrack *track=dynamic_cast<AliVTrack*>(fCurrentEvent->GetTrack(itrack));
+    if (!track) continue;
+
+    for (Int_t idet=0; idet<kNdetectors; ++idet){
+      GetEventPIDCacheIndex(track, (EDetector)idet);
+    }
+  }
+}
+
+//______________________________________________________________________________
+Int_t AliPIDResponse::GetEventPIDCacheIndex(const AliVTrack *track, EDetector detector) const
+{
+  //
+  // index of 'detector' for 'track' in the event PID cache. The values are
+  // computed on first access. Returns -1 if the cache is disabled or if the
+  // track cannot be found in the current event via its ID (e.g. AOD tracks,
+  // whose ID refers to the ESD track)
+  //
+
+  if (!fCacheEventPID || !fCurrentEvent) return -1;
+  const Int_t idet=(Int_t)detector;
+  if (idet<0 || idet>=kNdetectors) return -1;
+
+  const Int_t itrack=track->GetID();
+  if (itrack<0 || itrack>=fEventPIDCacheNtracks) return -1;
+  if (fCurrentEvent->GetTrack(itrack)!=track) return -1;
+
+  const Int_t idx=itrack*kNdetectors+idet;
+  if (fEventPIDStatus.At(idx)>=0) return idx;
+
+  // compute the values as in FillTrackDetectorPID
+  Double_t values[AliPID::kSPECIESC]={0};
+  EDetPidStatus status=GetComputePIDProbability(detector,track,AliPID::kSPECIESC,values);
+
+  Double_t *prob=fEventPIDProb.GetArray()+idx*AliPID::kSPECIESC;
+  Float_t  *nsig=fEventPIDNSigma.GetArray()+idx*AliPID::kSPECIESC;
+  for (Int_t ipart=0; ipart<AliPID::kSPECIESC; ++ipart){
+    prob[ipart]=values[ipart];
+    nsig[ipart]=GetNumberOfSigmas(detector,track,(AliPID::EParticleType)ipart);
+  }
+  fEventPIDStatus.GetArray()[idx]=(Char_t)status;
+
+  return idx;
 }
 
 //______________________________________________________________________________
@@ -23,6 +23,9 @@
 #include "AliPID.h"
 
 #include "TNamed.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
 
 class TF1;
 class TObjArray;
@@ -158,6 +161,11 @@ public:
   void FillTrackDetectorPID(const AliVTrack *track, EDetector detector) const;
   void FillTrackDetectorPID();
 
+  // cache PID of all tracks of the current event in flat arrays,
+  // filled on first access or for all tracks in InitialiseEvent
+  void SetCacheEventPID(Bool_t cache, Bool_t fillInInitialiseEvent=kFALSE) { fCacheEventPID=cache; fFillEventPIDCache=fillInInitialiseEvent; }
+  Bool_t GetCacheEventPID() const { return fCacheEventPID; }
+
   AliVEvent*  GetCurrentEvent()   const {return fCurrentEvent;  }
   AliMCEvent* GetCurrentMCEvent() const {return fCurrentMCEvent;}
   void SetCurrentMCEvent(AliMCEvent* mcEvent) {fCurrentMCEvent=mcEvent;}
@@ -240,6 +248,8 @@ private:
 
   Bool_t fIsMC;                        //  If we run on MC data
   Bool_t fCachePID;
+  Bool_t fCacheEventPID;               //  cache PID of the tracks of the current event
+  Bool_t fFillEventPIDCache;           //  fill the event PID cache for all tracks in InitialiseEvent
 
   TString fOADBPath;                   // OADB path to use
   TString fCustomTPCpidResponse;       // Custom TPC Pid Response file for debugging purposes
@@ -290,8 +300,17 @@ private:
 
   Bool_t fNoTOFmism;                   //! flag to switch off the TOF mismatch in the TOF weights (to check with old aliroot version)
 
+  Int_t           fEventPIDCacheNtracks; //! number of tracks covered by the event PID cache
+  mutable TArrayF fEventPIDNSigma;       //! cached number of sigmas [track][detector][species]
+  mutable TArrayD fEventPIDProb;         //! cached raw probabilities [track][detector][species]
+  mutable TArrayC fEventPIDStatus;       //! cached pid status [track][detector], -1 if not filled yet
+
   void ExecNewRun();
 
+  // event PID cache
+  void ResetEventPIDCache();
+  Int_t GetEventPIDCacheIndex(const AliVTrack *track, EDetector detector) const;
+
   //
   //setup parametrisations
   //
@@ -376,7 +395,7 @@ private:
   EDetPidStatus GetPHOSPIDStatus(const AliVTrack *track) const;
   EDetPidStatus GetEMCALPIDStatus(const AliVTrack *track) const;
 
-  ClassDef(AliPIDResponse, 18);  //PID response handling
+  ClassDef(AliPIDResponse, 19);  //PID response handling
 };
 
 #endif
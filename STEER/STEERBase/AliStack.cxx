@@ -55,7 +55,9 @@ AliStack::AliStack():
   fCurrentPrimary(-1),
   fHgwmk(0),
   fLoadPoint(0),
-  fTrackLabelMap(0)
+  fTrackLabelMap(0),
+  fReorderMap(0),
+  fReorderBuffer()
 {
   //
   // Default constructor
@@ -77,7 +79,9 @@ AliStack::AliStack(Int_t size, const char* /*evfoldname*/):
   fCurrentPrimary(-1),
   fHgwmk(0),
   fLoadPoint(0),
-  fTrackLabelMap(0)
+  fTrackLabelMap(0),
+  fReorderMap(0),
+  fReorderBuffer()
 {
   //
   //  Constructor
@@ -100,7 +104,9 @@ AliStack::AliStack(const AliStack& st):
     fCurrentPrimary(-1),
     fHgwmk(0),
     fLoadPoint(0),
-    fTrackLabelMap(0)
+    fTrackLabelMap(0),
+    fReorderMap(0),
+    fReorderBuffer()
 {
     // Copy constructor
 }
@@ -157,7 +163,7 @@ void AliStack::PushTrack(Int_t done, Int_t parent, Int_t pdg, const Float_t *pmo
   //
     TParticlePDG* pmc =  TDatabasePDG::Instance()->GetParticle(pdg);
     if (pmc) {
-	Float_t mass = TDatabasePDG::Instance()->GetParticle(pdg)->Mass();
+	Float_t mass = pmc->Mass();
 	Float_t e=TMath::Sqrt(mass*mass+pmom[0]*pmom[0]+
 			      pmom[1]*pmom[1]+pmom[2]*pmom[2]);
 	
@@ -302,7 +308,7 @@ Bool_t AliStack::PurifyKine()
 
   int nkeep = fHgwmk + 1, parent, i;
   TParticle *part, *father;
-  fTrackLabelMap.Set(fParticleMap.GetLast()+1);
+  ExpandTrackLabelMap(fParticleMap.GetLast()+1);
 
   // Save in Header total number of tracks before compression
   // If no tracks generated return now
@@ -402,10 +408,13 @@ Bool_t AliStack::ReorderKine()
     
   if (nNew > 0) {
       Int_t i, j;
-      TArrayI map1(nNew);
+      // Scratch arrays are kept between calls, this is done for every primary
+      if (fReorderMap.GetSize() < nNew) fReorderMap.Set(nNew);
+      if (Int_t(fReorderBuffer.size()) < nNew) fReorderBuffer.resize(nNew);
+      Int_t* map1 = fReorderMap.GetArray();
       //
       // Copy pointers to temporary array
-      TParticle** tmp = new TParticle*[nNew];
+      TParticle** tmp = &fReorderBuffer[0];
       
       for (i = 0; i < nNew; i++) {
 	  if (fParticleMap.At(fHgwmk + 1 + i)) {
@@ -470,12 +479,10 @@ Bool_t AliStack::ReorderKine()
 	  } // children
       } // parents
 
-      delete[] tmp;
-
       //
       // Build map for remapping of hits
       // 
-      fTrackLabelMap.Set(fNtrack);
+      ExpandTrackLabelMap(fNtrack);
       for (i = 0; i < fNtrack; i ++) {
 	  if (i <= fHgwmk) {
 	      fTrackLabelMap[i] = i;
@@ -654,6 +661,17 @@ void  AliStack::ResetArrays(Int_t size)
   if (size>0) fParticleMap.Expand(size);
 }
 
+//_____________________________________________________________________________
+void AliStack::ExpandTrackLabelMap(Int_t size)
+{
+  //
+  // Make the track label map hold at least size labels. The map only grows,
+  // entries beyond the current number of tracks are not used
+  //
+  if (fTrackLabelMap.GetSize() >= size) return;
+  fTrackLabelMap.Set(TMath::Max(size, 2*fTrackLabelMap.GetSize()));
+}
+
 //_____________________________________________________________________________
 void AliStack::SetHighWaterMark(Int_t)
 {
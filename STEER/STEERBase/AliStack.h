@@ -18,6 +18,7 @@ class TTree;
 #include <TClonesArray.h>
 #include <TArrayI.h>
 #include <TVirtualMCStack.h>
+#include <vector>
 
 class AliHeader;
 
@@ -95,6 +96,7 @@ class AliStack : public TVirtualMCStack
     TParticle* GetNextParticle();
     Bool_t KeepPhysics(const TParticle* part);
     Bool_t IsStable(Int_t pdg) const;
+    void  ExpandTrackLabelMap(Int_t size);
   private:
     void Copy(TObject &st) const;
 
@@ -113,7 +115,9 @@ class AliStack : public TVirtualMCStack
     Int_t          fHgwmk;             //! Last track purified
     Int_t          fLoadPoint;         //! Next free position in the particle buffer
     TArrayI        fTrackLabelMap;     //! Map of track labels
-    ClassDef(AliStack,6) //Particles stack
+    TArrayI        fReorderMap;        //! Scratch map of ReorderKine, grows only
+    std::vector<TParticle*> fReorderBuffer; //! Scratch particle pointers of ReorderKine, grows only
+    ClassDef(AliStack,7) //Particles stack
 };
 
 // inline
@@ -27,6 +27,8 @@
 //      Benjamin Hess, University of Tuebingen, bhess@cern.ch
 //-----------------------------------------------------------------
 
+#include <cmath>
+
 #include <TGraph.h>
 #include <TError.h>
 #include <TObjArray.h>
@@ -93,7 +95,11 @@ AliTPCPIDResponse::AliTPCPIDResponse():
   fIROCweight(1.),
   fOROCmedWeight(1.),
   fOROClongWeight(1.),
-  fSplineArray()
+  fSplineArray(),
+  fUseResponseTables(kFALSE),
+  fTablePrecision(1e-4),
+  fTablesValid(kFALSE),
+  fTableValues()
 {
   //
   //  The default constructor
@@ -102,6 +108,11 @@ AliTPCPIDResponse::AliTPCPIDResponse():
   AliLog::SetClassDebugLevel("AliTPCPIDResponse", AliLog::kInfo); 
   
   for (Int_t i=0; i<fgkNumberOfGainScenarios; i++) {fRes0[i]=0.07;fResN2[i]=0.0;}
+
+  for (Int_t i=0; i<fgkNumberOfResponseTables; i++) {
+    fTableFunctions[i]=0x0; fTableFirst[i]=0; fTableNBins[i]=0; fTableEMin[i]=0;
+    fTableXmin[i]=0.; fTableXmax[i]=0.; fTableInvStep[i]=0.;
+  }
   
   fCorrFuncMultiplicity = new TF1("fCorrFuncMultiplicity", 
                                   "[0] + [1]*TMath::Max([4], TMath::Min(x, [3])) + [2] * TMath::Power(TMath::Max([4], TMath::Min(x, [3])), 2)",
@@ -207,10 +218,20 @@ AliTPCPIDResponse::AliTPCPIDResponse(const AliTPCPIDResponse& that):
   fIROCweight(that.fIROCweight),
   fOROCmedWeight(that.fOROCmedWeight),
   fOROClongWeight(that.fOROClongWeight),
-  fSplineArray()
+  fSplineArray(),
+  fUseResponseTables(that.fUseResponseTables),
+  fTablePrecision(that.fTablePrecision),
+  fTablesValid(kFALSE),
+  fTableValues()
 {
   //copy ctor
   for (Int_t i=0; i<fgkNumberOfGainScenarios; i++) {fRes0[i]=that.fRes0[i];fResN2[i]=that.fResN2[i];}
+
+  // tables are built again when needed
+  for (Int_t i=0; i<fgkNumberOfResponseTables; i++) {
+    fTableFunctions[i]=0x0; fTableFirst[i]=0; fTableNBins[i]=0; fTableEMin[i]=0;
+    fTableXmin[i]=0.; fTableXmax[i]=0.; fTableInvStep[i]=0.;
+  }
  
   // Copy eta maps
   if (that.fhEtaCorr) {
@@ -303,6 +324,10 @@ AliTPCPIDResponse& AliTPCPIDResponse::operator=(const AliTPCPIDResponse& that)
   fOROCmedWeight =that.fOROCmedWeight;
   fOROClongWeight=that.fOROClongWeight;
 
+  fUseResponseTables=that.fUseResponseTables;
+  fTablePrecision=that.fTablePrecision;
+  fTablesValid=kFALSE;
+
   return *this;
 }
 
@@ -380,7 +405,7 @@ Double_t AliTPCPIDResponse::GetExpectedSignal(Float_t mom,
 
   if (!responseFunction) return Bethe(mom/mass) * chargeFactor;
   
-  return fMIP*responseFunction->Eval(mom/mass)*chargeFactor;
+  return fMIP*EvalResponseFunction(n,responseFunction,mom/mass)*chargeFactor;
 
 }
 
@@ -404,6 +429,44 @@ Double_t AliTPCPIDResponse::GetExpectedSigma(Float_t mom,
     return GetExpectedSignal(mom,n)*fRes0[0];
 }
 
+//_________________________________________________________________________
+void AliTPCPIDResponse::GetExpectedSignals(Int_t nTracks, const Float_t *mom,
+                                           AliPID::EParticleType n, Double_t *signal) const {
+  //
+  // Same as GetExpectedSignal(Float_t mom, AliPID::EParticleType n)
+  // for the nTracks momenta mom, with the quantities depending
+  // on the particle type evaluated only once
+  //
+  const Double_t chargeFactor = TMath::Power(AliPID::ParticleCharge(n),2.3);
+  Double_t mass=AliPID::ParticleMassZ(n);
+
+  const TSpline3 * responseFunction = 0x0;
+  if (fUseDatabase) responseFunction = (TSpline3 *) fResponseFunctions.UncheckedAt(n);
+
+  if (!responseFunction) {
+    for (Int_t i=0; i<nTracks; i++) signal[i] = Bethe(mom[i]/mass) * chargeFactor;
+    return;
+  }
+
+  for (Int_t i=0; i<nTracks; i++) signal[i] = fMIP*EvalResponseFunction(n,responseFunction,mom[i]/mass)*chargeFactor;
+}
+
+//_________________________________________________________________________
+void AliTPCPIDResponse::GetExpectedSigmas(Int_t nTracks, const Int_t *nPoints,
+                                          const Double_t *signal, Double_t *sigma) const {
+  //
+  // Same as GetExpectedSigma(Float_t mom, Int_t nPoints, AliPID::EParticleType n)
+  // for nTracks tracks, from their expected signals as given by
+  // GetExpectedSignals, without evaluating them again
+  //
+  for (Int_t i=0; i<nTracks; i++) {
+    if (nPoints[i] != 0)
+      sigma[i] = signal[i]*fRes0[0]*sqrt(1. + fResN2[0]/nPoints[i]);
+    else
+      sigma[i] = signal[i]*fRes0[0];
+  }
+}
+
 ////////////////////////////////////////////////////NEW//////////////////////////////
 
 //_________________________________________________________________________
@@ -423,11 +486,14 @@ Double_t AliTPCPIDResponse::GetExpectedSignal(const AliVTrack* track,
                                               Double_t /*dEdx*/,
                                               const TSpline3* responseFunction,
                                               Bool_t correctEta,
-                                              Bool_t correctMultiplicity) const 
+                                              Bool_t correctMultiplicity,
+                                              Int_t responseIndex) const 
 {
   // Calculates the expected PID signal as the function of 
   // the information stored in the track and the given parameters,
   // for the specified particle type 
+  // responseIndex is the index of responseFunction in fResponseFunctions,
+  // which selects its table if the tables are used (-1: not known)
   //  
   // At the moment, these signals are just the results of calling the 
   // Bethe-Bloch formula plus, if desired, taking into account the eta dependence
@@ -446,7 +512,7 @@ Double_t AliTPCPIDResponse::GetExpectedSignal(const AliVTrack* track,
   if (!responseFunction)
     return Bethe(mom/mass) * chargeFactor;
   
-  Double_t dEdxSplines = fMIP*responseFunction->Eval(mom/mass) * chargeFactor;
+  Double_t dEdxSplines = fMIP*EvalResponseFunction(responseIndex,responseFunction,mom/mass) * chargeFactor;
     
   if (!correctEta && !correctMultiplicity)
     return dEdxSplines;
@@ -503,7 +569,7 @@ Double_t AliTPCPIDResponse::GetExpectedSignal(const AliVTrack* track,
   }
   
   // Charge factor already taken into account inside the following function call
-  return GetExpectedSignal(track, species, dEdx, responseFunction, correctEta, correctMultiplicity);
+  return GetExpectedSignal(track, species, dEdx, responseFunction, correctEta, correctMultiplicity, ResponseFunctionIndex(species,gainScenario));
 }
   
 //_________________________________________________________________________
@@ -540,6 +606,7 @@ void AliTPCPIDResponse::ResetSplines()
   {
     fResponseFunctions.AddAt(NULL,i);
   }
+  fTablesValid=kFALSE;
 }
 //_________________________________________________________________________
 Int_t AliTPCPIDResponse::ResponseFunctionIndex( AliPID::EParticleType species,
@@ -555,6 +622,7 @@ void AliTPCPIDResponse::SetResponseFunction( TObject* o,
                                              ETPCgainScenario gainScenario )
 {
   fResponseFunctions.AddAtAndExpand(o,ResponseFunctionIndex(species,gainScenario));
+  fTablesValid=kFALSE;
 }
 
 
@@ -586,19 +654,19 @@ Double_t AliTPCPIDResponse::GetExpectedSigma(const AliVTrack* track,
   // If no sigma map is available or if no eta correction is requested (sigma maps only for corrected eta!), use the old parametrisation
   if (!fhEtaSigmaPar1 || !correctEta) {  
     if (nPoints != 0) 
-      return GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, correctMultiplicity) *
+      return GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, correctMultiplicity, ResponseFunctionIndex(species,gainScenario)) *
                fRes0[gainScenario] * sqrt(1. + fResN2[gainScenario]/nPoints);
     else
-      return GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, correctMultiplicity)*fRes0[gainScenario];
+      return GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, correctMultiplicity, ResponseFunctionIndex(species,gainScenario))*fRes0[gainScenario];
   }
     
   if (nPoints > 0) {
     // Use eta correction (+ eta-dependent sigma)
-    Double_t sigmaPar1 = GetSigmaPar1Fast(track, species, dEdx, responseFunction);
+    Double_t sigmaPar1 = GetSigmaPar1Fast(track, species, dEdx, responseFunction, ResponseFunctionIndex(species,gainScenario));
     
     if (correctMultiplicity) {
       // In addition, take into account multiplicity dependence of mean and sigma of dEdx
-      Double_t dEdxExpectedEtaCorrected = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE);
+      Double_t dEdxExpectedEtaCorrected = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE, ResponseFunctionIndex(species,gainScenario));
       
       // GetMultiplicityCorrection and GetMultiplicitySigmaCorrection both need the eta corrected dEdxExpected
       Double_t multiplicityCorrFactor = GetMultiplicityCorrectionFast(track, dEdxExpectedEtaCorrected, fCurrentEventMultiplicity);
@@ -609,7 +677,7 @@ Double_t AliTPCPIDResponse::GetExpectedSigma(const AliVTrack* track,
               * (sqrt(fSigmaPar0 * fSigmaPar0 + sigmaPar1 * sigmaPar1 / nPoints) * multiplicitySigmaCorrFactor);
     }
     else {
-      return GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE)*
+      return GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE, ResponseFunctionIndex(species,gainScenario))*
              sqrt(fSigmaPar0 * fSigmaPar0 + sigmaPar1 * sigmaPar1 / nPoints);
     }
   }
@@ -663,7 +731,7 @@ Float_t AliTPCPIDResponse::GetNumberOfSigmas(const AliVTrack* track,
   if (!ResponseFunctiondEdxN(track, species, dedxSource, dEdx, nPoints, gainScenario, &responseFunction))
     return -999; //TODO: Better handling!
     
-  Double_t bethe = GetExpectedSignal(track, species, dEdx, responseFunction, correctEta, correctMultiplicity);
+  Double_t bethe = GetExpectedSignal(track, species, dEdx, responseFunction, correctEta, correctMultiplicity, ResponseFunctionIndex(species,gainScenario));
   Double_t sigma = GetExpectedSigma(track, species, gainScenario, dEdx, nPoints, responseFunction, correctEta, correctMultiplicity);
   // 999 will be returned by GetExpectedSigma e.g. in case of 0 dEdx clusters
   if (sigma >= 998) 
@@ -692,7 +760,7 @@ Float_t AliTPCPIDResponse::GetSignalDelta(const AliVTrack* track,
   if (!ResponseFunctiondEdxN(track, species, dedxSource, dEdx, nPoints, gainScenario, &responseFunction))
     return -9999.; //TODO: Better handling!
 
-  const Double_t bethe = GetExpectedSignal(track, species, dEdx, responseFunction, correctEta, correctMultiplicity);
+  const Double_t bethe = GetExpectedSignal(track, species, dEdx, responseFunction, correctEta, correctMultiplicity, ResponseFunctionIndex(species,gainScenario));
 
   Double_t delta=-9999.;
   if (!ratio) delta=dEdx-bethe;
@@ -861,7 +929,7 @@ Double_t AliTPCPIDResponse::GetEtaCorrection(const AliVTrack *track, AliPID::EPa
     return 1.; 
   
   // For the eta correction, do NOT take the multiplicity corrected value of dEdx
-  Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE);
+  Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE, ResponseFunctionIndex(species,gainScenario));
   
   //TODO Alternatively take current track dEdx
   //return GetEtaCorrectionFast(track, dEdx);
@@ -900,7 +968,7 @@ Double_t AliTPCPIDResponse::GetEtaCorrectedTrackdEdx(const AliVTrack *track, Ali
   
   if (species < AliPID::kUnknown) {
     // For the eta correction, do NOT take the multiplicity corrected value of dEdx
-    Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE);
+    Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE, ResponseFunctionIndex(species,gainScenario));
     etaCorr = GetEtaCorrectionFast(track, dEdxSplines);
   }
   else {
@@ -916,7 +984,7 @@ Double_t AliTPCPIDResponse::GetEtaCorrectedTrackdEdx(const AliVTrack *track, Ali
 
 //_________________________________________________________________________
 Double_t AliTPCPIDResponse::GetSigmaPar1Fast(const AliVTrack *track, AliPID::EParticleType species, Double_t dEdx,
-                                             const TSpline3* responseFunction) const
+                                             const TSpline3* responseFunction, Int_t responseIndex) const
 {
   // NOTE: For expert use only -> Non-experts are advised to use the function without the "Fast" suffix or stick to AliPIDResponse directly.
   //
@@ -941,7 +1009,7 @@ Double_t AliTPCPIDResponse::GetSigmaPar1Fast(const AliVTrack *track, AliPID::EPa
   // of such a particle, which by assumption then has this dEdx value
   
   // For the eta correction, do NOT take the multiplicity corrected value of dEdx
-  Double_t dEdxExpected = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE);
+  Double_t dEdxExpected = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE, responseIndex);
   
   if (dEdxExpected < 1.)
     return 999;
@@ -982,7 +1050,7 @@ Double_t AliTPCPIDResponse::GetSigmaPar1(const AliVTrack *track, AliPID::EPartic
   if (!ResponseFunctiondEdxN(track, species, dedxSource, dEdx, nPoints, gainScenario, &responseFunction))
     return 999; 
   
-  return GetSigmaPar1Fast(track, species, dEdx, responseFunction);
+  return GetSigmaPar1Fast(track, species, dEdx, responseFunction, ResponseFunctionIndex(species,gainScenario));
 }
 
 
@@ -1118,10 +1186,10 @@ Double_t AliTPCPIDResponse::GetMultiplicityCorrectionFast(const AliVTrack *track
     return 1.0;
   
   const Double_t dEdxExpectedInv = 1. / dEdxExpected;
-  Double_t relSlope = fCorrFuncMultiplicity->Eval(dEdxExpectedInv);
+  Double_t relSlope = EvalCorrectionFunction(0, fCorrFuncMultiplicity, dEdxExpectedInv);
   
   const Double_t tanTheta = GetTrackTanTheta(track);
-  relSlope += fCorrFuncMultiplicityTanTheta->Eval(tanTheta);
+  relSlope += EvalCorrectionFunction(1, fCorrFuncMultiplicityTanTheta, tanTheta);
 
   return (1. + relSlope * multiplicity);
 }
@@ -1150,7 +1218,7 @@ Double_t AliTPCPIDResponse::GetMultiplicityCorrection(const AliVTrack *track, Al
   
   //TODO Does it make sense to use the multiplicity correction WITHOUT eta correction?! Are the fit parameters still valid?
   // To get the expected signal to determine the multiplicity correction, do NOT ask for the multiplicity corrected value (of course)
-  Double_t dEdxExpected = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE);
+  Double_t dEdxExpected = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE, ResponseFunctionIndex(species,gainScenario));
   
   return GetMultiplicityCorrectionFast(track, dEdxExpected, fCurrentEventMultiplicity);
 }
@@ -1195,7 +1263,7 @@ Double_t AliTPCPIDResponse::GetMultiplicityCorrectedTrackdEdx(const AliVTrack *t
   if (species < AliPID::kUnknown) {
     // To get the expected signal to determine the multiplicity correction, do NOT ask for the multiplicity corrected value (of course).
     // However, one needs the eta corrected value!
-    Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE);
+    Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE, ResponseFunctionIndex(species,gainScenario));
     multiplicityCorr = GetMultiplicityCorrectionFast(track, dEdxSplines, fCurrentEventMultiplicity);
   }
   else {
@@ -1243,7 +1311,7 @@ Double_t AliTPCPIDResponse::GetEtaAndMultiplicityCorrectedTrackdEdx(const AliVTr
     
   if (species < AliPID::kUnknown) {
     // To get the expected signal to determine the multiplicity correction, do NOT ask for the multiplicity corrected value (of course)
-    Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE);
+    Double_t dEdxSplines = GetExpectedSignal(track, species, dEdx, responseFunction, kFALSE, kFALSE, ResponseFunctionIndex(species,gainScenario));
     etaCorr = GetEtaCorrectionFast(track, dEdxSplines);
     multiplicityCorr = GetMultiplicityCorrectionFast(track, dEdxSplines * etaCorr, fCurrentEventMultiplicity);
   }
@@ -1274,7 +1342,7 @@ Double_t AliTPCPIDResponse::GetMultiplicitySigmaCorrectionFast(Double_t dEdxExpe
   if (dEdxExpected <= 0 || multiplicity <= 0)
     return 1.0;
 
-  Double_t relSigmaSlope = fCorrFuncSigmaMultiplicity->Eval(1. / dEdxExpected);
+  Double_t relSigmaSlope = EvalCorrectionFunction(2, fCorrFuncSigmaMultiplicity, 1. / dEdxExpected);
 
   return (1. + relSigmaSlope * multiplicity);
 }
@@ -1303,7 +1371,7 @@ Double_t AliTPCPIDResponse::GetMultiplicitySigmaCorrection(const AliVTrack *trac
 
   //TODO Does it make sense to use the multiplicity correction WITHOUT eta correction?! Are the fit parameters still valid?
   // To get the expected signal to determine the multiplicity correction, do NOT ask for the multiplicity corrected value (of course)
-  Double_t dEdxExpected = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE);
+  Double_t dEdxExpected = GetExpectedSignal(track, species, dEdx, responseFunction, kTRUE, kFALSE, ResponseFunctionIndex(species,gainScenario));
 
   return GetMultiplicitySigmaCorrectionFast(dEdxExpected, fCurrentEventMultiplicity);
 }
@@ -1347,6 +1415,189 @@ void AliTPCPIDResponse::ResetMultiplicityCorrectionFunctions()
   fCorrFuncSigmaMultiplicity->SetParameter(1, 0.);
   fCorrFuncSigmaMultiplicity->SetParameter(2, 0.);
   fCorrFuncSigmaMultiplicity->SetParameter(3, 0.);
+
+  fTablesValid=kFALSE;
+}
+
+
+//_________________________________________________________________________
+Double_t AliTPCPIDResponse::EvalResponseFunction(Int_t responseIndex, const TSpline3* responseFunction, Double_t bg) const
+{
+  //
+  // Value of the response function at the given beta*gamma, from the table
+  // responseIndex (index of the function in fResponseFunctions) if the tables
+  // are used and bg is inside the spline limits
+  //
+  if (fUseResponseTables && responseIndex >= 0 && responseIndex < fgkNumberOfParticleSpecies*fgkNumberOfGainScenarios) {
+    if (!fTablesValid) BuildResponseTables();
+
+    const Int_t k = responseIndex;
+    if (fTableFunctions[k] == responseFunction && bg >= fTableXmin[k] && bg < fTableXmax[k]) {
+      // bg = m*2^e with 0.5 <= m < 1; fTableNBins[k] equal intervals from 2^(e-1) to 2^e
+      Int_t e = 0;
+      const Double_t u = (2.*std::frexp(bg, &e) - 1.) * fTableNBins[k];
+      const Int_t j = (Int_t)u;
+      const Double_t *v = fTableValues.GetArray() + fTableFirst[k] + (e - fTableEMin[k])*fTableNBins[k] + j;
+      return v[0] + (u - j)*(v[1] - v[0]);
+    }
+  }
+
+  return responseFunction->Eval(bg);
+}
+
+
+//_________________________________________________________________________
+Double_t AliTPCPIDResponse::EvalCorrectionFunction(Int_t iFunction, const TF1* function, Double_t x) const
+{
+  //
+  // Value of the multiplicity correction function iFunction (0: mean, 1: mean tanTheta,
+  // 2: sigma) at x, from its table if the tables are used and x is inside its range
+  //
+  if (fUseResponseTables) {
+    if (!fTablesValid) BuildResponseTables();
+
+    const Int_t k = fgkNumberOfParticleSpecies*fgkNumberOfGainScenarios + iFunction;
+    if (fTableFunctions[k] == function && x >= fTableXmin[k] && x < fTableXmax[k]) {
+      const Double_t u = (x - fTableXmin[k]) * fTableInvStep[k];
+      const Int_t j = TMath::Min((Int_t)u, fTableNBins[k] - 1);
+      const Double_t *v = fTableValues.GetArray() + fTableFirst[k] + j;
+      return v[0] + (u - j)*(v[1] - v[0]);
+    }
+  }
+
+  return function->Eval(x);
+}
+
+
+//_________________________________________________________________________
+void AliTPCPIDResponse::BuildResponseTables() const
+{
+  //
+  // Tabulate the response functions (splines) between their limits in beta*gamma,
+  // with fTableNBins equal intervals between consecutive powers of 2, and the
+  // multiplicity correction functions in their range with fTableNBins equal intervals.
+  // The number of intervals is doubled until the linear interpolation in the middle
+  // of each interval agrees with the function within fTablePrecision, relative to the
+  // value for the response functions and to the largest value for the corrections
+  //
+  const Int_t kNResponse = fgkNumberOfParticleSpecies*fgkNumberOfGainScenarios;
+  const Int_t kMaxBinsResponse = 1024;
+  const Int_t kMaxBinsCorrection = 65536;
+
+  TArrayD x, values;
+  Int_t nValues = 0;
+  fTableValues.Set(0);
+
+  for (Int_t k=0; k<fgkNumberOfResponseTables; k++) {
+    fTableFunctions[k]=0x0;
+    fTableFirst[k]=0;
+    fTableNBins[k]=0;
+    fTableEMin[k]=0;
+    fTableXmin[k]=0.;
+    fTableXmax[k]=0.;
+    fTableInvStep[k]=0.;
+
+    Double_t maxError = 0.;
+    Int_t nBins = 0;
+
+    if (k < kNResponse) {
+      const TSpline3* spline = 0x0;
+      if (k < fResponseFunctions.GetEntriesFast()) spline = dynamic_cast<const TSpline3*>(fResponseFunctions.UncheckedAt(k));
+      if (!spline) continue;
+
+      // the same spline is often used for several species (e.g. muons and pions),
+      // its table is then shared
+      Int_t kShared = 0;
+      while (kShared < k && fTableFunctions[kShared] != spline) kShared++;
+      if (kShared < k) {
+        fTableFunctions[k] = spline;
+        fTableFirst[k] = fTableFirst[kShared];
+        fTableNBins[k] = fTableNBins[kShared];
+        fTableEMin[k] = fTableEMin[kShared];
+        fTableXmin[k] = fTableXmin[kShared];
+        fTableXmax[k] = fTableXmax[kShared];
+        continue;
+      }
+
+      const Double_t xmin = spline->GetXmin(), xmax = spline->GetXmax();
+      if (!(xmin > 0. && xmax > xmin)) continue;
+
+      Int_t eMin = 0, eMax = 0;
+      std::frexp(xmin, &eMin);
+      std::frexp(xmax, &eMax);
+      const Int_t nOctaves = eMax - eMin + 1;
+
+      for (nBins=16; ; nBins*=2) {
+        const Int_t n = nOctaves*nBins + 1;
+        x.Set(n);
+        values.Set(n);
+        for (Int_t i=0; i<n; i++) {
+          x[i] = std::ldexp(1. + Double_t(i%nBins)/nBins, eMin + i/nBins - 1);
+          values[i] = spline->Eval(x[i]);
+        }
+
+        maxError = 0.;
+        for (Int_t i=0; i<n-1; i++) {
+          const Double_t xMiddle = 0.5*(x[i] + x[i+1]);
+          if (xMiddle < xmin || xMiddle >= xmax) continue;
+          const Double_t exact = spline->Eval(xMiddle);
+          const Double_t error = TMath::Abs(0.5*(values[i] + values[i+1]) - exact) / TMath::Max(TMath::Abs(exact), 1e-30);
+          if (error > maxError) maxError = error;
+        }
+        if (maxError <= fTablePrecision || nBins >= kMaxBinsResponse) break;
+      }
+
+      fTableFunctions[k] = spline;
+      fTableEMin[k] = eMin;
+      fTableXmin[k] = xmin;
+      fTableXmax[k] = xmax;
+    }
+    else {
+      const Int_t iFunction = k - kNResponse;
+      const TF1* function = (iFunction == 0) ? fCorrFuncMultiplicity :
+                            (iFunction == 1) ? fCorrFuncMultiplicityTanTheta : fCorrFuncSigmaMultiplicity;
+      if (!function) continue;
+
+      const Double_t xmin = function->GetXmin(), xmax = function->GetXmax();
+      if (!(xmax > xmin)) continue;
+
+      for (nBins=256; ; nBins*=2) {
+        const Double_t step = (xmax - xmin)/nBins;
+        values.Set(nBins + 1);
+        Double_t maxValue = 0.;
+        for (Int_t i=0; i<=nBins; i++) {
+          values[i] = function->Eval(xmin + i*step);
+          if (TMath::Abs(values[i]) > maxValue) maxValue = TMath::Abs(values[i]);
+        }
+
+        maxError = 0.;
+        for (Int_t i=0; i<nBins; i++) {
+          const Double_t exact = function->Eval(xmin + (i + 0.5)*step);
+          const Double_t error = TMath::Abs(0.5*(values[i] + values[i+1]) - exact);
+          if (error > maxError) maxError = error;
+        }
+        if (maxValue > 0.) maxError /= maxValue;
+        if (maxError <= fTablePrecision || nBins >= kMaxBinsCorrection) break;
+      }
+
+      fTableFunctions[k] = function;
+      fTableXmin[k] = xmin;
+      fTableXmax[k] = xmax;
+      fTableInvStep[k] = nBins/(xmax - xmin);
+    }
+
+    if (maxError > fTablePrecision)
+      AliWarning(Form("Table of %s: relative precision %g instead of %g", fTableFunctions[k]->GetName(), maxError, fTablePrecision));
+
+    fTableNBins[k] = nBins;
+    fTableFirst[k] = nValues;
+    fTableValues.Set(nValues + values.GetSize());
+    for (Int_t i=0; i<values.GetSize(); i++) fTableValues[nValues + i] = values[i];
+    nValues += values.GetSize();
+  }
+
+  AliInfo(Form("Response tables built, %d values", nValues));
+  fTablesValid = kTRUE;
 }
 
 
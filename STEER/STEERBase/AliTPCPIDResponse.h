@@ -19,6 +19,7 @@
 
 #include <TNamed.h>
 #include <TVectorF.h>
+#include <TArrayD.h>
 #include <TObjArray.h>
 #include <TF1.h>
 #include <TString.h>
@@ -55,6 +56,7 @@ public:
   static const Int_t fgkNumberOfParticleSpecies=AliPID::kSPECIESC;
   static const Int_t fgkNumberOfGainScenarios=3;
   static const Int_t fgkNumberOfdEdxSourceScenarios=3;
+  static const Int_t fgkNumberOfResponseTables=fgkNumberOfParticleSpecies*fgkNumberOfGainScenarios+3;
 
   enum ETPCdEdxSource {
     kdEdxDefault=0,        // use combined dEdx from IROC+OROC (assumes ideal detector)
@@ -81,7 +83,7 @@ public:
   void SetUseDatabase(Bool_t useDatabase) { fUseDatabase = useDatabase;}
   Bool_t GetUseDatabase() const { return fUseDatabase;}
   
-  void SetResponseFunction(AliPID::EParticleType type, TObject * const o) { fResponseFunctions.AddAt(o,(Int_t)type); }
+  void SetResponseFunction(AliPID::EParticleType type, TObject * const o) { fResponseFunctions.AddAt(o,(Int_t)type); fTablesValid=kFALSE; }
   const TObject * GetResponseFunction(AliPID::EParticleType type) const { return fResponseFunctions.At((Int_t)type); }
   void SetVoltage(Int_t n, Float_t v) {fVoltageMap[n]=v;}
   void SetVoltageMap(const TVectorF& a) {fVoltageMap=a;} //resets ownership, ~ will not delete contents
@@ -112,15 +114,15 @@ public:
   
   const TF1* GetMultiplicityCorrectionFunction() const  { return fCorrFuncMultiplicity; };
   void SetParameterMultiplicityCorrection(Int_t parIndex, Double_t parValue)  
-      { if (fCorrFuncMultiplicity) fCorrFuncMultiplicity->SetParameter(parIndex, parValue); };
+      { if (fCorrFuncMultiplicity) fCorrFuncMultiplicity->SetParameter(parIndex, parValue); fTablesValid=kFALSE; };
   
   const TF1* GetMultiplicityCorrectionFunctionTanTheta() const  { return fCorrFuncMultiplicityTanTheta; };
   void SetParameterMultiplicityCorrectionTanTheta(Int_t parIndex, Double_t parValue)  
-      { if (fCorrFuncMultiplicityTanTheta) fCorrFuncMultiplicityTanTheta->SetParameter(parIndex, parValue); };
+      { if (fCorrFuncMultiplicityTanTheta) fCorrFuncMultiplicityTanTheta->SetParameter(parIndex, parValue); fTablesValid=kFALSE; };
 
   const TF1* GetMultiplicitySigmaCorrectionFunction() const  { return fCorrFuncSigmaMultiplicity; };
   void SetParameterMultiplicitySigmaCorrection(Int_t parIndex, Double_t parValue)  
-      { if (fCorrFuncSigmaMultiplicity) fCorrFuncSigmaMultiplicity->SetParameter(parIndex, parValue); };
+      { if (fCorrFuncSigmaMultiplicity) fCorrFuncSigmaMultiplicity->SetParameter(parIndex, parValue); fTablesValid=kFALSE; };
   
   void ResetMultiplicityCorrectionFunctions(); 
   
@@ -144,7 +146,7 @@ public:
   Double_t GetMultiplicitySigmaCorrectionFast(Double_t dEdxExpected, Int_t multiplicity) const;
   
   Double_t GetSigmaPar1Fast(const AliVTrack *track, AliPID::EParticleType species,
-                            Double_t dEdx, const TSpline3* responseFunction) const;
+                            Double_t dEdx, const TSpline3* responseFunction, Int_t responseIndex=-1) const;
   
   //NEW
   void SetSigma(Float_t res0, Float_t resN2, ETPCgainScenario gainScenario );
@@ -201,6 +203,10 @@ public:
                      AliPID::EParticleType n=AliPID::kKaon) const;
   Double_t GetExpectedSigma(Float_t mom, Int_t nPoints,
                             AliPID::EParticleType n=AliPID::kKaon) const;
+  void     GetExpectedSignals(Int_t nTracks, const Float_t *mom,
+                              AliPID::EParticleType n, Double_t *signal) const;
+  void     GetExpectedSigmas(Int_t nTracks, const Int_t *nPoints,
+                             const Double_t *signal, Double_t *sigma) const;
   Float_t  GetNumberOfSigmas(Float_t mom, 
                              Float_t dEdx, 
 			     Int_t nPoints,
@@ -239,6 +245,14 @@ public:
 
   Double_t GetTrackdEdx(const AliVTrack* track) const;
 
+  //===| Tabulated response |===================================================
+  // Response functions (splines) and multiplicity correction functions
+  // evaluated by linear interpolation in tables, built when first needed
+  // with the given relative precision, instead of TSpline3/TF1::Eval
+  void SetUseResponseTables(Bool_t useTables, Double_t precision=1e-4)
+      { fUseResponseTables=useTables; fTablePrecision=precision; fTablesValid=kFALSE; }
+  Bool_t GetUseResponseTables() const { return fUseResponseTables; }
+
   //===| Initialisation |=======================================================
   Bool_t InitFromOADB(const Int_t run, const char* pass, const char* oadbFile="$ALICE_PHYSICS/OADB/COMMON/PID/data/TPCPIDResponseOADB.root", Bool_t initMultiplicityCorrection=kTRUE);
 
@@ -257,7 +271,8 @@ protected:
                              Double_t dEdx,
                              const TSpline3* responseFunction,
                              Bool_t correctEta,
-                             Bool_t correctMultiplicity) const; 
+                             Bool_t correctMultiplicity,
+                             Int_t responseIndex=-1) const; 
   
   Double_t GetExpectedSigma(const AliVTrack* track, 
                             AliPID::EParticleType species,
@@ -271,6 +286,10 @@ protected:
   // function for numberical debugging 0 registed splines can be used in the TFormula and tree visualizations
   //
 private:
+  Double_t EvalResponseFunction(Int_t responseIndex, const TSpline3* responseFunction, Double_t bg) const;
+  Double_t EvalCorrectionFunction(Int_t iFunction, const TF1* function, Double_t x) const;
+  void     BuildResponseTables() const;
+
   Float_t fMIP;          // dEdx for MIP
   Float_t fRes0[fgkNumberOfGainScenarios];  // relative dEdx resolution  rel sigma = fRes0*sqrt(1+fResN2/npoint)
   Float_t fResN2[fgkNumberOfGainScenarios]; // relative Npoint dependence rel  sigma = fRes0*sqrt(1+fResN2/npoint)
@@ -320,6 +339,21 @@ private:
   //
   static AliTPCPIDResponse*   fgInstance;     //! Instance of this class (singleton implementation)
   TObjArray                   fSplineArray;   //array of registered splines
+
+  // tables of the response and multiplicity correction functions: the response functions
+  // (index as in fResponseFunctions) on a grid in beta*gamma with a fixed number of intervals
+  // per factor 2, the 3 multiplicity correction functions on a uniform grid
+  Bool_t           fUseResponseTables; //! evaluate the response functions from the tables
+  Double_t         fTablePrecision;    //! required relative precision of the tables
+  mutable Bool_t   fTablesValid;       //! tables up to date with the functions
+  mutable const TObject* fTableFunctions[fgkNumberOfResponseTables]; //! tabulated functions, 0 if none
+  mutable Int_t    fTableFirst[fgkNumberOfResponseTables];   //! first value of each table in fTableValues
+  mutable Int_t    fTableNBins[fgkNumberOfResponseTables];   //! intervals per factor 2 (response) or in total (correction)
+  mutable Int_t    fTableEMin[fgkNumberOfResponseTables];    //! binary exponent of the first factor 2 of a response table
+  mutable Double_t fTableXmin[fgkNumberOfResponseTables];    //! lower limit of the table
+  mutable Double_t fTableXmax[fgkNumberOfResponseTables];    //! upper limit of the table
+  mutable Double_t fTableInvStep[fgkNumberOfResponseTables]; //! inverse of the interval of a correction table
+  mutable TArrayD  fTableValues;       //! values of all the tables, contiguous
   ClassDef(AliTPCPIDResponse,6)   // TPC PID class
 };
 
@@ -26,12 +26,15 @@
 //                                                                    //
 //--------------------------------------------------------------------//
 
+#include <algorithm>
+
 #include <Rtypes.h>
 #include <TROOT.h>
 
 #include <TClonesArray.h>
 #include <TObjArray.h>
 #include <TGeoManager.h>
+#include <TGeoMatrix.h>
 #include <TTree.h>
 
 #include "AliGeomManager.h"
@@ -66,6 +69,7 @@ AliTOFtrackerV2::AliTOFtrackerV2():
   fSeeds(new TObjArray(100)),
   fClustersESD(new TClonesArray("AliESDTOFCluster")),
   fHitsESD(new TClonesArray("AliESDTOFHit")),
+  fPadMatrices(0x0),
   fEvent(0),
   fNsteps(0)
 {
@@ -73,8 +77,13 @@ AliTOFtrackerV2::AliTOFtrackerV2():
   for (Int_t ii=0; ii<kMaxCluster; ii++){
     fClusters[ii]=0x0;
     fWrittenInPos[ii] = -1;
+    fBinnedClusters[ii] = -1;
+    fWindowClusters[ii] = -1;
   }
 
+  for (Int_t ii=0; ii<=kNClusterBins; ii++)
+    fClusterBinFirst[ii] = 0;
+
   for(Int_t isp=0;isp < AliPID::kSPECIESC;isp++)
     fTimesAr[isp] = NULL;
 
@@ -106,6 +115,10 @@ AliTOFtrackerV2::~AliTOFtrackerV2() {
     delete fHitsESD;
     fHitsESD=0x0;
   }
+  if (fPadMatrices){
+    delete fPadMatrices;
+    fPadMatrices=0x0;
+  }
 
   for(Int_t isp=0;isp < AliPID::kSPECIESC;isp++){
     if(fTimesAr[isp]) delete[] fTimesAr[isp];
@@ -358,9 +371,13 @@ void AliTOFtrackerV2::MatchTracks() {
 
   AliDebug(1,"++++++++++++++++++++++++++++++++++++++++++++++++++++++++++");
 
+  // Sort the clusters in phi bins, to look only at the bins of the window of each track
+  BinClusters();
+  const Double_t kBinWidth = 2.*TMath::Pi()/kNClusterBins;
+
   // Some init
   const Int_t kNclusterMax = 1000; // related to fN value
-  TGeoHMatrix global[kNclusterMax];
+  TGeoHMatrix *global[kNclusterMax];
   Int_t clind[kNclusterMax];
   Bool_t isClusterMatchable[kNclusterMax]; // true if track and cluster were already matched (set to false below upto nc < kNclusterMax)
 
@@ -410,38 +427,56 @@ void AliTOFtrackerV2::MatchTracks() {
     if (dphi*sensRadius> dyMax) dphi=dyMax/sensRadius;
 
 
-    // find the clusters in the window of the track
-    Int_t nc=0;
-    for (Int_t k=FindClusterIndex(z-dz); k<TOFClArr->GetEntriesFast(); k++) {
+    // find the clusters in the window of the track, in the phi bins
+    // overlapping the window; each bin is ordered in z like fClustersESD
+    Int_t binLo=(Int_t)TMath::Floor((phi-dphi+TMath::Pi())/kBinWidth);
+    Int_t binHi=(Int_t)TMath::Floor((phi+dphi+TMath::Pi())/kBinWidth);
+    if (binHi-binLo >= kNClusterBins) {
+      binLo=0;
+      binHi=kNClusterBins-1;
+    }
 
-      if (nc>=kNclusterMax) {
- 	AliWarning("No more matchable clusters can be stored! Please, increase the corresponding vectors size.");
- 	break;
-      }
+    Int_t nw=0;
+    for (Int_t ib=binLo; ib<=binHi; ib++) {
+      Int_t bin = ((ib%kNClusterBins)+kNClusterBins)%kNClusterBins;
+      Int_t last = fClusterBinFirst[bin+1];
+      for (Int_t j=FindClusterIndex(z-dz,fClusterBinFirst[bin],last); j<last; j++) {
+	Int_t k = fBinnedClusters[j];
+	AliESDTOFCluster *c=(AliESDTOFCluster *) TOFClArr->At(k);
+	if (c->GetZ() > z+dz) break;
+	if (!c->GetStatus()) {
+	  AliDebug(1,"Cluster in channel declared bad!");
+	  continue; // skip bad channels as declared in OCDB
+	}
 
-      AliESDTOFCluster *c=(AliESDTOFCluster *) TOFClArr->At(k);
-      if (c->GetZ() > z+dz) break;
-      if (!c->GetStatus()) {
-	AliDebug(1,"Cluster in channel declared bad!");
-	continue; // skip bad channels as declared in OCDB
-      }
 
+	Double_t dph=TMath::Abs(c->GetPhi()-phi);
+	if (dph>TMath::Pi()) dph-=2.*TMath::Pi();
+	if (TMath::Abs(dph)>dphi) continue;
 
-      Double_t dph=TMath::Abs(c->GetPhi()-phi);
-      if (dph>TMath::Pi()) dph-=2.*TMath::Pi();
-      if (TMath::Abs(dph)>dphi) continue;
+	Double_t yc=(c->GetPhi() - trackTOFin.GetAlpha())*c->GetR();
+	Double_t p[2]={yc, c->GetZ()};
+	Double_t cov2[3]= {dY*dY/12., 0., dZ*dZ/12.};
+	if (trackTOFin.AliExternalTrackParam::GetPredictedChi2(p,cov2) > maxChi2)continue;
 
-      Double_t yc=(c->GetPhi() - trackTOFin.GetAlpha())*c->GetR();
-      Double_t p[2]={yc, c->GetZ()};
-      Double_t cov2[3]= {dY*dY/12., 0., dZ*dZ/12.};
-      if (trackTOFin.AliExternalTrackParam::GetPredictedChi2(p,cov2) > maxChi2)continue;
+	fWindowClusters[nw++] = k;
+      }
+    }
 
-      clind[nc] = k;      
-      Char_t path[200];
-      Int_t ind[5]; AliTOFGeometry::GetVolumeIndices(c->GetTOFchannel(),ind);
-      AliTOFGeometry::GetVolumePath(ind,path);
-      gGeoManager->cd(path);
-      global[nc] = *gGeoManager->GetCurrentMatrix();
+    // keep the order of fClustersESD, as the matched clusters are written in this order
+    std::sort(fWindowClusters,fWindowClusters+nw);
+
+    if (nw>kNclusterMax) {
+      AliWarning("No more matchable clusters can be stored! Please, increase the corresponding vectors size.");
+      nw=kNclusterMax;
+    }
+
+    Int_t nc=0;
+    for (Int_t i=0; i<nw; i++) {
+      Int_t k = fWindowClusters[i];
+      AliESDTOFCluster *c=(AliESDTOFCluster *) TOFClArr->At(k);
+      clind[nc] = k;
+      global[nc] = GetPadMatrix(c->GetTOFchannel());
       nc++;
     }
 
@@ -528,7 +563,7 @@ void AliTOFtrackerV2::MatchTracks() {
 
       for (Int_t i=0; i<nc; i++) {
 
-	AliTOFGeometry::IsInsideThePad((TGeoHMatrix*)(&global[i]),ctrackPos,dist3d);
+	AliTOFGeometry::IsInsideThePad(global[i],ctrackPos,dist3d);
 
 	// check multiple hit cases
 	AliESDTOFCluster *cmatched=(AliESDTOFCluster *) TOFClArr->At(clind[i]);
@@ -700,24 +735,72 @@ void AliTOFtrackerV2::UnloadClusters() {
 }
 
 //_________________________________________________________________________
-Int_t AliTOFtrackerV2::FindClusterIndex(Double_t z) const {
+Int_t AliTOFtrackerV2::FindClusterIndex(Double_t z, Int_t first, Int_t last) const {
+  //--------------------------------------------------------------------
+  // This function returns the position in fBinnedClusters, between
+  // first and last (excluded), of the first cluster with z not below
+  // the given one, or last if there is none
+  //--------------------------------------------------------------------
+  TClonesArray* TOFClArr = fClustersESD; // use temporary array
+
+  Int_t b=first, e=last;
+  while (b<e) {
+    Int_t m=(b+e)/2;
+    if (z > ((AliESDTOFCluster *) TOFClArr->At(fBinnedClusters[m]))->GetZ()) b=m+1;
+    else e=m;
+  }
+  return b;
+}
+//_________________________________________________________________________
+void AliTOFtrackerV2::BinClusters() {
   //--------------------------------------------------------------------
-  // This function returns the index of the nearest cluster 
+  // This function sorts the clusters in kNClusterBins bins in phi,
+  // one per TOF sector; inside a bin they keep the order of
+  // fClustersESD, i.e. they are ordered in z
   //--------------------------------------------------------------------
-  TClonesArray* TOFClArr = fClustersESD;; // use temporary array
+  TClonesArray* TOFClArr = fClustersESD; // use temporary array
   Int_t n = TOFClArr->GetEntriesFast();
+  const Double_t kBinWidth = 2.*TMath::Pi()/kNClusterBins;
 
-  if (n==0) return 0;
-  if (z <= ((AliESDTOFCluster *) TOFClArr->At(0))->GetZ()) return 0;
-  if (z > ((AliESDTOFCluster *) TOFClArr->At(n-1))->GetZ()) return n;
-  Int_t b=0, e=n-1, m=(b+e)/2;
-  for (; b<e; m=(b+e)/2) {
-    if (z > ((AliESDTOFCluster *) TOFClArr->At(m))->GetZ()) b=m+1;
+  for (Int_t ib=0; ib<=kNClusterBins; ib++) fClusterBinFirst[ib]=0;
 
-    else e=m; 
+  for (Int_t k=0; k<n; k++) {
+    AliESDTOFCluster *c=(AliESDTOFCluster *) TOFClArr->At(k);
+    Int_t bin = (Int_t)TMath::Floor((c->GetPhi()+TMath::Pi())/kBinWidth);
+    bin = ((bin%kNClusterBins)+kNClusterBins)%kNClusterBins;
+    fWindowClusters[k] = bin; // used as temporary storage of the bin
+    fClusterBinFirst[bin+1]++;
   }
-  return m;
-} 
+
+  for (Int_t ib=0; ib<kNClusterBins; ib++) fClusterBinFirst[ib+1]+=fClusterBinFirst[ib];
+
+  Int_t binNext[kNClusterBins];
+  for (Int_t ib=0; ib<kNClusterBins; ib++) binNext[ib]=fClusterBinFirst[ib];
+  for (Int_t k=0; k<n; k++) fBinnedClusters[binNext[fWindowClusters[k]]++] = k;
+}
+//_________________________________________________________________________
+TGeoHMatrix *AliTOFtrackerV2::GetPadMatrix(Int_t channel) {
+  //--------------------------------------------------------------------
+  // This function returns the global matrix of the pad of the given
+  // TOF channel; the geometry is navigated only the first time
+  // the pad is used, then the matrix is kept
+  //--------------------------------------------------------------------
+  if (!fPadMatrices) {
+    fPadMatrices = new TObjArray(AliTOFGeometry::NSectors()*AliTOFGeometry::NPadXSector());
+    fPadMatrices->SetOwner();
+  }
+
+  TGeoHMatrix *mat = (TGeoHMatrix *) fPadMatrices->UncheckedAt(channel);
+  if (!mat) {
+    Char_t path[200];
+    Int_t ind[5]; AliTOFGeometry::GetVolumeIndices(channel,ind);
+    AliTOFGeometry::GetVolumePath(ind,path);
+    gGeoManager->cd(path);
+    mat = new TGeoHMatrix(*gGeoManager->GetCurrentMatrix());
+    fPadMatrices->AddAt(mat,channel);
+  }
+  return mat;
+}
 //_________________________________________________________________________
 Bool_t AliTOFtrackerV2::GetTrackPoint(Int_t index, AliTrackPoint& p) const
 {
@@ -23,6 +23,7 @@
 
 class TClonesArray;
 class TObjArray;
+class TGeoHMatrix;
 
 class AliESDEvent;
 class AliESDpid;
@@ -53,11 +54,14 @@ private:
  void MergeClusters(Int_t i,Int_t j);
 
  enum {kMaxCluster=77777}; //maximal number of the TOF clusters
+ enum {kNClusterBins=18};  //number of phi bins of the TOF clusters (one per sector)
 
  AliTOFtrackerV2(const AliTOFtrackerV2 &t); //Copy Ctor 
  AliTOFtrackerV2& operator=(const AliTOFtrackerV2 &source); // ass. op.
 
- Int_t FindClusterIndex(Double_t z) const; // Returns cluster index 
+ Int_t FindClusterIndex(Double_t z, Int_t first, Int_t last) const; // Returns cluster position in a phi bin
+ void  BinClusters(); // Sort the clusters in phi bins
+ TGeoHMatrix *GetPadMatrix(Int_t channel); // Global matrix of a TOF pad
  void  MatchTracks(); // Matching Algorithm 
  void  CollectESD(); // Select starting Set for Matching 
  Float_t CorrectTimeWalk(Float_t dist,Float_t tof) const; // Time Walk correction
@@ -75,6 +79,10 @@ private:
  TClonesArray     *fClustersESD;  //! base line for ESD clusters
  TClonesArray     *fHitsESD;       //! filter list of TOF hits for ESD
  Int_t            fWrittenInPos[kMaxCluster]; //! the position where the cluster is already written
+ Int_t            fClusterBinFirst[kNClusterBins+1]; //! first position in fBinnedClusters of each phi bin
+ Int_t            fBinnedClusters[kMaxCluster]; //! indices of the clusters ordered in phi bins, then in z
+ Int_t            fWindowClusters[kMaxCluster]; //! indices of the clusters in the window of the current track
+ TObjArray        *fPadMatrices;   //! global matrices of the TOF pads, by channel, filled when first used
  
  AliESDEvent      *fEvent;    //! pointer to the event
 
@@ -102,6 +102,7 @@ AliTRDSimParam::AliTRDSimParam()
   ,fPRFOn(kFALSE)
   ,fNTimeBins(0)
   ,fNTBoverwriteOCDB(kFALSE)
+  ,fNThreads(0)
 {
   //
   // Default constructor
@@ -206,6 +207,7 @@ AliTRDSimParam::AliTRDSimParam(const AliTRDSimParam &p)
   ,fPRFOn(p.fPRFOn)
   ,fNTimeBins(p.fNTimeBins)
   ,fNTBoverwriteOCDB(p.fNTBoverwriteOCDB)
+  ,fNThreads(p.fNThreads)
 {
   //
   // Copy constructor
@@ -261,6 +263,7 @@ AliTRDSimParam &AliTRDSimParam::operator=(const AliTRDSimParam &p)
   fPRFOn            = p.fPRFOn;
   fNTimeBins        = p.fNTimeBins;
   fNTBoverwriteOCDB = p.fNTBoverwriteOCDB;
+  fNThreads         = p.fNThreads;
 
   Int_t iBin = 0;
 
@@ -316,6 +319,7 @@ void AliTRDSimParam::Copy(TObject &p) const
   target->fPRFOn              = fPRFOn;
   target->fNTimeBins          = fNTimeBins;
   target->fNTBoverwriteOCDB   = fNTBoverwriteOCDB;
+  target->fNThreads           = fNThreads;
 
   if (target->fTRFsmp) {
     delete[] target->fTRFsmp;
@@ -47,6 +47,7 @@ class AliTRDSimParam : public TObject {
           void     SetPadResponse(Int_t prfOn = 1)           { fPRFOn             = prfOn;            }
           void     SetNTimeBins(Int_t ntb)                   { fNTimeBins         = ntb;              }
           void     SetNTBoverwriteOCDB(Bool_t over = kTRUE)  { fNTBoverwriteOCDB  = over;             }
+          void     SetNThreads(Int_t n)                      { fNThreads          = n;                }
 
           Float_t  GetGasGain() const                        { return fGasGain;                       }
           Float_t  GetNoise() const                          { return fNoise;                         }
@@ -60,6 +61,7 @@ class AliTRDSimParam : public TObject {
           Float_t  GetTimeCoupling() const                   { return fTimeCoupling;                  }
           Int_t    GetNTimeBins() const                      { return fNTimeBins;                     }
           Bool_t   GetNTBoverwriteOCDB() const               { return fNTBoverwriteOCDB;              }
+          Int_t    GetNThreads() const                       { return fNThreads;                      }
 
           Bool_t   DiffusionOn() const                       { return fDiffusionOn;                   }
           Bool_t   ElAttachOn() const                        { return fElAttachOn;                    } 
@@ -113,6 +115,8 @@ class AliTRDSimParam : public TObject {
           Int_t    fNTimeBins;         //  Number of time bins (only used it fNTBoverwriteOCDB = true)
           Bool_t   fNTBoverwriteOCDB;  //  Switch to overwrite number of time bins from PCDB
 
+          Int_t    fNThreads;          //  Number of threads for the chamber-parallel digitization
+
  private:
 
   // This is a singleton, constructor is private!  
@@ -122,7 +126,7 @@ class AliTRDSimParam : public TObject {
           void Init();
           void SampleTRF();
   
-  ClassDef(AliTRDSimParam,6)          // The TRD simulation parameters
+  ClassDef(AliTRDSimParam,7)          // The TRD simulation parameters
 
 };
 
@@ -628,6 +628,41 @@ AliTRDarrayDictionary *AliTRDdigitsManager::GetDictionary(Int_t det
   
 }
 
+//_____________________________________________________________________________
+Bool_t AliTRDdigitsManager::SwapArrays(Int_t det, AliTRDarrayADC *&digits
+                                     , AliTRDSignalIndex *&indexes)
+{
+  //
+  // Exchanges the ADC array and the signal index of one detector
+  // with the given ones, which receive the previous arrays.
+  // Used to hand over preallocated buffers without copying.
+  //
+
+  Int_t recoDet = fRawRec ? 0 : det;
+
+  if ((!fDigits) || (!fSignalIndexes) || fHasSDigits)
+    {
+      return kFALSE;
+    }
+
+  AliTRDarrayADC    *oldDigits  = (AliTRDarrayADC *)    fDigits->At(recoDet);
+  AliTRDSignalIndex *oldIndexes = (AliTRDSignalIndex *) fSignalIndexes->At(recoDet);
+  if ((!oldDigits) || (!oldIndexes))
+    {
+      return kFALSE;
+    }
+
+  fDigits->AddAt(digits,recoDet);
+  fSignalIndexes->AddAt(indexes,recoDet);
+  digits->SetNdet(det);
+
+  digits  = oldDigits;
+  indexes = oldIndexes;
+
+  return kTRUE;
+
+}
+
 //_____________________________________________________________________________
 Int_t AliTRDdigitsManager::GetTrack(Int_t track, const AliTRDdigit * const digit) const
 {
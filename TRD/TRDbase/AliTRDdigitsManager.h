@@ -68,6 +68,7 @@ class AliTRDdigitsManager : public TObject {
   void                        RemoveDictionaries(Int_t det);
   void                        RemoveIndexes(Int_t det);
   void                        ClearIndexes(Int_t det);
+  Bool_t                      SwapArrays(Int_t det, AliTRDarrayADC *&digits, AliTRDSignalIndex *&indexes);
   
   Int_t                       GetTrack(Int_t track, const AliTRDdigit * const digit) const;
   Short_t                     GetDigitAmp(Int_t row, Int_t col, Int_t time, Int_t det) const;
@@ -56,6 +56,7 @@ ClassImp(AliTRDmcmSim)
 Bool_t AliTRDmcmSim::fgApplyCut = kTRUE;
 Int_t  AliTRDmcmSim::fgAddBaseline = 0;
 Bool_t AliTRDmcmSim::fgStoreClusters = kFALSE;
+Bool_t AliTRDmcmSim::fgBatchFilter = kTRUE;
 
 const Int_t AliTRDmcmSim::fgkFormatIndex = std::ios_base::xalloc();
 
@@ -842,9 +843,14 @@ void AliTRDmcmSim::Filter()
   // outputs to fADCF.
 
   // Non-linearity filter not implemented.
-  FilterPedestal();
-  FilterGain();
-  FilterTail();
+  if (fgBatchFilter) {
+    FilterBatch();
+  }
+  else {
+    FilterPedestal();
+    FilterGain();
+    FilterTail();
+  }
   // Crosstalk filter not implemented.
 }
 
@@ -1081,6 +1087,122 @@ void AliTRDmcmSim::FilterTail()
   }
 }
 
+void AliTRDmcmSim::FilterBatch()
+{
+  //
+  // Apply pedestal, gain and tail filter in one pass over the data.
+  // The registers are read once per MCM. The timebins are processed
+  // one after the other, and for each of them all channels are run
+  // through the three filters, with the internal filter registers kept
+  // in local arrays over the channels. Each filter only depends on the
+  // history of its own channel, so the channel loop has no dependency
+  // between iterations and can be vectorized. The result is bit-exact
+  // with the sequence FilterPedestal(), FilterGain(), FilterTail() which
+  // is kept as reference implementation (s. SetBatchFilter()).
+  //
+
+  // pedestal filter
+  const UInt_t fpnp    = fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFPNP, fDetector, fRobPos, fMcmPos);
+  const UInt_t fptc    = fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFPTC, fDetector, fRobPos, fMcmPos);
+  const UInt_t fpby    = fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFPBY, fDetector, fRobPos, fMcmPos);
+  const UInt_t fpShift = fgkFPshifts[fptc];
+
+  // gain filter
+  const UInt_t fgby = fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFGBY, fDetector, fRobPos, fMcmPos);
+  const UInt_t fgta = fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFGTA, fDetector, fRobPos, fMcmPos);
+  const UInt_t fgtb = fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFGTB, fDetector, fRobPos, fMcmPos);
+
+  // tail filter
+  const UInt_t alphaLong   = 0x3ff & fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFTAL, fDetector, fRobPos, fMcmPos);
+  const UInt_t lambdaLong  = (1 << 10) | (1 << 9) | (fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFTLL, fDetector, fRobPos, fMcmPos) & 0x1FF);
+  const UInt_t lambdaShort = (0 << 10) | (1 << 9) | (fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFTLS, fDetector, fRobPos, fMcmPos) & 0x1FF);
+  const UInt_t ftby = (fTrapConfig->GetTrapReg(AliTRDtrapConfig::kFTBY, fDetector, fRobPos, fMcmPos) != 0) ? 1 : 0;
+
+  // per channel gain registers and internal filter registers
+  UInt_t fgfExtended[fgkNadcMcm];
+  UInt_t fga[fgkNadcMcm];
+  UInt_t pedAcc[fgkNadcMcm];
+  UInt_t gainCounterA[fgkNadcMcm];
+  UInt_t gainCounterB[fgkNadcMcm];
+  UInt_t tailLong[fgkNadcMcm];
+  UInt_t tailShort[fgkNadcMcm];
+
+  for (Int_t iAdc = 0; iAdc < fgkNadcMcm; iAdc++) {
+    fgfExtended[iAdc]  = 0x700 + (UShort_t) fTrapConfig->GetTrapReg(AliTRDtrapConfig::TrapReg_t(AliTRDtrapConfig::kFGF0 + iAdc), fDetector, fRobPos, fMcmPos);
+    fga[iAdc]          = (UShort_t) fTrapConfig->GetTrapReg(AliTRDtrapConfig::TrapReg_t(AliTRDtrapConfig::kFGA0 + iAdc), fDetector, fRobPos, fMcmPos);
+    pedAcc[iAdc]       = fPedAcc[iAdc];
+    gainCounterA[iAdc] = fGainCounterA[iAdc];
+    gainCounterB[iAdc] = fGainCounterB[iAdc];
+    tailLong[iAdc]     = fTailAmplLong[iAdc];
+    tailShort[iAdc]    = fTailAmplShort[iAdc];
+  }
+
+  // input and output of one timebin for all channels
+  UInt_t in[fgkNadcMcm];
+  UInt_t out[fgkNadcMcm];
+
+  for (Int_t iTimeBin = 0; iTimeBin < fNTimeBin; iTimeBin++) {
+    for (Int_t iAdc = 0; iAdc < fgkNadcMcm; iAdc++)
+      in[iAdc] = (UShort_t) fADCR[iAdc][iTimeBin];
+
+    // the pedestal accumulator is disabled in the drift time
+    const UInt_t pedUpdate = (iTimeBin == 0) ? 1 : 0;
+
+    for (Int_t iAdc = 0; iAdc < fgkNadcMcm; iAdc++) {
+      UInt_t value = in[iAdc];
+
+      // pedestal filter
+      UInt_t accumulatorShifted = (pedAcc[iAdc] >> fpShift) & 0x3FF;
+      UInt_t pedAccNew = (pedAcc[iAdc] + (value & 0x3FF) - accumulatorShifted) & 0x7FFFFFFF;
+      pedAcc[iAdc] = pedUpdate ? pedAccNew : pedAcc[iAdc];
+      UInt_t inpAdd = (value + fpnp) & 0xFFFF;
+      UInt_t diff = inpAdd - accumulatorShifted;
+      diff = (inpAdd <= accumulatorShifted) ? 0 : diff;
+      diff = (diff > 0xFFF) ? 0xFFF : diff;
+      value = (fpby == 0) ? value : diff;
+
+      // gain filter
+      value &= 0xFFF;
+      UInt_t corr = (value * fgfExtended[iAdc]) >> 11;
+      corr = (corr > 0xFFF) ? 0xFFF : corr;
+      corr = corr + fga[iAdc];
+      corr = (corr > 0xFFF) ? 0xFFF : corr;
+      UInt_t active = ((gainCounterA[iAdc] != 0x3FFFFFF) && (gainCounterB[iAdc] != 0x3FFFFFF)) ? 1 : 0;
+      UInt_t aboveB = (corr >= fgtb) ? 1 : 0;
+      UInt_t aboveA = (corr >= fgta) ? 1 : 0;
+      gainCounterB[iAdc] += active & aboveB;
+      gainCounterA[iAdc] += active & (aboveB ^ 1) & aboveA;
+      value = (fgby == 1) ? corr : value;
+
+      // tail filter
+      UInt_t inpVolt = value & 0xFFF;
+      UInt_t aQ = tailLong[iAdc] + tailShort[iAdc];
+      aQ = (aQ > 0xFFF) ? 0xFFF : aQ;
+      UInt_t aDiff = (inpVolt > aQ) ? inpVolt - aQ : 0;
+      UInt_t alInpv = (aDiff * alphaLong) >> 11;
+      UInt_t tmpLong = tailLong[iAdc] + alInpv;
+      tmpLong = (tmpLong > 0xFFF) ? 0xFFF : tmpLong;
+      tailLong[iAdc] = ((tmpLong * lambdaLong) >> 11) & 0xFFF;
+      UInt_t tmpShort = tailShort[iAdc] + (aDiff - alInpv);
+      tmpShort = (tmpShort > 0xFFF) ? 0xFFF : tmpShort;
+      tailShort[iAdc] = ((tmpShort * lambdaShort) >> 11) & 0xFFF;
+
+      out[iAdc] = ftby ? aDiff : value;
+    }
+
+    for (Int_t iAdc = 0; iAdc < fgkNadcMcm; iAdc++)
+      fADCF[iAdc][iTimeBin] = out[iAdc];
+  }
+
+  for (Int_t iAdc = 0; iAdc < fgkNadcMcm; iAdc++) {
+    fPedAcc[iAdc]        = pedAcc[iAdc];
+    fGainCounterA[iAdc]  = gainCounterA[iAdc];
+    fGainCounterB[iAdc]  = gainCounterB[iAdc];
+    fTailAmplLong[iAdc]  = tailLong[iAdc];
+    fTailAmplShort[iAdc] = tailShort[iAdc];
+  }
+}
+
 void AliTRDmcmSim::ZSMapping()
 {
   //
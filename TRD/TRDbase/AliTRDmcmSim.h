@@ -47,6 +47,8 @@ class AliTRDmcmSim : public TObject {
 	  // Get unfiltered ADC data
 	  Int_t     GetDataFiltered(Int_t iadc, Int_t timebin) const { return (fADCF[iadc][timebin] >> 2); }
 	  // Get filtered ADC data
+	  Int_t     GetDataFilteredInternal(Int_t iadc, Int_t timebin) const { return fADCF[iadc][timebin]; }
+	  // Get filtered ADC data including the additional digits of the internal representation
 
           void      SetData(Int_t iadc, const Int_t* const adc);           // Set ADC data with array
           void      SetData(Int_t iadc, Int_t it, Int_t adc); // Set ADC data
@@ -70,6 +72,9 @@ class AliTRDmcmSim : public TObject {
   static  void      SetStoreClusters(Bool_t storeClusters) { fgStoreClusters = storeClusters; }
   static  Bool_t    GetStoreClusters() { return fgStoreClusters; }
 
+  static  void      SetBatchFilter(Bool_t batchFilter) { fgBatchFilter = batchFilter; }
+  static  Bool_t    GetBatchFilter() { return fgBatchFilter; }
+
           Int_t     GetDetector() const  { return fDetector;  };     // Returns Chamber ID (0-539)
           Int_t     GetRobPos() const { return fRobPos; };           // Returns ROB position (0-7)
           Int_t     GetMcmPos() const { return fMcmPos; };           // Returns MCM position (0-17) (16,17 are mergers)
@@ -94,6 +99,7 @@ class AliTRDmcmSim : public TObject {
 	  void      FilterPedestal();                   // Apply pedestal filter
 	  void      FilterGain();                       // Apply gain filter
 	  void      FilterTail();                       // Apply tail filter
+	  void      FilterBatch();                      // Apply all filters to all channels in one pass
 
 	  // filter initialization (resets internal registers)
 	  void      FilterPedestalInit(Int_t baseline = 10);
@@ -170,6 +176,7 @@ class AliTRDmcmSim : public TObject {
  static const Int_t fgkAddDigits = 2;                   // additional digits used for internal representation of ADC data
 	                                                // all internal data as after data control block (i.e. 12 bit), s. TRAP manual
  static const Int_t fgkNCPU = 4;                        // Number of CPUs in the TRAP
+ static const Int_t fgkNadcMcm = 21;                    // Number of ADC channels per MCM (as AliTRDfeeParam::GetNadcMcm())
  static const Int_t fgkNHitsMC = 100;                   // maximum number of hits for which MC information is kept
 
  static const UShort_t fgkFPshifts[4];                  // shifts for pedestal filter
@@ -259,6 +266,8 @@ class AliTRDmcmSim : public TObject {
 
   static Bool_t fgStoreClusters;          // whether to store all clusters in the tracklets
 
+  static Bool_t fgBatchFilter;            // apply the filters with FilterBatch(), timebin by timebin over all channels
+
   ClassDef(AliTRDmcmSim,7)
 };
 
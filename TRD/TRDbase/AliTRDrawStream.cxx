@@ -40,6 +40,7 @@
 #include "AliLog.h"
 #include "AliRawReader.h"
 #include "AliTRDcalibDB.h"
+#include "AliTRDfeeParam.h"
 #include "AliTRDdigitsManager.h"
 #include "AliTRDdigitsParam.h"
 #include "AliTRDcalibDB.h"
@@ -54,6 +55,10 @@
 
 #include "AliTRDrawStream.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 ClassImp(AliTRDrawStream)
 
 // some static information
@@ -224,7 +229,14 @@ AliTRDrawStream::AliTRDrawStream(AliRawReader *rawReader) :
   fSignalIndex(0x0),
   fTracklets(0x0),
   fTracks(0x0),
-  fMarkers(0x0)
+  fMarkers(0x0),
+  fNThreads(1),
+  fChambers(),
+  fNChambers(0),
+  fNextChamber(0),
+  fCurrChamber(0x0),
+  fWorkers(0x0),
+  fNWorkers(0)
 {
   // default constructor
 
@@ -289,6 +301,18 @@ AliTRDrawStream::~AliTRDrawStream()
   delete [] fCurrLinkMonitorFlags;
   delete [] fCurrLinkDataTypeFlags;
   delete [] fCurrLinkDebugFlags;
+
+  for (Int_t iWorker = 0; iWorker < fNWorkers; iWorker++) {
+    delete fWorkers[iWorker]->fTracklets;
+    delete fWorkers[iWorker]->fMarkers;
+    delete fWorkers[iWorker];
+  }
+  delete [] fWorkers;
+
+  for (Int_t iChamber = 0; iChamber < 30; iChamber++) {
+    delete fChambers[iChamber].fAdcArray;
+    delete fChambers[iChamber].fSignalIndex;
+  }
 }
 
 Bool_t AliTRDrawStream::ReadEvent()
@@ -459,6 +483,19 @@ Int_t AliTRDrawStream::NextChamber(AliTRDdigitsManager *digMgr)
     return -1;
   }
 
+#ifndef TRD_RAW_DEBUG
+  if (fNThreads > 1)
+    return NextChamberParallel();
+#endif
+
+  return ReadNextChamber();
+}
+
+
+Int_t AliTRDrawStream::ReadNextChamber()
+{
+  // read the data for the next chamber from the current reading position
+
   while (fCurrSlot < 0 || fCurrSlot >= fgkNstacks) {
     if (!NextDDL()) {
       fCurrSlot = -1;
@@ -540,6 +577,331 @@ Int_t AliTRDrawStream::NextChamber(AliTRDdigitsManager *digMgr)
 }
 
 
+Int_t AliTRDrawStream::NextChamberParallel()
+{
+  // return the next chamber of the current DDL,
+  // once all are handed out the next DDL is indexed
+  // and its chambers are decoded in parallel
+  // (switching between serial and parallel reading
+  // is only possible at the beginning of an event)
+
+  while (fNextChamber >= fNChambers) {
+    if (!NextDDL()) {
+      fCurrSlot = -1;
+      fNChambers = 0;
+      fNextChamber = 0;
+      return -1;
+    }
+    IndexDDL();
+    DecodeDDL();
+  }
+
+  return HandOutChamber(fNextChamber++);
+}
+
+
+Int_t AliTRDrawStream::IndexDDL()
+{
+  // fast scan of the current DDL for the start of the data of all
+  // active half-chambers, only the endmarkers and HC headers are looked at
+  // returns the number of chambers found
+
+  fNChambers = 0;
+  fNextChamber = 0;
+
+  for (Int_t iStack = 0; iStack < fgkNstacks; iStack++) {
+    fCurrSlot = iStack;
+    if ((fCurrStackMask & (1 << fCurrSlot)) == 0)
+      continue;
+
+    for (Int_t iLink = 0; iLink < fgkNlinks; iLink++) {
+      fCurrLink = iLink;
+      if ((fCurrLinkMask[fCurrSlot] & (1 << fCurrLink)) == 0)
+	continue;
+
+      // both HCs of a chamber go into the same buffer
+      ChamberBuffer_t *chamber = (fNChambers > 0) ? &fChambers[fNChambers-1] : 0x0;
+      if (!chamber || (chamber->fSlot != iStack) || (chamber->fLayer != iLink / 2)) {
+	chamber = &fChambers[fNChambers++];
+	chamber->fSlot    = iStack;
+	chamber->fLayer   = iLink / 2;
+	chamber->fNLinks  = 0;
+	chamber->fSerial  = kFALSE;
+	chamber->fHasData = kFALSE;
+	chamber->fDet     = -1;
+	chamber->fWorker  = -1;
+      }
+      chamber->fLink[chamber->fNLinks]  = iLink;
+      chamber->fStart[chamber->fNLinks] = fPayloadCurr;
+      chamber->fNLinks++;
+
+      // configuration and test pattern data are not decoded in parallel
+      UInt_t *hcHeader = fPayloadCurr;
+      if (fCurrTrackletEnable) {
+	while ((hcHeader - fPayloadStart < fPayloadSize - 1) &&
+	       (*hcHeader != fgkTrackletEndmarker) &&
+	       (*hcHeader != fgkStackEndmarker[0]) &&
+	       (*hcHeader != fgkStackEndmarker[1]))
+	  hcHeader++;
+	while ((hcHeader - fPayloadStart < fPayloadSize - 1) &&
+	       (*hcHeader == fgkTrackletEndmarker))
+	  hcHeader++;
+      }
+      if ((hcHeader - fPayloadStart < fPayloadSize) &&
+	  (*hcHeader != fgkDataEndmarker) &&
+	  ((*hcHeader >> 24) & 0x40))
+	chamber->fSerial = kTRUE;
+
+      SeekNextLink();
+    }
+
+    SeekNextStack();
+  }
+
+  // the DDL is consumed
+  fCurrSlot = fgkNstacks;
+  fCurrLink = 0;
+
+  return fNChambers;
+}
+
+
+void AliTRDrawStream::DecodeDDL()
+{
+  // decode the indexed chambers of the current DDL,
+  // the chambers are distributed over the workers and
+  // their output is merged in the original order afterwards
+
+  SetupWorkers();
+
+  // prepare the pooled buffers, arrays which came from the digits
+  // manager may be compressed, all others are cleared like in
+  // AliTRDdigitsManager::ClearArrays()
+  const Int_t nChannels = 144 / AliTRDfeeParam::GetNcolMcm() * AliTRDfeeParam::GetNadcMcm();
+  for (Int_t iChamber = 0; iChamber < fNChambers; iChamber++) {
+    ChamberBuffer_t &chamber = fChambers[iChamber];
+    if (!chamber.fAdcArray)
+      chamber.fAdcArray = new AliTRDarrayADC();
+    if (!chamber.fSignalIndex)
+      chamber.fSignalIndex = new AliTRDSignalIndex();
+
+    AliTRDarrayADC *adcArray = chamber.fAdcArray;
+    if ((adcArray->GetNtime() > 0) &&
+	(adcArray->GetDim() != 16 * nChannels * adcArray->GetNtime()))
+      adcArray->Allocate(16, 144, adcArray->GetNtime());
+    else if (chamber.fSignalIndex->IsAllocated())
+      adcArray->ConditionalReset(chamber.fSignalIndex);
+    if (chamber.fSignalIndex->IsAllocated())
+      chamber.fSignalIndex->ResetContent();
+    adcArray->SetDataValid();
+  }
+
+  // configuration data is fed to the global TRAP config,
+  // these chambers are decoded in order by the first worker
+  for (Int_t iChamber = 0; iChamber < fNChambers; iChamber++) {
+    if (fChambers[iChamber].fSerial)
+      DecodeChamber(iChamber, 0);
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(fNWorkers) schedule(dynamic)
+#endif
+  for (Int_t iChamber = 0; iChamber < fNChambers; iChamber++) {
+    if (fChambers[iChamber].fSerial)
+      continue;
+#ifdef _OPENMP
+    DecodeChamber(iChamber, omp_get_thread_num());
+#else
+    DecodeChamber(iChamber, 0);
+#endif
+  }
+
+  // merge tracklets, markers and errors in the order of the chambers
+  for (Int_t iChamber = 0; iChamber < fNChambers; iChamber++) {
+    ChamberBuffer_t &chamber = fChambers[iChamber];
+    AliTRDrawStream *worker = fWorkers[chamber.fWorker];
+
+    if (fTracklets) {
+      for (Int_t iTracklet = chamber.fFirstTracklet; iTracklet < chamber.fLastTracklet; iTracklet++)
+	new ((*fTracklets)[fTracklets->GetEntriesFast()])
+	  AliTRDtrackletWord(*((AliTRDtrackletWord*) (*worker->fTracklets)[iTracklet]));
+    }
+
+    for (Int_t iMarker = chamber.fFirstMarker; iMarker < chamber.fLastMarker; iMarker++) {
+      AliTRDrawStreamError *marker = (AliTRDrawStreamError*) (*worker->fMarkers)[iMarker];
+      if (marker->fError < 0) {
+	if (fMarkers)
+	  new ((*fMarkers)[fMarkers->GetEntriesFast()]) AliTRDrawStreamError(*marker);
+      }
+      else {
+	fLastError = *marker;
+	(this->*fStoreError)();
+      }
+    }
+
+    if (chamber.fHasData)
+      fNtimebins = chamber.fNtimebins;
+  }
+
+  // merge the statistics
+  for (Int_t iWorker = 0; iWorker < fNWorkers; iWorker++) {
+    AliTRDrawStream *worker = fWorkers[iWorker];
+    worker->fTracklets->Clear();
+    worker->fMarkers->Clear();
+
+    for (Int_t iSector = 0; iSector < fgkNsectors; iSector++) {
+      AliTRDrawStats::AliTRDrawStatsSector &sector       = fStats.fStatsSector[iSector];
+      AliTRDrawStats::AliTRDrawStatsSector &workerSector = worker->fStats.fStatsSector[iSector];
+      sector.fBytesRead  += workerSector.fBytesRead;
+      sector.fNTracklets += workerSector.fNTracklets;
+      sector.fNMCMs      += workerSector.fNMCMs;
+      sector.fNChannels  += workerSector.fNChannels;
+      for (Int_t iHC = 0; iHC < 60; iHC++) {
+	sector.fStatsHC[iHC].fBytes      += workerSector.fStatsHC[iHC].fBytes;
+	sector.fStatsHC[iHC].fBytesRead  += workerSector.fStatsHC[iHC].fBytesRead;
+	sector.fStatsHC[iHC].fNTracklets += workerSector.fStatsHC[iHC].fNTracklets;
+	sector.fStatsHC[iHC].fNMCMs      += workerSector.fStatsHC[iHC].fNMCMs;
+	sector.fStatsHC[iHC].fNChannels  += workerSector.fStatsHC[iHC].fNChannels;
+      }
+    }
+    fStats.fBytesRead += worker->fStats.fBytesRead;
+    worker->fStats.ClearStats();
+  }
+}
+
+
+void AliTRDrawStream::DecodeChamber(Int_t iChamber, Int_t iWorker)
+{
+  // decode the links of one chamber with the given worker,
+  // may run concurrently for different chambers and workers
+
+  ChamberBuffer_t &chamber = fChambers[iChamber];
+  AliTRDrawStream *worker = fWorkers[iWorker];
+
+  chamber.fWorker        = iWorker;
+  chamber.fFirstTracklet = worker->fTracklets->GetEntriesFast();
+  chamber.fFirstMarker   = worker->fMarkers->GetEntriesFast();
+
+  worker->fCurrChamber = &chamber;
+  worker->fAdcArray    = 0x0;
+  worker->fSignalIndex = 0x0;
+  worker->fErrorFlags  = 0;
+  worker->fCurrSlot    = chamber.fSlot;
+
+  for (Int_t iLink = 0; iLink < chamber.fNLinks; iLink++) {
+    worker->fCurrLink    = chamber.fLink[iLink];
+    worker->fCurrHC      = (fCurrEquipmentId - kDDLOffset) * fgkNstacks * fgkNlinks +
+      chamber.fSlot * fgkNlinks + chamber.fLink[iLink];
+    worker->fPayloadCurr = chamber.fStart[iLink];
+
+    if (fCurrLinkMonitorFlags[(((fCurrEquipmentId - kDDLOffset) * fgkNstacks) + chamber.fSlot) * fgkNlinks + chamber.fLink[iLink]] != 0) {
+      worker->LinkError(kLinkMonitor);
+      if (fgErrorBehav[kLinkMonitor] == kTolerate)
+	worker->ReadLinkData();
+    }
+    else
+      worker->ReadLinkData();
+  }
+
+  worker->fCurrChamber = 0x0;
+
+  chamber.fLastTracklet = worker->fTracklets->GetEntriesFast();
+  chamber.fLastMarker   = worker->fMarkers->GetEntriesFast();
+
+  // chamber information from HC if it is valid
+  // otherwise from the link position
+  if (worker->fCurrSm < 0 || worker->fCurrSm >= fgkNsectors ||
+      worker->fCurrStack < 0 || worker->fCurrStack >= fgkNstacks ||
+      worker->fCurrLayer < 0 || worker->fCurrLayer >= fgkNlinks/2)
+    chamber.fDet = (fCurrEquipmentId-kDDLOffset) * fgkNstacks*fgkNlinks/2 + chamber.fSlot * fgkNlinks/2 + chamber.fLayer;
+  else
+    chamber.fDet = worker->fCurrSm * fgkNstacks*fgkNlinks/2 + worker->fCurrStack * fgkNlinks/2 + worker->fCurrLayer;
+}
+
+
+Int_t AliTRDrawStream::HandOutChamber(Int_t iChamber)
+{
+  // pass the data of a decoded chamber to the digits manager,
+  // the buffers are exchanged and the previous arrays of the
+  // digits manager go to the pool for reuse
+
+  ChamberBuffer_t &chamber = fChambers[iChamber];
+  Int_t det = chamber.fDet;
+
+  fCurrSlot = chamber.fSlot;
+  fCurrLink = chamber.fLink[0];
+
+  if (chamber.fHasData && fDigitsManager) {
+    if (!fDigitsManager->SwapArrays(det, chamber.fAdcArray, chamber.fSignalIndex))
+      LinkError(kNoDigits);
+
+    if (!fDigitsParam) {
+      fDigitsParam = fDigitsManager->GetDigitsParam();
+    }
+    if (fDigitsParam) {
+      fDigitsParam->SetPretriggerPhase(det, chamber.fPtrgPhase);
+      fDigitsParam->SetNTimeBins(det, chamber.fNtimebins);
+      fDigitsParam->SetADCbaseline(det, 10);
+    }
+
+    if (fDigitsManager->UsesDictionaries()) {
+      fDigitsManager->GetDictionary(det, 0)->Reset();
+      fDigitsManager->GetDictionary(det, 1)->Reset();
+      fDigitsManager->GetDictionary(det, 2)->Reset();
+    }
+  }
+
+  // keep the DDL marked as consumed
+  fCurrSlot = fgkNstacks;
+  fCurrLink = 0;
+
+  return det;
+}
+
+
+void AliTRDrawStream::SetupWorkers()
+{
+  // create one decoder per thread and pass the
+  // information of the current DDL to them
+
+  if (fNWorkers != TMath::Max(fNThreads, 1)) {
+    for (Int_t iWorker = 0; iWorker < fNWorkers; iWorker++) {
+      delete fWorkers[iWorker]->fTracklets;
+      delete fWorkers[iWorker]->fMarkers;
+      delete fWorkers[iWorker];
+    }
+    delete [] fWorkers;
+
+    fNWorkers = TMath::Max(fNThreads, 1);
+    fWorkers = new AliTRDrawStream*[fNWorkers];
+    for (Int_t iWorker = 0; iWorker < fNWorkers; iWorker++) {
+      AliTRDrawStream *worker = new AliTRDrawStream();
+      worker->fTracklets = new TClonesArray("AliTRDtrackletWord", 256);
+      worker->fMarkers   = new TClonesArray("AliTRDrawStreamError", 64);
+      worker->StoreErrorsInArray();
+      fWorkers[iWorker] = worker;
+    }
+
+    // the tracklet words share a geometry created on first use,
+    // make sure it exists before the threads start
+    AliTRDtrackletWord trackletWord(0);
+  }
+
+  for (Int_t iWorker = 0; iWorker < fNWorkers; iWorker++) {
+    AliTRDrawStream *worker = fWorkers[iWorker];
+    worker->fRawReader          = fRawReader;
+    worker->fPayloadStart       = fPayloadStart;
+    worker->fPayloadSize        = fPayloadSize;
+    worker->fCurrEquipmentId    = fCurrEquipmentId;
+    worker->fCurrTrackletEnable = fCurrTrackletEnable;
+    worker->fNtimebins          = fNtimebins;
+    worker->fNDumpMCMs          = fNDumpMCMs;
+    for (Int_t iDump = 0; iDump < fNDumpMCMs; iDump++)
+      worker->fDumpMCM[iDump] = fDumpMCM[iDump];
+  }
+}
+
+
 Int_t AliTRDrawStream::ReadGTUHeaders(UInt_t *buffer)
 {
   // check the data source and read the headers
@@ -1294,6 +1656,34 @@ Int_t AliTRDrawStream::ReadLinkData()
 	count += ReadTPData(tpmode);
       }
     }
+    else if (fCurrChamber) {
+      // reading real data into the pooled buffers of the chamber,
+      // they are handed over to the digits manager by NextChamber
+      fAdcArray = fCurrChamber->fAdcArray;
+      if (fAdcArray->GetNtime() != fCurrNtimebins)
+	fAdcArray->Allocate(16, 144, fCurrNtimebins);
+
+      fSignalIndex = fCurrChamber->fSignalIndex;
+      fSignalIndex->SetSM(fCurrSm);
+      fSignalIndex->SetStack(fCurrStack);
+      fSignalIndex->SetLayer(fCurrLayer);
+      fSignalIndex->SetDetNumber(det);
+      if (!fSignalIndex->IsAllocated())
+	fSignalIndex->Allocate(16, 144, fCurrNtimebins);
+
+      fCurrChamber->fHasData   = kTRUE;
+      fCurrChamber->fNtimebins = fCurrNtimebins;
+      fCurrChamber->fPtrgPhase = fCurrPtrgPhase;
+
+      if (fCurrMajor & 0x20) {
+	AliDebug(1, "This is a zs event");
+	count += ReadZSData();
+      }
+      else {
+	AliDebug(1, "This is a nozs event");
+	count += ReadNonZSData();
+      }
+    }
     else {
       // reading real data
       if (fDigitsManager) {
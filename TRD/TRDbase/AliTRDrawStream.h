@@ -56,6 +56,10 @@ class AliTRDrawStream : public TObject
   Int_t NextChamber(AliTRDdigitsManager *digMgr,
   		      UInt_t ** /* trackletContainer */, UShort_t ** /* errorContainer */) { AliError("Deprecated, use NextChamber(AliTRDdigitsManger*) instead!"); return NextChamber(digMgr); }
 
+  // decode the half-chambers of a DDL in parallel (if > 1)
+  void  SetNThreads(Int_t nThreads) { fNThreads = nThreads; }
+  Int_t GetNThreads() const { return fNThreads; }
+
   void StoreErrorsInTree()   { fStoreError = &AliTRDrawStream::StoreErrorTree; }
   void StoreErrorsInArray()  { fStoreError = &AliTRDrawStream::StoreErrorArray; }
   void EnableErrorStorage()  { fStoreError = &AliTRDrawStream::StoreErrorTree; }
@@ -234,6 +238,15 @@ class AliTRDrawStream : public TObject
   Int_t SeekNextStack();
   Int_t SeekNextLink();
 
+  // chamber-parallel decoding
+  Int_t ReadNextChamber();
+  Int_t NextChamberParallel();
+  Int_t IndexDDL();
+  void  DecodeDDL();
+  void  DecodeChamber(Int_t iChamber, Int_t iWorker);
+  Int_t HandOutChamber(Int_t iChamber);
+  void  SetupWorkers();
+
   // MCM header decoding
   Int_t ROB(UInt_t mcmhdr) const { return 0x7 & mcmhdr >> 28; }
   Int_t MCM(UInt_t mcmhdr) const { return 0xf & mcmhdr >> 24; }
@@ -391,6 +404,39 @@ class AliTRDrawStream : public TObject
   TClonesArray *fTracks;			// pointer to array of GTU tracks
   TClonesArray *fMarkers;			// pointer to array of markers (data present, errors, ...)
 
+  // chamber-parallel decoding
+  struct ChamberBuffer_t {                      // one chamber of the current DDL
+    ChamberBuffer_t() : fSlot(-1), fLayer(-1), fNLinks(0), fSerial(kFALSE), fDet(-1), fWorker(-1),
+      fFirstTracklet(0), fLastTracklet(0), fFirstMarker(0), fLastMarker(0),
+      fHasData(kFALSE), fNtimebins(-1), fPtrgPhase(-1), fAdcArray(0x0), fSignalIndex(0x0)
+      { fLink[0] = fLink[1] = -1; fStart[0] = fStart[1] = 0x0; }
+    Int_t   fSlot;                              // stack slot
+    Int_t   fLayer;                             // layer from link position
+    Int_t   fNLinks;                            // number of active links (HCs)
+    Int_t   fLink[2];                           // active links
+    UInt_t *fStart[2];                          // start of the link data in the payload
+    Bool_t  fSerial;                            // decode outside of the parallel section (config, test pattern)
+    Int_t   fDet;                               // detector number returned by NextChamber
+    Int_t   fWorker;                            // worker which decoded the chamber
+    Int_t   fFirstTracklet;                     // tracklets of this chamber in the worker output
+    Int_t   fLastTracklet;                      //
+    Int_t   fFirstMarker;                       // markers and errors of this chamber in the worker output
+    Int_t   fLastMarker;                        //
+    Bool_t  fHasData;                           // ADC data was decoded
+    Int_t   fNtimebins;                         // number of timebins from the HC header
+    Int_t   fPtrgPhase;                         // pretrigger phase from the HC header
+    AliTRDarrayADC    *fAdcArray;               // pooled ADC array, reused across events
+    AliTRDSignalIndex *fSignalIndex;            // pooled signal index, reused across events
+  };
+
+  Int_t fNThreads;                              //! number of threads for the chamber-parallel decoding
+  ChamberBuffer_t fChambers[30];                //! chambers of the current DDL
+  Int_t fNChambers;                             //! number of chambers indexed in the current DDL
+  Int_t fNextChamber;                           //! next chamber to be returned by NextChamber
+  ChamberBuffer_t *fCurrChamber;                //! chamber being decoded by this worker
+  AliTRDrawStream **fWorkers;                   //! decoders used by the threads
+  Int_t fNWorkers;                              //! number of decoders
+
   AliTRDrawStream(const AliTRDrawStream&);           // not implemented
   AliTRDrawStream& operator=(const AliTRDrawStream&); // not implemented
 
@@ -34,13 +34,24 @@
 //      - Digitization                                                    //
 //      - Zero suppression                                                //
 //                                                                        //
+//  With AliTRDSimParam::SetNThreads(n), n > 1, the conversion to ADC     //
+//  values and the TRAP simulation of the chambers are distributed over   //
+//  n OpenMP threads (see DigitizeChambers()).                            //
+//                                                                        //
 ////////////////////////////////////////////////////////////////////////////
 
 #include <TGeoManager.h>
 #include <TList.h>
 #include <TMath.h>
-#include <TRandom.h>
+#include <TRandom3.h>
 #include <TTree.h>
+#include <TObjArray.h>
+#include <TClonesArray.h>
+#include <TBranch.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "AliRun.h"
 #include "AliMC.h"
@@ -66,6 +77,7 @@
 #include "AliTRDCommonParam.h"
 #include "AliTRDfeeParam.h"
 #include "AliTRDmcmSim.h"
+#include "AliTRDtrackletMCM.h"
 #include "AliTRDdigitsParam.h"
 
 #include "AliTRDCalROC.h"
@@ -657,6 +669,14 @@ Bool_t AliTRDdigitizer::MakeDigits()
     return kFALSE;
   }
 
+  // Chamber-parallel digitization
+  if ((AliTRDSimParam::Instance()->GetNThreads() > 1) && (!fSDigits)) {
+    Bool_t status = MakeDigitsParallel(hits,nhit);
+    delete [] hits;
+    delete [] nhit;
+    return status;
+  }
+
   // Loop through all detectors
   for (Int_t det = 0; det < kNdet; det++) {
 
@@ -712,6 +732,256 @@ Bool_t AliTRDdigitizer::MakeDigits()
 
 }
 
+//_____________________________________________________________________________
+Bool_t AliTRDdigitizer::MakeDigitsParallel(Float_t **hits, const Int_t *nhit)
+{
+  //
+  // Creates digits with the chambers distributed over several threads.
+  // The hits are converted serially in chamber order, since AliTRDCommonParam
+  // caches the diffusion and time structure for the last drift velocity.
+  // The signals are kept compressed until DigitizeChambers() converts them
+  // to ADC values and runs the TRAP simulation in parallel.
+  // Deletes the hits arrays.
+  //
+
+  AliTRDcalibDB *calibration = AliTRDcalibDB::Instance();
+
+  const Int_t kNdet = AliTRDgeometry::Ndet();
+
+  Int_t              *dets    = new Int_t[kNdet];
+  AliTRDarraySignal **signals = new AliTRDarraySignal*[kNdet];
+  Int_t               ndet    = 0;
+  Bool_t              status  = kTRUE;
+
+  for (Int_t det = 0; det < kNdet; det++) {
+
+    // Detectors that are switched off, not installed, etc.
+    if ((status)                                &&
+        (!calibration->IsChamberNoData(det))    &&
+        ( fGeo->ChamberInGeometry(det))         &&
+        (nhit[det] > 0)) {
+
+      signals[ndet] = new AliTRDarraySignal();
+
+      // Convert the hits of the current detector to detector signals
+      if (ConvertHits(det,hits[det],nhit[det],signals[ndet])) {
+        signals[ndet]->Compress(0);
+        dets[ndet++] = det;
+      }
+      else {
+        AliError(Form("Conversion of hits failed for detector=%d",det));
+        delete signals[ndet];
+        status = kFALSE;
+      }
+
+    } // if: detector status
+
+    delete [] hits[det];
+
+  } // for: detector
+
+  if (status) {
+    status = DigitizeChambers(ndet,dets,signals);
+  }
+
+  for (Int_t i = 0; i < ndet; i++) {
+    delete signals[i];
+  }
+  delete [] signals;
+  delete [] dets;
+
+  if (AliDataLoader *trklLoader 
+        = AliRunLoader::Instance()->GetLoader("TRDLoader")->GetDataLoader("tracklets")) {
+    if (trklLoader->Tree())
+      trklLoader->WriteData("OVERWRITE");
+  }
+
+  return status;
+
+}
+
+//_____________________________________________________________________________
+Bool_t AliTRDdigitizer::DigitizeChambers(Int_t ndet, const Int_t *dets
+                                       , AliTRDarraySignal **signals)
+{
+  //
+  // Converts the signals of the chambers <dets> to ADC values and runs the
+  // TRAP simulation, using AliTRDSimParam::GetNThreads() threads with one
+  // AliTRDmcmSim each. Without <signals> the merged s-digits are converted
+  // and their dictionaries copied, as in ConvertSDigits().
+  //
+  // The noise of each chamber comes from its own generator, seeded from
+  // gRandom in chamber order, and the tracklets are stored in chamber
+  // order afterwards, so that the output does not depend on the number
+  // of threads.
+  //
+
+  if (ndet <= 0) {
+    return kTRUE;
+  }
+
+  Int_t nThreads = TMath::Max(1,AliTRDSimParam::Instance()->GetNThreads());
+#ifndef _OPENMP
+  static Bool_t warned = kFALSE;
+  if ((nThreads > 1) && (!warned)) {
+    AliWarning("Compiled without OpenMP support, the chambers are processed serially");
+    warned = kTRUE;
+  }
+  nThreads = 1;
+#endif
+  nThreads = TMath::Min(nThreads,ndet);
+
+  Bool_t      storeTracklets = AliTRDfeeParam::Instance()->GetTracklet();
+  UInt_t     *seeds          = new UInt_t[ndet];
+  Bool_t     *status         = new Bool_t[ndet];
+  TObjArray **tracklets      = new TObjArray*[ndet];
+  for (Int_t i = 0; i < ndet; i++) {
+    // Seed 0 would make TRandom3 take its seed from the clock
+    seeds[i]     = gRandom->Integer(kMaxInt) + 1;
+    status[i]    = kFALSE;
+    tracklets[i] = 0x0;
+    if (storeTracklets) {
+      tracklets[i] = new TObjArray();
+      tracklets[i]->SetOwner(kTRUE);
+    }
+  }
+
+  // The first chamber is processed alone. It loads the calibration
+  // objects and the TRAP configuration, which the threads only read.
+  status[0] = DigitizeChamber(dets[0],signals ? signals[0] : 0x0,seeds[0]
+                             ,fMcmSim,tracklets[0]);
+
+  AliTRDmcmSim **mcmSims = new AliTRDmcmSim*[nThreads];
+  mcmSims[0] = fMcmSim;
+  for (Int_t iThread = 1; iThread < nThreads; iThread++) {
+    mcmSims[iThread] = new AliTRDmcmSim();
+    mcmSims[iThread]->Init(dets[0],0,0);
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+  for (Int_t i = 1; i < ndet; i++) {
+#ifdef _OPENMP
+    AliTRDmcmSim *mcmSim = mcmSims[omp_get_thread_num()];
+#else
+    AliTRDmcmSim *mcmSim = mcmSims[0];
+#endif
+    status[i] = DigitizeChamber(dets[i],signals ? signals[i] : 0x0,seeds[i]
+                               ,mcmSim,tracklets[i]);
+  }
+
+  for (Int_t iThread = 1; iThread < nThreads; iThread++) {
+    delete mcmSims[iThread];
+  }
+  delete [] mcmSims;
+
+  Bool_t ok = kTRUE;
+  for (Int_t i = 0; i < ndet; i++) {
+    if (!status[i]) {
+      AliError(Form("Digitization failed for detector=%d",dets[i]));
+      ok = kFALSE;
+    }
+  }
+
+  if (storeTracklets) {
+    if (!StoreTracklets(tracklets,ndet)) {
+      ok = kFALSE;
+    }
+    for (Int_t i = 0; i < ndet; i++) {
+      delete tracklets[i];
+    }
+  }
+
+  delete [] tracklets;
+  delete [] status;
+  delete [] seeds;
+
+  return ok;
+
+}
+
+//_____________________________________________________________________________
+Bool_t AliTRDdigitizer::DigitizeChamber(Int_t det, AliTRDarraySignal *signals, UInt_t seed
+                                      , AliTRDmcmSim *mcmSim, TObjArray *tracklets)
+{
+  //
+  // Converts the signals of one chamber to ADC values and runs the
+  // digital processing, see DigitizeChambers()
+  //
+
+  TRandom3 random(seed);
+
+  if (signals) {
+    if (!Signal2ADC(det,signals,&random)) {
+      return kFALSE;
+    }
+  }
+  else {
+    // Merged s-digits
+    signals = (AliTRDarraySignal *) fSDigitsManager->GetSDigits(det);
+    if (!Signal2ADC(det,signals,&random)) {
+      return kFALSE;
+    }
+    if (!CopyDictionary(det)) {
+      return kFALSE;
+    }
+  }
+
+  RunDigitalProcessing(det,mcmSim,tracklets);
+
+  CompressOutputArrays(det);
+
+  return kTRUE;
+
+}
+
+//_____________________________________________________________________________
+Bool_t AliTRDdigitizer::StoreTracklets(TObjArray **tracklets, Int_t ndet) const
+{
+  //
+  // Stores the tracklets collected per chamber by DigitizeChambers(),
+  // in the order used by AliTRDmcmSim::StoreTracklets()
+  //
+
+  AliRunLoader  *rl = AliRunLoader::Instance();
+  AliDataLoader *dl = 0x0;
+  if (rl) {
+    dl = rl->GetLoader("TRDLoader")->GetDataLoader("tracklets");
+  }
+  if (!dl) {
+    AliError("Could not get the tracklets data loader!");
+    return kFALSE;
+  }
+
+  TTree *trackletTree = dl->Tree();
+  if (!trackletTree) {
+    dl->MakeTree();
+    trackletTree = dl->Tree();
+  }
+
+  AliTRDtrackletMCM *trkl = 0x0;
+  const TString branchName = fMcmSim->GetTrklBranchName();
+  TBranch *trkbranch = trackletTree->GetBranch(branchName.Data());
+  if (!trkbranch) {
+    trkbranch = trackletTree->Branch(branchName.Data(),"AliTRDtrackletMCM",&trkl,32000);
+  }
+
+  for (Int_t i = 0; i < ndet; i++) {
+    if (!tracklets[i]) {
+      continue;
+    }
+    for (Int_t iTracklet = 0; iTracklet < tracklets[i]->GetEntriesFast(); iTracklet++) {
+      trkl = (AliTRDtrackletMCM *) tracklets[i]->UncheckedAt(iTracklet);
+      trkbranch->SetAddress(&trkl);
+      trkbranch->Fill();
+    }
+  }
+
+  return kTRUE;
+
+}
+
 //_____________________________________________________________________________
 Bool_t AliTRDdigitizer::SortHits(Float_t **hits, Int_t *nhit)
 {
@@ -1198,12 +1468,17 @@ Bool_t AliTRDdigitizer::ConvertSignals(Int_t det, AliTRDarraySignal *signals)
 }
 
 //_____________________________________________________________________________
-Bool_t AliTRDdigitizer::Signal2ADC(Int_t det, AliTRDarraySignal *signals)
+Bool_t AliTRDdigitizer::Signal2ADC(Int_t det, AliTRDarraySignal *signals, TRandom *random)
 {
   //
-  // Converts the sampled electron signals to ADC values for a given chamber
+  // Converts the sampled electron signals to ADC values for a given chamber.
+  // The noise is taken from <random>, gRandom if not given.
   //
 
+  if (!random) {
+    random = gRandom;
+  }
+
   AliDebug(1,Form("Start converting signals to ADC values for detector=%d",det));
 
   AliTRDcalibDB     *calibration = AliTRDcalibDB::Instance();
@@ -1323,7 +1598,7 @@ Bool_t AliTRDdigitizer::Signal2ADC(Int_t det, AliTRDarraySignal *signals)
 	signalAmp *= padgain;
 
         // Add the noise, starting from minus ADC baseline in electrons
-        signalAmp  = TMath::Max((Double_t) gRandom->Gaus(signalAmp,simParam->GetNoise())
+        signalAmp  = TMath::Max((Double_t) random->Gaus(signalAmp,simParam->GetNoise())
                                ,-baselineEl);
 
         // Convert to mV
@@ -1729,6 +2004,12 @@ Bool_t AliTRDdigitizer::ConvertSDigits()
     return kFALSE;
   }
 
+  // Chamber-parallel conversion
+  Bool_t parallel = (AliTRDSimParam::Instance()->GetNThreads() > 1);
+  Int_t *dets = parallel ? new Int_t[AliTRDgeometry::Ndet()] : 0x0;
+  Int_t  ndet = 0;
+  Bool_t status = kTRUE;
+
   // Loop through the detectors
   for (Int_t det = 0; det < AliTRDgeometry::Ndet(); det++) {
 
@@ -1738,6 +2019,11 @@ Bool_t AliTRDdigitizer::ConvertSDigits()
       AliDebug(2,Form("No digits for det=%d",det));
       continue;
     }
+
+    if (parallel) {
+      dets[ndet++] = det;
+      continue;
+    }
     
     // Convert the merged sdigits to digits
     if (!Signal2ADC(det,digitsIn)) {
@@ -1761,6 +2047,16 @@ Bool_t AliTRDdigitizer::ConvertSDigits()
 
   } // for: detector numbers
 
+  if (parallel) {
+    status = DigitizeChambers(ndet,dets,0x0);
+    // Delete
+    for (Int_t i = 0; i < ndet; i++) {
+      fSDigitsManager->RemoveDigits(dets[i]);
+      fSDigitsManager->RemoveDictionaries(dets[i]);
+    }
+    delete [] dets;
+  }
+
   if (AliDataLoader *trklLoader = AliRunLoader::Instance()->GetLoader("TRDLoader")->GetDataLoader("tracklets")) {
     if (trklLoader->Tree())
       trklLoader->WriteData("OVERWRITE");
@@ -1775,7 +2071,7 @@ Bool_t AliTRDdigitizer::ConvertSDigits()
   }
   fDigitsManager->GetDigitsParam()->SetADCbaselineAll(AliTRDSimParam::Instance()->GetADCbaseline());
 
-  return kTRUE;
+  return status;
 
 }
 
@@ -1961,14 +2257,20 @@ Int_t AliTRDdigitizer::Diffusion(Float_t vdrift, Double_t absdriftlength
 }
   
 //_____________________________________________________________________________
-void AliTRDdigitizer::RunDigitalProcessing(Int_t det)
+void AliTRDdigitizer::RunDigitalProcessing(Int_t det, AliTRDmcmSim *mcmSim, TObjArray *tracklets)
 {
   //
-  // Run the digital processing in the TRAP
+  // Run the digital processing in the TRAP, with <mcmSim> if given.
+  // With <tracklets> the tracklets are added to this array instead
+  // of being stored in the tracklet tree.
   //
 
   AliTRDfeeParam *feeParam = AliTRDfeeParam::Instance();
 
+  if (!mcmSim) {
+    mcmSim = fMcmSim;
+  }
+
   AliTRDarrayADC *digits = fDigitsManager->GetDigits(det);
   if (!digits)
     return;
@@ -1978,15 +2280,23 @@ void AliTRDdigitizer::RunDigitalProcessing(Int_t det)
   for (Int_t side = 0; side <= 1; side++) {
     for(Int_t rob = side; rob < digits->GetNrow() / 2; rob += 2) {
       for(Int_t mcm = 0; mcm < 16; mcm++) {
-	fMcmSim->Init(det, rob, mcm);
-	fMcmSim->SetDataByPad(digits, fDigitsManager);
-	fMcmSim->Filter();
+	mcmSim->Init(det, rob, mcm);
+	mcmSim->SetDataByPad(digits, fDigitsManager);
+	mcmSim->Filter();
 	if (feeParam->GetTracklet()) {
-	  fMcmSim->Tracklet();
-	  fMcmSim->StoreTracklets();
+	  mcmSim->Tracklet();
+	  if (tracklets) {
+	    TClonesArray *trackletArray = mcmSim->GetTrackletArray();
+	    for (Int_t iTracklet = 0; iTracklet < trackletArray->GetEntriesFast(); iTracklet++) {
+	      tracklets->Add(new AliTRDtrackletMCM(*((AliTRDtrackletMCM *) trackletArray->UncheckedAt(iTracklet))));
+	    }
+	  }
+	  else {
+	    mcmSim->StoreTracklets();
+	  }
 	}
-	fMcmSim->ZSMapping();
-	fMcmSim->WriteData(digits);
+	mcmSim->ZSMapping();
+	mcmSim->WriteData(digits);
       }
     }
   }
@@ -15,6 +15,8 @@
 
 class TFile;
 class TF1;
+class TObjArray;
+class TRandom;
 
 class AliDigitizationInput;
 class AliRunLoader;
@@ -62,7 +64,7 @@ class AliTRDdigitizer : public AliDigitizer {
           Bool_t       MergeSDigits();
           Bool_t       ConvertSDigits();
 
-          Bool_t       Signal2ADC(Int_t det, AliTRDarraySignal *signals);
+          Bool_t       Signal2ADC(Int_t det, AliTRDarraySignal *signals, TRandom *random = 0x0);
           Bool_t       Signal2SDigits(Int_t det, AliTRDarraySignal *signals);
           Bool_t       CopyDictionary(Int_t det);
 	  void         CompressOutputArrays(Int_t det);
@@ -81,10 +83,16 @@ class AliTRDdigitizer : public AliDigitizer {
 
           Int_t        Diffusion(Float_t vdrift, Double_t absdriftlength, Double_t exbvalue
                                , Double_t &lRow, Double_t &lCol, Double_t &lTime);
-	  void         RunDigitalProcessing(Int_t det = 0);
+	  void         RunDigitalProcessing(Int_t det = 0, AliTRDmcmSim *mcmSim = 0x0, TObjArray *tracklets = 0x0);
 
  protected:
 
+          Bool_t       MakeDigitsParallel(Float_t **hits, const Int_t *nhit);
+          Bool_t       DigitizeChambers(Int_t ndet, const Int_t *dets, AliTRDarraySignal **signals);
+          Bool_t       DigitizeChamber(Int_t det, AliTRDarraySignal *signals, UInt_t seed
+                                     , AliTRDmcmSim *mcmSim, TObjArray *tracklets);
+          Bool_t       StoreTracklets(TObjArray **tracklets, Int_t ndet) const;
+
   AliRunLoader        *fRunLoader;          //! Local pointer
   AliTRDdigitsManager *fDigitsManager;      //! Manager for the output digits
   AliTRDdigitsManager *fSDigitsManager;     //! Manager for the summed input s-digits